@@ -0,0 +1,58 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace {
+  std::atomic<std::size_t> allocations(0);
+  std::atomic<std::size_t> liveBytes(0);
+
+  void* countedAllocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+      liveBytes.fetch_add(malloc_usable_size(pointer), std::memory_order_relaxed);
+      return pointer;
+    }
+    throw std::bad_alloc();
+  }
+
+  void countedFree(void* pointer) {
+    if (pointer != NULL) {
+      liveBytes.fetch_sub(malloc_usable_size(pointer), std::memory_order_relaxed);
+    }
+    std::free(pointer);
+  }
+}
+
+std::size_t allocationCounter::count() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t allocationCounter::bytes() {
+  return liveBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+  return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  countedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  countedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  countedFree(pointer);
+}
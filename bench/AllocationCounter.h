@@ -0,0 +1,27 @@
+#ifndef _BENCH_ALLOCATIONCOUNTER_H_
+#define _BENCH_ALLOCATIONCOUNTER_H_
+
+#include <cstddef>
+
+/**
+ * Counts heap allocations made through the global operator new.
+ *
+ * Linking AllocationCounter.cpp into a host program replaces the global operator new and delete with versions that
+ * count every allocation, so a benchmark can check how many allocations happen while a piece of code runs and how much
+ * memory it keeps.
+ */
+namespace allocationCounter {
+  /**
+   * @brief Gets the number of allocations made since the program started
+   * @return The number of calls to operator new
+   */
+  std::size_t count();
+
+  /**
+   * @brief Gets the amount of heap memory allocated through operator new that has not been freed
+   * @return The number of usable bytes in every live allocation
+   */
+  std::size_t bytes();
+}
+
+#endif // _BENCH_ALLOCATIONCOUNTER_H_
@@ -0,0 +1,52 @@
+#ifndef _BENCH_CHECK_H_
+#define _BENCH_CHECK_H_
+
+#include <cstdio>
+
+/**
+ * The checks made by the host programs in bench/.
+ *
+ * Each check prints its name followed by "ok" or "FAILED" on a line of its own, so a program's checks line up as a
+ * table. A failed check is remembered, so once a program has made every check it can exit with status().
+ */
+namespace bench {
+  /**
+   * @brief Whether every check made so far has passed
+   */
+  inline bool passed = true;
+
+  /**
+   * @brief Checks that a condition holds
+   * @param name What the condition means
+   * @param condition Whether it holds
+   */
+  inline void check(const char* name, bool condition) {
+    std::printf("%-56s %s\n", name, condition ? "ok" : "FAILED");
+    passed &= condition;
+  }
+
+  /**
+   * @brief Checks that a count came out as expected, printing both if it did not
+   * @param name What is being counted
+   * @param actual The count
+   * @param expected What the count should be
+   */
+  inline void check(const char* name, long long actual, long long expected) {
+    if (actual == expected) {
+      std::printf("%-56s ok\n", name);
+    } else {
+      std::printf("%-56s FAILED (expected %lld, was %lld)\n", name, expected, actual);
+      passed = false;
+    }
+  }
+
+  /**
+   * @brief Gets the status the program should exit with
+   * @return 0 if every check passed, 1 otherwise
+   */
+  inline int status() {
+    return passed ? 0 : 1;
+  }
+}
+
+#endif // _BENCH_CHECK_H_
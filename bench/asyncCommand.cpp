@@ -0,0 +1,190 @@
+/**
+ * Checks that AsyncCommands keep slow work off the EventScheduler's task.
+ *
+ * A path generation that takes 60 ms of simulated time runs once in a plain Command's execute() and once as an
+ * AsyncCommand's work(), while a drive Command is meant to run every 10 ms. The program checks that the plain Command
+ * holds up an update for the whole 60 ms, while with the AsyncCommand every update stays instant and the drive Command
+ * keeps running. It then starts more AsyncCommands than there are workers and checks they all finish, with no more
+ * working at once than the pool's size. Last, it interrupts an AsyncCommand partway through and checks that its work
+ * stops early, and that running it again while the cancelled work is returning starts fresh work once the old work
+ * has returned. It exits with a non-zero status if any check fails. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/commands/AsyncCommand.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/WorkerPool.h"
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int workers = 2;
+const int chunks = 60;
+
+class BenchSubsystem : public Subsystem {
+  public:
+    void initDefaultCommand() {}
+};
+
+// Stands in for generating a path: each chunk takes 1 ms and adds to a checksum
+std::uint32_t generate(int chunks, int seed, bool (*cancelled)(void*), void* command, int* done) {
+  std::uint32_t checksum = seed;
+  for (int chunk = 0; chunk < chunks; chunk++) {
+    if (cancelled != NULL && cancelled(command)) {
+      break;
+    }
+    checksum = checksum * 31 + chunk;
+    pros::delay(1);
+    (*done)++;
+  }
+  return checksum;
+}
+
+class DriveCommand : public Command {
+  public:
+    int executions = 0;
+    DriveCommand(Subsystem* drive) {
+      addRequirement(drive);
+    }
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() { executions++; }
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// Generates the path right in execute()
+class BlockingPathCommand : public Command {
+  public:
+    int done = 0;
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() { generate(chunks, 0, NULL, NULL, &done); }
+    bool isFinished() { return true; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class PathCommand : public AsyncCommand {
+  private:
+    static bool cancelled(void* command) { return static_cast<PathCommand*>(command)->isCancelled(); }
+  public:
+    int seed;
+    int chunks;
+    int done = 0;
+    int starts = 0, polls = 0, ends = 0, cancellations = 0;
+    std::uint32_t checksum = 0;
+    PathCommand(int seed, int chunks) : seed(seed), chunks(chunks) {}
+    bool canRun() { return true; }
+    void start() { starts++; done = 0; }
+    void work() { checksum = generate(chunks, seed, cancelled, this, &done); }
+    void poll() { polls++; }
+    void cancelled() { cancellations++; }
+    void end() { ends++; }
+    void blocked() {}
+};
+
+std::uint32_t expectedChecksum(int seed, int chunks) {
+  std::uint32_t checksum = seed;
+  for (int chunk = 0; chunk < chunks; chunk++) {
+    checksum = checksum * 31 + chunk;
+  }
+  return checksum;
+}
+
+// Updates the scheduler and advances the clock to the next 10 ms period, returning how long the update took
+std::uint64_t tick() {
+  std::uint64_t start = host::micros();
+  EventScheduler::getInstance()->update();
+  std::uint64_t took = host::micros() - start;
+  if (took < 10000) {
+    host::advanceMicros(10000 - took);
+  }
+  return took;
+}
+
+}
+
+int main() {
+  WorkerPool* pool = WorkerPool::getInstance();
+  pool->setWorkerCount(workers);
+  BenchSubsystem drive;
+  DriveCommand driveCommand(&drive);
+  driveCommand.run();
+  tick();
+
+  // A plain Command holds up the update it runs in
+  BlockingPathCommand blocking;
+  blocking.run();
+  std::uint64_t blockingUpdate = tick();
+  std::printf("path generated in execute(): update took %llu us\n", (unsigned long long)blockingUpdate);
+  check("generating in execute() holds up the update", blockingUpdate >= chunks * 1000);
+
+  // An AsyncCommand leaves every update instant and the drive running
+  PathCommand path(7, chunks);
+  path.run();
+  int driveBefore = driveCommand.executions;
+  std::uint64_t longest = 0;
+  int updates = 0;
+  do {
+    std::uint64_t took = tick();
+    longest = took > longest ? took : longest;
+    updates++;
+  } while (path.ends == 0 && updates < 100);
+  std::printf("path generated in work(): finished after %d updates, longest update took %llu us\n", updates,
+              (unsigned long long)longest);
+  check("generating in work() leaves every update instant", longest == 0);
+  check("drive kept running during the work", driveCommand.executions - driveBefore == updates);
+  check("path finished once its work was done", path.ends == 1 && path.done == chunks && updates <= chunks / 10 + 2);
+  check("path's result reached end()", path.checksum == expectedChecksum(7, chunks));
+  check("poll() ran while the work did", path.polls >= chunks / 10);
+  check("pool started its workers", pool->getStartedWorkers() == size_t(workers) && host::taskCount() == size_t(workers));
+
+  // More AsyncCommands than workers wait their turn
+  std::vector<PathCommand*> paths;
+  for (int i = 0; i < 5; i++) {
+    paths.push_back(new PathCommand(i, 20 + 5 * i));
+    paths.back()->run();
+  }
+  size_t busiest = 0;
+  int finished = 0;
+  for (updates = 0; finished < 5 && updates < 100; updates++) {
+    tick();
+    busiest = pool->getBusyWorkers() > busiest ? pool->getBusyWorkers() : busiest;
+    finished = 0;
+    for (PathCommand* command : paths) {
+      finished += command->ends;
+    }
+  }
+  bool correct = true;
+  for (int i = 0; i < 5; i++) {
+    correct &= paths[i]->checksum == expectedChecksum(i, 20 + 5 * i);
+  }
+  std::printf("5 paths on %d workers finished after %d updates\n", workers, updates);
+  check("every path finished with the right result", finished == 5 && correct);
+  check("no more paths worked at once than there are workers", busiest <= size_t(workers));
+
+  // Interrupting stops the work early, and running again starts fresh work after the old work returns
+  PathCommand cancelled(3, chunks);
+  cancelled.run();
+  tick();
+  tick();
+  cancelled.stop();
+  cancelled.run();
+  for (updates = 0; cancelled.ends == 0 && updates < 100; updates++) {
+    tick();
+  }
+  check("interrupting called cancelled()", cancelled.cancellations == 1);
+  check("the rerun started and finished", cancelled.starts == 2 && cancelled.ends == 1);
+  check("the rerun did all of its work", cancelled.done == chunks && cancelled.checksum == expectedChecksum(3, chunks));
+  check("the cancelled work returned early", updates < chunks / 10 + 4);
+  check("every worker is idle", pool->getBusyWorkers() == 0);
+  return bench::status();
+}
@@ -0,0 +1,251 @@
+/**
+ * Host-side benchmark for CommandGroups running deep autonomous routines.
+ *
+ * Each routine is a long chain of sequential steps, each a drive command with a few parallel ones beside it (one of
+ * them forgotten), and every few steps a group nested several levels deep, the way a full autonomous routine is built
+ * out of smaller ones. The same routines are built twice: with CommandGroup, which keeps its steps in flat arrays, and
+ * with a copy of the old CommandGroup, which kept a vector of commands, a vector of added flags and a vector of forget
+ * flags for every step. For each layout the benchmark counts the allocations made and the memory kept to build a
+ * routine, runs every routine to completion over and over, and reports the time per tick and the time spent in the
+ * groups' execute(), which is where the steps are walked. It checks that both layouts start every command exactly once
+ * per run, that a run of the flat layout takes the expected number of ticks, and that it allocates and keeps less than
+ * the old layout, and exits with a non-zero status if not. Built and run by host.mk (make host-bench).
+ */
+#include "AllocationCounter.h"
+#include "Check.h"
+#include "libIterativeRobot/commands/CommandGroup.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int numRoutines = 8;
+const int stepsPerRoutine = 40;
+const int nestedDepth = 3;
+const int runs = 200;
+
+// The number of ticks one run of every routine takes with CommandGroup, which is the same on every run
+const int expectedTicksPerRun = 531;
+
+int initializations = 0;
+
+// The time spent in the groups' execute() calls
+double executeNs = 0;
+
+// Lets the old layout read the status of the commands in its steps, as CommandGroup can as a friend of Command
+class BenchCommand : public Command {
+  public:
+    Status getStatus() { return status; }
+};
+
+class TimedCommand : public BenchCommand {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    TimedCommand(int ticks) : ticks(ticks) {}
+    bool canRun() { return true; }
+    void initialize() { remaining = ticks; initializations++; }
+    void execute() { remaining--; }
+    bool isFinished() { return remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// A routine built with CommandGroup
+class Routine : public CommandGroup {
+  public:
+    void sequential(Command* command, bool forget = false) { addSequentialCommand(command, forget); }
+    void parallel(Command* command, bool forget = false) { addParallelCommand(command, forget); }
+    bool running() { return status == Status::Running; }
+    void execute() {
+      auto start = std::chrono::steady_clock::now();
+      CommandGroup::execute();
+      executeNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// A routine built with a copy of the old CommandGroup, whose steps were each three vectors. The EventScheduler only
+// schedules CommandGroup as a group, so this one is scheduled as a Command, which starts each step's commands a tick
+// later but walks the steps the same way
+class OldRoutine : public BenchCommand {
+  private:
+    std::vector<std::vector<BenchCommand*>> commands;
+    std::vector<std::vector<int>> added;
+    std::vector<std::vector<bool>> forget;
+    size_t sequentialIndex = 0;
+  public:
+    bool canRun() {
+      for (BenchCommand* command : commands[sequentialIndex]) {
+        if (!command->canRun()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void initialize() {
+      sequentialIndex = 0;
+      for (size_t i = 0; i < commands.size(); i++) {
+        for (size_t j = 0; j < commands[i].size(); j++) {
+          added[i][j] = 0;
+        }
+      }
+    }
+
+    void execute() {
+      auto start = std::chrono::steady_clock::now();
+      bool sequentialFinished = true;
+      for (size_t i = 0; i < commands[sequentialIndex].size(); i++) {
+        BenchCommand* command = commands[sequentialIndex][i];
+        if (!added[sequentialIndex][i]) {
+          command->run();
+          added[sequentialIndex][i] = 1;
+          sequentialFinished = false;
+        } else if (command->getStatus() != Status::Finished && !forget[sequentialIndex][i]) {
+          sequentialFinished = false;
+        }
+      }
+      if (sequentialFinished) {
+        sequentialIndex++;
+      }
+      executeNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool isFinished() { return !(sequentialIndex < commands.size()); }
+
+    // The scheduler checks canRun() before initialize(), so go back to the first step for the next run
+    void end() { sequentialIndex = 0; }
+    void interrupted() {}
+    void blocked() {}
+
+    void sequential(BenchCommand* command, bool forget = false) {
+      this->commands.push_back(std::vector<BenchCommand*>(1, command));
+      this->added.push_back(std::vector<int>(1, 0));
+      this->forget.push_back(std::vector<bool>(1, forget));
+    }
+
+    void parallel(BenchCommand* command, bool forget = false) {
+      this->commands.back().push_back(command);
+      this->added.back().push_back(0);
+      this->forget.back().push_back(forget);
+    }
+
+    bool running() { return getStatus() == Status::Running; }
+};
+
+// Builds a group with two sequential steps, each a command in parallel with a group one level down
+template <typename Group>
+Group* buildNested(int depth, int& commands) {
+  Group* group = new Group();
+  for (int step = 0; step < 2; step++) {
+    group->sequential(new TimedCommand(1 + (commands++ % 3)));
+    if (depth > 0) {
+      group->parallel(buildNested<Group>(depth - 1, commands));
+    }
+  }
+  return group;
+}
+
+template <typename Group>
+Group* buildRoutine(int& commands) {
+  Group* routine = new Group();
+  for (int step = 0; step < stepsPerRoutine; step++) {
+    routine->sequential(new TimedCommand(2 + step % 4));
+    routine->parallel(new TimedCommand(1 + step % 3));
+    routine->parallel(new TimedCommand(6), true);
+    commands += 3;
+    if (step % 5 == 4) {
+      routine->parallel(buildNested<Group>(nestedDepth, commands));
+    }
+  }
+  return routine;
+}
+
+struct Result {
+  int commands;
+  double allocations; // Per routine
+  double bytes; // Per routine
+  long firstRunTicks;
+  bool steadyRuns;
+  long startsPerRun;
+  double nsPerTick;
+  double executeNsPerRun;
+};
+
+// Builds every routine with one layout and runs them all to completion over and over
+template <typename Group>
+Result measure() {
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  Result result = {};
+
+  std::vector<Group*> routines;
+  std::size_t before = allocationCounter::count();
+  std::size_t bytesBefore = allocationCounter::bytes();
+  for (int i = 0; i < numRoutines; i++) {
+    routines.push_back(buildRoutine<Group>(result.commands));
+  }
+  result.allocations = double(allocationCounter::count() - before) / numRoutines;
+  result.bytes = double(allocationCounter::bytes() - bytesBefore) / numRoutines;
+
+  long ticks = 0;
+  result.steadyRuns = true;
+  initializations = 0;
+  executeNs = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < runs; run++) {
+    for (Group* routine : routines) {
+      routine->run();
+    }
+    long runTicks = 0;
+    bool running;
+    do {
+      scheduler->update();
+      runTicks++;
+      running = false;
+      for (Group* routine : routines) {
+        running |= routine->running();
+      }
+    } while (running);
+    if (run == 0) {
+      result.firstRunTicks = runTicks;
+    } else if (runTicks != result.firstRunTicks) {
+      result.steadyRuns = false;
+    }
+    ticks += runTicks;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  result.startsPerRun = initializations / runs;
+  result.nsPerTick = std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+  result.executeNsPerRun = executeNs / runs;
+  return result;
+}
+
+}
+
+int main() {
+  Result flat = measure<Routine>();
+  Result old = measure<OldRoutine>();
+
+  std::printf("%d routines of %d steps, %d commands each\n\n", numRoutines, stepsPerRoutine,
+              flat.commands / numRoutines);
+  std::printf("%-34s %14s %14s\n", "", "old layout", "flat layout");
+  std::printf("%-34s %14.1f %14.1f\n", "allocations to build one routine", old.allocations, flat.allocations);
+  std::printf("%-34s %14.0f %14.0f\n", "bytes kept by one routine", old.bytes, flat.bytes);
+  std::printf("%-34s %14.0f %14.0f\n", "ns/tick", old.nsPerTick, flat.nsPerTick);
+  std::printf("%-34s %14.0f %14.0f\n\n", "ns in group execute() per run", old.executeNsPerRun, flat.executeNsPerRun);
+
+  check("ticks per run", flat.firstRunTicks, expectedTicksPerRun);
+  check("every run takes as long", flat.steadyRuns);
+  check("starts per run", flat.startsPerRun, flat.commands);
+  check("starts per run with the old layout", old.startsPerRun, old.commands);
+  check("fewer allocations than the old layout", flat.allocations < old.allocations);
+  check("fewer bytes kept than the old layout", flat.bytes < old.bytes);
+  return bench::status();
+}
@@ -0,0 +1,186 @@
+/**
+ * Host-side differential check and benchmark for the CommandQueue.
+ *
+ * The reference is the sorted vector the EventScheduler used before: each Command inserted in front of the first
+ * Command with a higher priority, processed from the back, with removed Commands set to NULL and erased afterwards.
+ * Randomized workloads of adds, removes and compactions are applied to both, and the processing order is compared
+ * after every step; the program exits with a non-zero status on the first difference. It then times adding a burst of
+ * Commands in a single tick, like a large CommandGroup step fanning out. Built and run by host.mk (make host-bench).
+ */
+#include "libIterativeRobot/events/CommandQueue.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace libIterativeRobot;
+
+namespace {
+
+class QueuedCommand : public Command {
+  public:
+    void setPriority(int priority) { this->priority = priority; }
+    int getPriority() { return priority; }
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {}
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// The previous commandQueue: sorted by priority with a linear scan and a vector insert
+class SortedQueue {
+  public:
+    std::vector<QueuedCommand*> commands;
+
+    void push(QueuedCommand* command) {
+      for (size_t i = 0; i < commands.size(); i++) {
+        if (commands[i] != NULL && command->getPriority() < commands[i]->getPriority()) {
+          commands.insert(commands.begin() + i, command);
+          return;
+        }
+      }
+      commands.push_back(command);
+    }
+
+    void remove(QueuedCommand* command) {
+      for (QueuedCommand*& queued : commands) {
+        if (queued == command) {
+          queued = NULL;
+          return;
+        }
+      }
+    }
+
+    void compact() {
+      for (int i = commands.size() - 1; i >= 0; i--) {
+        if (commands[i] == NULL) {
+          commands.erase(commands.begin() + i);
+        }
+      }
+    }
+
+    void order(std::vector<Command*>& out) {
+      out.clear();
+      for (size_t i = commands.size(); i-- > 0;) {
+        if (commands[i] != NULL) {
+          out.push_back(commands[i]);
+        }
+      }
+    }
+};
+
+void order(CommandQueue& queue, std::vector<Command*>& out) {
+  out.clear();
+  for (size_t b = queue.bucketCount(); b-- > 0;) {
+    CommandQueue::Commands& bucket = queue.getBucket(b);
+    for (size_t i = bucket.size(); i-- > 0;) {
+      if (bucket[i] != NULL) {
+        out.push_back(bucket[i]);
+      }
+    }
+  }
+}
+
+bool differential(unsigned seed) {
+  std::mt19937 rng(seed);
+  const int numCommands = 64;
+  std::vector<QueuedCommand> commands(numCommands);
+  std::vector<bool> queued(numCommands, false);
+  int priorityRange = 1 + rng() % 8;
+  for (QueuedCommand& command : commands) {
+    command.setPriority(int(rng() % priorityRange) - 1);
+  }
+
+  CommandQueue queue;
+  SortedQueue reference;
+  std::vector<Command*> expected, actual;
+
+  for (int step = 0; step < 500; step++) {
+    // Add a burst of commands, as one tick's commandBuffer would
+    int adds = rng() % 6;
+    for (int a = 0; a < adds; a++) {
+      int index = rng() % numCommands;
+      if (!queued[index]) {
+        queue.push(&commands[index]);
+        reference.push(&commands[index]);
+        queued[index] = true;
+      }
+    }
+
+    // Remove some, as interruptions, finishing and stop() would
+    int removes = rng() % 4;
+    for (int r = 0; r < removes; r++) {
+      int index = rng() % numCommands;
+      if (queued[index]) {
+        queue.remove(&commands[index]);
+        reference.remove(&commands[index]);
+        queued[index] = false;
+      }
+    }
+
+    if (rng() % 2 == 0) {
+      queue.compact();
+      reference.compact();
+    }
+
+    order(queue, actual);
+    reference.order(expected);
+    if (actual != expected) {
+      std::printf("Seed %u differs from the sorted queue at step %d\n", seed, step);
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int main() {
+  const unsigned seeds = 2000;
+  for (unsigned seed = 0; seed < seeds; seed++) {
+    if (!differential(seed)) {
+      return 1;
+    }
+  }
+  std::printf("%u randomized workloads matched the sorted queue\n\n", seeds);
+
+  // Time adding a burst of commands in one tick on top of a queue that already holds some
+  const size_t burstSizes[] = {16, 64, 256, 1024};
+  const int repetitions = 200;
+  std::printf("%10s %16s %16s\n", "burst", "sorted ns/add", "bucket ns/add");
+  for (size_t burst : burstSizes) {
+    std::vector<QueuedCommand> commands(burst * 2);
+    std::mt19937 rng(burst);
+    for (QueuedCommand& command : commands) {
+      command.setPriority(1 + rng() % 4);
+    }
+
+    double sortedNs = 0, bucketNs = 0;
+    for (int r = 0; r < repetitions; r++) {
+      SortedQueue reference;
+      CommandQueue queue;
+      for (size_t i = 0; i < burst; i++) {
+        reference.push(&commands[i]);
+        queue.push(&commands[i]);
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = burst; i < burst * 2; i++) {
+        reference.push(&commands[i]);
+      }
+      auto middle = std::chrono::steady_clock::now();
+      for (size_t i = burst; i < burst * 2; i++) {
+        queue.push(&commands[i]);
+      }
+      auto end = std::chrono::steady_clock::now();
+
+      sortedNs += std::chrono::duration<double, std::nano>(middle - start).count();
+      bucketNs += std::chrono::duration<double, std::nano>(end - middle).count();
+    }
+    std::printf("%10zu %16.1f %16.1f\n", burst, sortedNs / (repetitions * burst), bucketNs / (repetitions * burst));
+  }
+  return 0;
+}
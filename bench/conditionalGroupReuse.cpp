@@ -0,0 +1,137 @@
+/**
+ * Host-side check that re-running a ConditionalGroup does not allocate.
+ *
+ * One ConditionalGroup rebuilds its body on every run and another caches a body per branch. Both switch between a short
+ * branch and a long one, and are warmed up by taking each branch once. The check then runs them over and over, and
+ * counts the allocations made, the number of times each body was built and the number of times each command ran. It
+ * also runs a group again before its last run has finished, which has to stop the last run first, and checks that
+ * destroying a group gives back the memory of its cached branches. The program exits with a non-zero status if any
+ * count is wrong. Built and run by host.mk (make host-bench).
+ */
+#include "AllocationCounter.h"
+#include "Check.h"
+#include "libIterativeRobot/commands/ConditionalGroup.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int runs = 100;
+const int ticksPerRun = 20;
+
+class CountedCommand : public Command {
+  public:
+    int starts = 0;
+    int interruptions = 0;
+    int remaining = 0;
+    bool canRun() { return true; }
+    void initialize() { remaining = 2; starts++; }
+    void execute() { remaining--; }
+    bool isFinished() { return remaining <= 0; }
+    void end() {}
+    void interrupted() { interruptions++; }
+    void blocked() {}
+};
+
+// The commands of the short branch, and the longer ones of the long branch
+struct Branches {
+  CountedCommand shortSteps[2];
+  CountedCommand longSteps[6];
+  bool takeLong = false;
+
+  int totalStarts() {
+    int starts = 0;
+    for (CountedCommand& command : shortSteps) starts += command.starts;
+    for (CountedCommand& command : longSteps) starts += command.starts;
+    return starts;
+  }
+};
+
+class RebuiltGroup : public ConditionalGroup {
+  public:
+    Branches branches;
+    int bodies = 0;
+  private:
+    void conditionalBody() {
+      bodies++;
+      if (branches.takeLong) {
+        for (int i = 0; i < 6; i += 2) {
+          addSequentialCommand(&branches.longSteps[i]);
+          addParallelCommand(&branches.longSteps[i + 1]);
+        }
+      } else {
+        addSequentialCommand(&branches.shortSteps[0]);
+        addSequentialCommand(&branches.shortSteps[1]);
+      }
+    }
+};
+
+class CachedGroup : public RebuiltGroup {
+  protected:
+    int conditionalBranch() {
+      return branches.takeLong ? 1 : 0;
+    }
+};
+
+void tick(int ticks) {
+  for (int i = 0; i < ticks; i++) {
+    EventScheduler::getInstance()->update();
+  }
+}
+
+// Runs each group once per branch, alternating, and lets every run finish
+void runBoth(RebuiltGroup& rebuilt, CachedGroup& cached, int times) {
+  for (int i = 0; i < times; i++) {
+    rebuilt.branches.takeLong = cached.branches.takeLong = i % 2 == 1;
+    rebuilt.run();
+    cached.run();
+    tick(ticksPerRun);
+  }
+}
+
+}
+
+int main() {
+  RebuiltGroup rebuilt;
+  CachedGroup cached;
+
+  // Takes each branch once, so the scheduler and both groups have grown to their largest
+  runBoth(rebuilt, cached, 2);
+
+  std::size_t before = allocationCounter::count();
+  runBoth(rebuilt, cached, runs);
+  std::size_t allocations = allocationCounter::count() - before;
+
+  // A short branch is 2 starts and a long one 6, and half of the runs take each
+  const int startsPerPair = 2 + 6;
+  const int totalRuns = runs + 2;
+
+  check("allocations while re-running", allocations, 0);
+  check("rebuilt bodies", rebuilt.bodies, totalRuns);
+  check("cached bodies", cached.bodies, 2);
+  check("rebuilt starts", rebuilt.branches.totalStarts(), totalRuns / 2 * startsPerPair);
+  check("cached starts", cached.branches.totalStarts(), totalRuns / 2 * startsPerPair);
+
+  // Running the long branch again one tick in stops its first step and starts it over
+  rebuilt.branches.takeLong = true;
+  rebuilt.run();
+  tick(1);
+  before = allocationCounter::count();
+  rebuilt.run();
+  tick(ticksPerRun);
+  check("allocations when run while running", allocationCounter::count() - before, 0);
+  check("first step interruptions", rebuilt.branches.longSteps[0].interruptions, 1);
+  check("first step starts", rebuilt.branches.longSteps[0].starts, totalRuns / 2 + 2);
+  check("last step starts", rebuilt.branches.longSteps[5].starts, totalRuns / 2 + 1);
+
+  // Destroying a group frees the groups of its cached branches
+  std::size_t bytesBefore = allocationCounter::bytes();
+  CachedGroup* destroyed = new CachedGroup();
+  runBoth(rebuilt, *destroyed, 2);
+  delete destroyed;
+  check("bytes kept after destroying a group", allocationCounter::bytes() - bytesBefore, 0);
+  return bench::status();
+}
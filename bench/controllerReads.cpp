@@ -0,0 +1,162 @@
+/**
+ * Compares controller reads per tick with and without the EventScheduler's controller snapshots.
+ *
+ * A typical driver setup is bound twice: once with triggers that read the controller directly every time they are
+ * checked, the way JoystickButton and JoystickChannel used to, and once with JoystickButton and JoystickChannel, which
+ * read from the snapshot captured at the start of each update. Several triggers share a button, like a command bound
+ * to a press and another bound to a release on separate triggers. The reads are counted by the PROS stand-in, and
+ * each setup runs in its own process because the scheduler cannot forget listeners. A read from the stand-in is only an
+ * atomic load, so the host time per tick mostly shows the cost of checking the triggers themselves; on the brain, every
+ * read is a call into the VEX runtime. The program exits with a non-zero status if the snapshot setup reads anything
+ * more than once per tick. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/JoystickButton.h"
+#include "libIterativeRobot/events/JoystickChannel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int ticks = 5000;
+
+// Each controller input used by the setup, and how many triggers are bound to it
+struct Binding {
+  pros::controller_id_e_t id;
+  int input;
+  bool analog;
+  int triggers;
+};
+
+const Binding bindings[] = {
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_L1, false, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_L2, false, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R1, false, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_R2, false, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_UP, false, 1},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_DOWN, false, 1},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_X, false, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_B, false, 1},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_A, false, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_ANALOG_LEFT_Y, true, 2},
+  {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_ANALOG_RIGHT_X, true, 2},
+  {pros::E_CONTROLLER_PARTNER, pros::E_CONTROLLER_DIGITAL_L1, false, 2},
+  {pros::E_CONTROLLER_PARTNER, pros::E_CONTROLLER_DIGITAL_R1, false, 2},
+  {pros::E_CONTROLLER_PARTNER, pros::E_CONTROLLER_ANALOG_LEFT_Y, true, 1},
+};
+
+class IdleCommand : public Command {
+  public:
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {}
+    bool isFinished() { return true; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// Reads the controller every time it is checked, like JoystickButton and JoystickChannel did before snapshots
+class DirectTrigger : public Trigger {
+  private:
+    pros::Controller* controller;
+    const Binding& binding;
+  public:
+    DirectTrigger(pros::Controller* controller, const Binding& binding) : controller(controller), binding(binding) {}
+    bool getState() {
+      if (binding.analog) {
+        return abs(controller->get_analog(pros::controller_analog_e_t(binding.input))) > JoystickChannel::kDefaultThreshold;
+      }
+      return controller->get_digital(pros::controller_digital_e_t(binding.input)) == 1;
+    }
+    using Trigger::whenActivated;
+};
+
+struct Result {
+  double readsPerTick;
+  double nsPerTick;
+  int distinctInputs;
+  int triggers;
+};
+
+Result measure(bool snapshots) {
+  pros::Controller master(pros::E_CONTROLLER_MASTER);
+  pros::Controller partner(pros::E_CONTROLLER_PARTNER);
+  IdleCommand command;
+  Result result = {0, 0, 0, 0};
+
+  for (const Binding& binding : bindings) {
+    pros::Controller* controller = binding.id == pros::E_CONTROLLER_MASTER ? &master : &partner;
+    result.distinctInputs++;
+    for (int i = 0; i < binding.triggers; i++) {
+      result.triggers++;
+      if (!snapshots) {
+        (new DirectTrigger(controller, binding))->whenActivated(&command);
+      } else if (binding.analog) {
+        (new JoystickChannel(controller, pros::controller_analog_e_t(binding.input)))->whenPassingThresholdForward(&command);
+      } else {
+        (new JoystickButton(controller, pros::controller_digital_e_t(binding.input)))->whenPressed(&command);
+      }
+    }
+  }
+
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  std::size_t before = host::controllerReads();
+  auto start = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++) {
+    scheduler->update();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  result.readsPerTick = double(host::controllerReads() - before) / ticks;
+  result.nsPerTick = std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+  return result;
+}
+
+// Runs a setup in a child process, so that it starts with an empty scheduler
+bool runIsolated(bool snapshots, Result& result) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  pid_t child = fork();
+  if (child == 0) {
+    close(fds[0]);
+    Result measured = measure(snapshots);
+    bool written = write(fds[1], &measured, sizeof(measured)) == sizeof(measured);
+    _exit(written ? 0 : 1);
+  }
+  close(fds[1]);
+  bool received = child > 0 && read(fds[0], &result, sizeof(result)) == sizeof(result);
+  close(fds[0]);
+  int status = 0;
+  if (child > 0) {
+    waitpid(child, &status, 0);
+  }
+  return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+}
+
+int main() {
+  Result direct, snapshot;
+  if (!runIsolated(false, direct) || !runIsolated(true, snapshot)) {
+    std::printf("FAILED: a setup did not finish\n");
+    return 1;
+  }
+
+  std::printf("%d triggers on %d controller inputs\n", direct.triggers, direct.distinctInputs);
+  std::printf("%-12s %12s %12s\n", "setup", "reads/tick", "ns/tick");
+  std::printf("%-12s %12.1f %12.0f\n", "direct", direct.readsPerTick, direct.nsPerTick);
+  std::printf("%-12s %12.1f %12.0f\n", "snapshot", snapshot.readsPerTick, snapshot.nsPerTick);
+
+  check("one read per input per tick with snapshots", snapshot.readsPerTick == snapshot.distinctInputs);
+  return bench::status();
+}
@@ -0,0 +1,282 @@
+/**
+ * Checks CoroutineCommands against the same autonomous routine written as a CommandGroup.
+ *
+ * The routine drives forward, waits three updates, waits for a game piece sensor, then runs a nested scoring routine
+ * that raises the arm and backs up before lowering the arm again. The program checks that each co_await resumes on the
+ * update it should, that the Commands it runs keep their requirements, so a higher priority Command can interrupt the
+ * one being awaited and the routine sees it, that interrupting the CoroutineCommand stops the Command it is waiting on
+ * and frees its frames, that a full CoroutineArena is counted rather than allocated, and that running the routine again
+ * does not allocate. It then prints the scheduler time per update for many copies of the routine as CoroutineCommands
+ * and as CommandGroups. It exits with a non-zero status if any check fails. Built as gnu++20 and run by host.mk (make
+ * host-bench).
+ */
+#include "AllocationCounter.h"
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/commands/CommandGroup.h"
+#include "libIterativeRobot/commands/CoroutineCommand.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+int tick = 0;
+
+class BenchSubsystem : public Subsystem {
+  public:
+    void initDefaultCommand() {}
+};
+
+// Runs for a number of updates, remembering when it started and stopped
+class TimedCommand : public Command {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    int started = -1, ended = -1, interruptedAt = -1;
+    TimedCommand(Subsystem* subsystem, int ticks, int priority = 1) : ticks(ticks) {
+      addRequirement(subsystem);
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() { started = tick; remaining = ticks; }
+    void execute() { remaining--; }
+    bool isFinished() { return remaining <= 0; }
+    void end() { ended = tick; }
+    void interrupted() { interruptedAt = tick; }
+    void blocked() {}
+};
+
+bool pieceLoaded = false;
+
+struct Parts {
+  TimedCommand driveForward, raiseArm, backUp, lowerArm;
+  Parts(Subsystem* drive, Subsystem* arm)
+      : driveForward(drive, 5), raiseArm(arm, 4), backUp(drive, 3), lowerArm(arm, 4) {}
+};
+
+class Autonomous : public CoroutineCommand {
+  private:
+    Parts& parts;
+
+    Routine score() {
+      co_await runAndWait(&parts.raiseArm);
+      co_await runAndWait(&parts.backUp);
+    }
+  public:
+    int afterDrive = -1, afterWait = -1, afterSensor = -1, afterScore = -1;
+    Status lowered = Status::Idle;
+    int ends = 0, cancellations = 0;
+
+    Autonomous(Parts& parts) : parts(parts) {}
+    bool canRun() { return true; }
+    void end() { ends++; }
+    void blocked() {}
+    void cancelled() { cancellations++; }
+
+    Routine routine() {
+      co_await runAndWait(&parts.driveForward);
+      afterDrive = tick;
+      co_await waitTicks(3);
+      afterWait = tick;
+      co_await waitUntil([] { return pieceLoaded; });
+      afterSensor = tick;
+      co_await score();
+      afterScore = tick;
+      lowered = co_await runAndWait(&parts.lowerArm);
+    }
+};
+
+// The same routine as a CommandGroup, with Commands standing in for the waits
+class WaitCommand : public Command {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    WaitCommand(int ticks) : ticks(ticks) {}
+    bool canRun() { return true; }
+    void initialize() { remaining = ticks; }
+    void execute() { remaining--; }
+    bool isFinished() { return remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class WaitForPiece : public Command {
+  public:
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {}
+    bool isFinished() { return pieceLoaded; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class Score : public CommandGroup {
+  public:
+    Score(Parts& parts) {
+      addSequentialCommand(&parts.raiseArm);
+      addSequentialCommand(&parts.backUp);
+    }
+};
+
+class AutonomousGroup : public CommandGroup {
+  public:
+    WaitCommand wait{3};
+    WaitForPiece waitForPiece;
+    Score score;
+    AutonomousGroup(Parts& parts) : score(parts) {
+      addSequentialCommand(&parts.driveForward);
+      addSequentialCommand(&wait);
+      addSequentialCommand(&waitForPiece);
+      addSequentialCommand(&score);
+      addSequentialCommand(&parts.lowerArm);
+    }
+};
+
+// A CoroutineCommand that waits until it is stopped
+class Forever : public CoroutineCommand {
+  public:
+    int ends = 0;
+    bool canRun() { return true; }
+    void end() { ends++; }
+    void blocked() {}
+    Routine routine() {
+      co_await waitUntil([] { return false; });
+    }
+};
+
+void update() {
+  EventScheduler::getInstance()->update();
+  tick++;
+}
+
+// Runs updates until a condition holds, giving up after a limit
+template <typename Condition>
+int runUntil(Condition condition, int limit = 200) {
+  int updates = 0;
+  while (!condition() && updates < limit) {
+    update();
+    updates++;
+  }
+  return updates;
+}
+
+}
+
+int main() {
+  BenchSubsystem drive, arm;
+  Parts parts(&drive, &arm);
+  Autonomous autonomous(parts);
+
+  // The routine resumes on the update each wait is over
+  pieceLoaded = false;
+  int start = tick;
+  autonomous.run();
+  runUntil([&] { return autonomous.afterWait >= 0; });
+  runUntil([] { return false; }, 5);
+  int loadedAt = tick;
+  pieceLoaded = true;
+  runUntil([&] { return autonomous.ends > 0; });
+  std::printf("drive %d-%d, wait over %d, sensor %d (set %d), raise %d-%d, back up %d-%d, lower %d-%d, done %d\n",
+              parts.driveForward.started - start, parts.driveForward.ended - start, autonomous.afterWait - start,
+              autonomous.afterSensor - start, loadedAt - start, parts.raiseArm.started - start,
+              parts.raiseArm.ended - start, parts.backUp.started - start, parts.backUp.ended - start,
+              parts.lowerArm.started - start, parts.lowerArm.ended - start, tick - start);
+  check("drive ran for its 5 updates", parts.driveForward.ended - parts.driveForward.started == 4);
+  check("resumed on the update the drive finished", autonomous.afterDrive == parts.driveForward.ended);
+  check("waitTicks(3) resumed 3 updates later", autonomous.afterWait - autonomous.afterDrive == 3);
+  check("waitUntil() resumed on the update the sensor read true", autonomous.afterSensor == loadedAt);
+  check("nested routine ran in order", parts.raiseArm.started == autonomous.afterSensor + 1 &&
+                                           parts.backUp.started == parts.raiseArm.ended + 1 &&
+                                           autonomous.afterScore == parts.backUp.ended);
+  check("routine finished when its last command did", autonomous.lowered == Status::Finished &&
+                                                          autonomous.ends == 1 && tick - 1 == parts.lowerArm.ended);
+  check("routine's frames were freed", CoroutineArena::getUsed() == 0);
+
+  // A second run allocates nothing, since its frames come from the arena
+  pieceLoaded = true;
+  std::size_t allocations = allocationCounter::count();
+  autonomous.run();
+  runUntil([&] { return autonomous.ends > 1; });
+  check("running again allocated nothing", allocationCounter::count() == allocations);
+
+  // A higher priority Command interrupts the awaited one, and the routine sees it
+  TimedCommand override(&arm, 1, 5);
+  autonomous.run();
+  runUntil([&] { return parts.lowerArm.started > parts.lowerArm.ended; });
+  override.run();
+  runUntil([&] { return autonomous.ends > 2; });
+  check("override interrupted the awaited arm command", parts.lowerArm.interruptedAt >= 0);
+  check("runAndWait() returned Interrupted", autonomous.lowered == Status::Interrupted);
+
+  // Interrupting the CoroutineCommand stops what it is waiting on and frees its frames
+  pieceLoaded = false;
+  parts.driveForward.interruptedAt = -1;
+  autonomous.run();
+  runUntil([] { return false; }, 2);
+  check("the routine's frame is held while it runs", CoroutineArena::getUsed() == 1);
+  autonomous.stop();
+  update();
+  check("stopping it interrupted the awaited drive command", parts.driveForward.interruptedAt >= 0);
+  check("stopping it called cancelled()", autonomous.cancellations == 1);
+  check("stopping it freed its frames", CoroutineArena::getUsed() == 0);
+
+  // A full arena is counted, and the CoroutineCommand that did not fit finishes without doing anything
+  std::vector<Forever*> waiting;
+  for (int i = 0; i < LIBITERATIVEROBOT_COROUTINE_FRAMES + 2; i++) {
+    waiting.push_back(new Forever());
+    waiting.back()->run();
+  }
+  update();
+  update();
+  int finished = 0;
+  for (Forever* command : waiting) {
+    finished += command->ends;
+  }
+  check("frames past the arena's size were counted", CoroutineArena::getFailures() == 2 && finished == 2);
+  for (Forever* command : waiting) {
+    command->stop();
+  }
+  update();
+  check("stopping them freed every frame", CoroutineArena::getUsed() == 0);
+
+  // Scheduler time for many copies of the routine, each on its own subsystems
+  const int copies = 8;
+  const int runs = 200;
+  double nsPerUpdate[2];
+  for (int version = 0; version < 2; version++) {
+    std::vector<BenchSubsystem*> subsystems;
+    std::vector<Parts*> copyParts;
+    std::vector<Command*> routines;
+    for (int i = 0; i < copies; i++) {
+      subsystems.push_back(new BenchSubsystem());
+      subsystems.push_back(new BenchSubsystem());
+      copyParts.push_back(new Parts(subsystems[2 * i], subsystems[2 * i + 1]));
+      routines.push_back(version == 0 ? static_cast<Command*>(new Autonomous(*copyParts.back()))
+                                      : static_cast<Command*>(new AutonomousGroup(*copyParts.back())));
+    }
+    long updates = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; run++) {
+      for (Command* routine : routines) {
+        routine->run();
+      }
+      for (int i = 0; i < 40; i++, updates++) {
+        update();
+      }
+    }
+    nsPerUpdate[version] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() /
+                           updates;
+  }
+  std::printf("%d routines: %.0f ns/update as CoroutineCommands, %.0f ns/update as CommandGroups\n", copies,
+              nsPerUpdate[0], nsPerUpdate[1]);
+  return bench::status();
+}
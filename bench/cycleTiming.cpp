@@ -0,0 +1,84 @@
+/**
+ * Checks the cycle timing statistics and overrun detection in RobotBase on the simulated clock.
+ *
+ * A RobotBase runs teleop for one second, and its teleopPeriodic() blocks for 3ms, 12ms or 25ms on some cycles. The
+ * blocking happens on the simulated clock, so the duration of every cycle is exact, and the statistics RobotBase
+ * collects are compared against the values worked out by hand. The program exits with a non-zero status if any of them
+ * is off. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "Robot.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+int periodicCalls = 0;
+int overrunCalls = 0;
+std::uint32_t lastOverrunMicros = 0;
+
+}
+
+class TimedRobot : public RobotBase {
+  protected:
+    void robotInit() {}
+    void autonInit() {}
+    void autonPeriodic() {}
+    void teleopInit() {}
+    void disabledInit() {}
+    void disabledPeriodic() {}
+
+    void teleopPeriodic() {
+      // Every 20th cycle misses two deadlines, every 35th misses one and every 7th is slow but finishes in time
+      periodicCalls++;
+      if (periodicCalls % 20 == 0) {
+        pros::delay(25);
+      } else if (periodicCalls % 35 == 0) {
+        pros::delay(12);
+      } else if (periodicCalls % 7 == 0) {
+        pros::delay(3);
+      }
+    }
+
+    void cycleOverrun(std::uint32_t cycleMicros) {
+      overrunCalls++;
+      lastOverrunMicros = cycleMicros;
+    }
+  public:
+    void start() {
+      runRobot();
+    }
+};
+
+// RobotBase::initializeRobot() refers to the user's Robot, which this bench does not use
+Robot* Robot::getInstance() {
+  return NULL;
+}
+
+int main() {
+  host::setCompetitionStatus(COMPETITION_CONNECTED);
+  TimedRobot robot;
+  robot.start();
+  host::advance(1000);
+
+  const CycleStatistics& statistics = robot.getCycleStatistics();
+  check("cycles", statistics.cycles, 91);
+  check("overruns", statistics.overruns, 6);
+  check("missed deadlines", statistics.missedDeadlines, 10);
+  check("total micros", statistics.totalMicros, 154000);
+  check("max micros", statistics.maxMicros, 25000);
+  check("max jitter micros", statistics.maxJitterMicros, 0);
+  check("0-0.5ms cycles", statistics.durationHistogram[0], 75);
+  check("3-3.5ms cycles", statistics.durationHistogram[6], 10);
+  check(">9.5ms cycles", statistics.durationHistogram[CycleStatistics::HistogramBuckets - 1], 6);
+  check("on-time cycles", statistics.jitterHistogram[0], 91);
+  check("overrun callbacks", overrunCalls, 6);
+  check("last overrun micros", lastOverrunMicros, 25000);
+
+  robot.resetCycleStatistics();
+  check("cycles after reset", statistics.cycles, 0);
+  return bench::status();
+}
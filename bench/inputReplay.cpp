@@ -0,0 +1,205 @@
+/**
+ * Records a scripted driver session with an InputRecorder and checks that an InputReplay of it makes the scheduler do
+ * exactly the same thing.
+ *
+ * Two controllers drive a setup of JoystickButtons and JoystickChannels bound to Commands, and a drive Command reads
+ * its sticks from the controller's snapshot on every update. Over a match-length session, the buttons are pressed and
+ * released and the sticks are moved and held on a fixed script. Each Command start and each stick reading is logged
+ * with the update it happened on. The session is then played back twice, once straight from the recorder and once
+ * after a round trip through a file, while the controllers themselves hold every button down, and both logs must match
+ * the recorded one. The program prints the size of the recording per update against that of the raw snapshots, and
+ * how many times faster than real time the replay runs. It exits with a non-zero status if any check fails. Built and
+ * run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/InputRecorder.h"
+#include "libIterativeRobot/events/InputReplay.h"
+#include "libIterativeRobot/events/JoystickButton.h"
+#include "libIterativeRobot/events/JoystickChannel.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+// A 1:45 driver control period at the default 10 ms loop period
+const int ticks = 10500;
+const int periodMillis = 10;
+const int numButtons = pros::E_CONTROLLER_DIGITAL_A - pros::E_CONTROLLER_DIGITAL_L1 + 1;
+
+struct Entry {
+  int tick;
+  int id;
+  std::int32_t value;
+
+  bool operator==(const Entry& other) const {
+    return tick == other.tick && id == other.id && value == other.value;
+  }
+};
+
+std::vector<Entry> log;
+int tick = 0;
+
+class BenchSubsystem : public Subsystem {
+  public:
+    void initDefaultCommand() {}
+};
+
+// Logs when it starts, then finishes after a few updates
+class LoggingCommand : public Command {
+  private:
+    int id;
+    int remaining = 0;
+  public:
+    LoggingCommand(int id) : id(id) {}
+    bool canRun() { return true; }
+    void initialize() { log.push_back({tick, id, 0}); remaining = 3; }
+    void execute() { remaining--; }
+    bool isFinished() { return remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// Logs the sticks of a controller on every update, the way a tank drive would read them
+class DriveCommand : public Command {
+  private:
+    ControllerSnapshot* snapshot;
+  public:
+    DriveCommand(Subsystem* drive, ControllerSnapshot* snapshot) : snapshot(snapshot) {
+      addRequirement(drive);
+    }
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {
+      log.push_back({tick, -1, snapshot->getAnalog(pros::E_CONTROLLER_ANALOG_LEFT_Y) * 256 +
+                               snapshot->getAnalog(pros::E_CONTROLLER_ANALOG_RIGHT_Y)});
+    }
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// Whether a button is pressed on a tick of the script
+bool pressed(int controller, int button, int tick) {
+  return (tick / (7 + 5 * button + 11 * controller)) % 4 == 1;
+}
+
+// The value of a stick on a tick of the script, which moves for a while and then holds still
+std::int32_t stick(int controller, int channel, int tick) {
+  int phase = tick / 100 + channel + controller;
+  if (phase % 3 != 0) {
+    return phase % 2 == 0 ? 127 : 0;
+  }
+  return std::int32_t(std::lround(127 * std::sin(tick * (0.01 + 0.003 * channel))));
+}
+
+void setInputs(int tick) {
+  pros::controller_id_e_t ids[] = {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_PARTNER};
+  for (int controller = 0; controller < 2; controller++) {
+    for (int button = 0; button < numButtons; button++) {
+      host::setDigital(ids[controller], pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button),
+                       tick >= 0 && pressed(controller, button, tick));
+    }
+    for (int channel = 0; channel < ControllerSnapshot::kAnalogChannels; channel++) {
+      host::setAnalog(ids[controller], pros::controller_analog_e_t(channel), tick >= 0 ? stick(controller, channel, tick) : 0);
+    }
+  }
+}
+
+// Runs a session, taking input from the controllers if there is no replay, and returns its log
+std::vector<Entry> run(InputRecorder* recorder, InputReplay* replay) {
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  scheduler->setInputRecorder(recorder);
+  scheduler->setInputReplay(replay);
+  log.clear();
+  for (tick = 0; tick < ticks; tick++) {
+    if (replay == NULL) {
+      setInputs(tick);
+    }
+    scheduler->update();
+  }
+  std::vector<Entry> session = log;
+
+  // Lets every Command finish with the inputs released, so the next session starts where this one did
+  scheduler->setInputRecorder(NULL);
+  scheduler->setInputReplay(NULL);
+  setInputs(-1);
+  for (int settle = 0; settle < 10; settle++) {
+    scheduler->update();
+  }
+  return session;
+}
+
+}
+
+int main() {
+  pros::Controller master(pros::E_CONTROLLER_MASTER), partner(pros::E_CONTROLLER_PARTNER);
+  pros::Controller* controllers[] = {&master, &partner};
+  BenchSubsystem drive;
+  int id = 0;
+  for (pros::Controller* controller : controllers) {
+    for (int button = 0; button < numButtons; button++) {
+      JoystickButton* trigger = new JoystickButton(controller, pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button));
+      trigger->whenPressed(new LoggingCommand(id++));
+      trigger->whenReleased(new LoggingCommand(id++));
+    }
+    for (int channel = 0; channel < ControllerSnapshot::kAnalogChannels; channel++) {
+      JoystickChannel* trigger = new JoystickChannel(controller, pros::controller_analog_e_t(channel));
+      trigger->whenPassingThresholdForward(new LoggingCommand(id++));
+      trigger->whenPassingThresholdReverse(new LoggingCommand(id++));
+    }
+  }
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  DriveCommand driveCommand(&drive, scheduler->getControllerSnapshot(&master));
+  driveCommand.run();
+
+  InputRecorder recorder(4096);
+  std::vector<Entry> recorded = run(&recorder, NULL);
+
+  // Held buttons on the real controllers show that the replay does not read them
+  InputReplay replay(recorder);
+  for (int controller = 0; controller < 2; controller++) {
+    for (int button = 0; button < numButtons; button++) {
+      host::setDigital(controller == 0 ? pros::E_CONTROLLER_MASTER : pros::E_CONTROLLER_PARTNER,
+                       pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button), true);
+    }
+  }
+  auto start = std::chrono::steady_clock::now();
+  std::vector<Entry> replayed = run(NULL, &replay);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  FILE* file = std::tmpfile();
+  InputReplay loaded;
+  bool saved = false, read = false;
+  if (file != NULL) {
+    saved = recorder.save(file);
+    std::rewind(file);
+    read = loaded.load(file);
+    std::fclose(file);
+  }
+  std::vector<Entry> reloaded = run(NULL, &loaded);
+
+  size_t bytes = recorder.getData().size();
+  size_t rawBytes = size_t(ticks) * recorder.getSnapshotCount() * (sizeof(std::uint16_t) + ControllerSnapshot::kAnalogChannels);
+  std::printf("%zu log entries over %d updates\n", recorded.size(), ticks);
+  std::printf("recording: %zu bytes, %.2f bytes/update (raw snapshots %.1f bytes/update, %.1fx smaller)\n", bytes,
+              double(bytes) / ticks, double(rawBytes) / ticks, double(rawBytes) / bytes);
+  std::printf("replay: %.0f updates/s, %.0fx real time\n", ticks / seconds, ticks * periodMillis / 1000.0 / seconds);
+
+  check("recording covers every update", recorder.getTicks() == std::uint32_t(ticks));
+  check("recording has both controllers", recorder.getSnapshotCount() == 2);
+  check("session started commands and read sticks", recorded.size() > size_t(ticks));
+  check("replay played every update", replay.isFinished() && replay.getTick() == std::uint32_t(ticks));
+  check("replay matches the recorded session", replayed == recorded);
+  check("recording saved and loaded", saved && read && loaded.getTicks() == std::uint32_t(ticks));
+  check("loaded replay matches the recorded session", reloaded == recorded);
+  return bench::status();
+}
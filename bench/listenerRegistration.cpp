@@ -0,0 +1,100 @@
+/**
+ * Checks that EventListeners are registered exactly once and can be unregistered safely.
+ *
+ * JoystickChannels used to register themselves a second time on top of the registration done by EventListener, so
+ * every channel was checked twice per update, running its while commands twice. This program binds
+ * commands to JoystickChannels and JoystickButtons, moves the inputs, and uses the EventScheduler's listener
+ * diagnostics to check that each listener is checked once per update. Each trigger also has a while binding, so that
+ * it is checked on every update rather than only when its input changes. It then unregisters listeners directly, from
+ * inside another listener's checkConditions(), and by destroying them. The program exits with a non-zero status if any
+ * check fails. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/JoystickButton.h"
+#include "libIterativeRobot/events/JoystickChannel.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+class CountingCommand : public Command {
+  public:
+    int initializations = 0;
+    bool canRun() { return true; }
+    void initialize() { initializations++; }
+    void execute() {}
+    bool isFinished() { return true; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// Unregisters another listener the first time it is checked
+class RemovingListener : public EventListener {
+  public:
+    EventListener* target = NULL;
+    void checkConditions() {
+      if (target != NULL) {
+        EventScheduler::getInstance()->removeEventListener(target);
+        target = NULL;
+      }
+    }
+};
+
+}
+
+int main() {
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  pros::Controller master(pros::E_CONTROLLER_MASTER);
+
+  CountingCommand forward, pressed, held;
+  JoystickChannel channel(&master, pros::E_CONTROLLER_ANALOG_LEFT_Y);
+  channel.whenPassingThresholdForward(&forward);
+  channel.whilePastThreshold(&held);
+  JoystickButton button(&master, pros::E_CONTROLLER_DIGITAL_A);
+  button.whenPressed(&pressed);
+  button.whileHeld(&held);
+
+  // Registering again, as JoystickChannel's constructor used to, changes nothing
+  scheduler->addEventListener(&channel);
+  check("listeners", scheduler->getListenerCount(), 2);
+
+  for (int tick = 0; tick < 30; tick++) {
+    host::setAnalog(pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_ANALOG_LEFT_Y, (tick / 5) % 2 == 0 ? 0 : 100);
+    host::setDigital(pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_A, (tick / 5) % 2 == 1);
+    scheduler->update();
+  }
+  check("checks in the last update", scheduler->getListenerChecks(), 2);
+  check("channel edges handled", forward.initializations, 3);
+  check("button edges handled", pressed.initializations, 3);
+
+  scheduler->removeEventListener(&channel);
+  scheduler->removeEventListener(&channel);
+  scheduler->update();
+  check("listeners after removing channel", scheduler->getListenerCount(), 1);
+  check("checks after removing channel", scheduler->getListenerChecks(), 1);
+  check("channel registered", channel.isRegistered(), 0);
+
+  scheduler->addEventListener(&channel);
+  scheduler->update();
+  check("checks after adding channel back", scheduler->getListenerChecks(), 2);
+
+  // A listener that removes one checked after it in the same update
+  {
+    RemovingListener remover;
+    scheduler->removeEventListener(&button);
+    scheduler->addEventListener(&button);
+    remover.target = &button;
+    scheduler->update();
+    check("checks while removing button", scheduler->getListenerChecks(), 2);
+    check("listeners after removing button", scheduler->getListenerCount(), 2);
+  }
+  scheduler->update();
+  check("listeners after destroying remover", scheduler->getListenerCount(), 1);
+  check("checks after destroying remover", scheduler->getListenerChecks(), 1);
+  return bench::status();
+}
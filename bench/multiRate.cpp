@@ -0,0 +1,86 @@
+/**
+ * Checks the configurable loop period and the periodic functions in RobotBase on the simulated clock.
+ *
+ * A RobotBase sets a 5ms base period with the robot states running every other period, then adds a control loop that
+ * runs every period, telemetry every 50ms on its own phase and a screen update every 100ms. After one second of teleop
+ * the number of calls to each, and the times they ran at, are compared with the values worked out by hand. The program
+ * exits with a non-zero status if any of them is off. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "Robot.h"
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+int teleopPeriodicCalls = 0;
+int controlCalls = 0;
+int screenCalls = 0;
+std::vector<std::uint32_t> telemetryTimes;
+
+void control(void* parameter) {
+  controlCalls++;
+}
+
+void telemetry(void* parameter) {
+  telemetryTimes.push_back(pros::millis());
+}
+
+void screen(void* parameter) {
+  screenCalls++;
+}
+
+class MultiRateRobot : public RobotBase {
+  protected:
+    void robotInit() {
+      setPeriod(5);
+      setCycleMultiple(2);
+      addPeriodic(control, NULL, 1);
+      addPeriodic(telemetry, NULL, 10, 3);
+      addPeriodic(screen, NULL, 20);
+    }
+    void autonInit() {}
+    void autonPeriodic() {}
+    void teleopInit() {}
+    void teleopPeriodic() { teleopPeriodicCalls++; }
+    void disabledInit() {}
+    void disabledPeriodic() {}
+  public:
+    void start() {
+      runRobot();
+    }
+};
+
+}
+
+// RobotBase::initializeRobot() refers to the user's Robot, which this bench does not use
+Robot* Robot::getInstance() {
+  return NULL;
+}
+
+int main() {
+  host::setCompetitionStatus(COMPETITION_CONNECTED);
+  MultiRateRobot robot;
+  robot.start();
+  host::advance(1000);
+
+  // Cycles run at t = 0, 5, 10 ... 1000, and the robot states on every other one, the first of which calls teleopInit
+  check("cycles", robot.getCycleStatistics().cycles, 201);
+  check("teleopPeriodic calls", teleopPeriodicCalls, 100);
+  check("control calls", controlCalls, 201);
+  check("screen calls", screenCalls, 11);
+  check("telemetry calls", telemetryTimes.size(), 20);
+  bool onTime = true;
+  for (size_t i = 0; i < telemetryTimes.size(); i++) {
+    if (telemetryTimes[i] != 15 + 50 * i) {
+      std::printf("telemetry call %zu ran at %ums instead of %zums\n", i, telemetryTimes[i], 15 + 50 * i);
+      onTime = false;
+    }
+  }
+  check("telemetry calls on time", onTime);
+  return bench::status();
+}
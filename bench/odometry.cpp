@@ -0,0 +1,318 @@
+/**
+ * Checks Odometry against a simulated drivetrain.
+ *
+ * The drivetrain's wheels speed up and slow down at a limited rate, like real ones, and its tracking wheels report
+ * whole encoder ticks. A CommandGroup drives it around a square, using the Pose from Odometry to decide when each side
+ * and each turn is done, while the Odometry's task updates every 5 ms and the EventScheduler every 10 ms. The program
+ * checks that the Odometry's task ran at its rate, that every Pose a Command read was from the last odometry update,
+ * and that the tracked Pose ends up where the simulated robot really is. It checks that setPose() moves the Pose on the
+ * next update, to the last Pose set if it was called twice. It then has two host threads publish and read a Pose
+ * through a Seqlock as fast as they can, and checks that the reader never sees one that is partly written. Finally it
+ * drives the same winding path with Odometry updating every 5 ms and every 20 ms and prints how far off each ends up.
+ * It exits with a non-zero status if any check fails. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/commands/CommandGroup.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/subsystems/Odometry.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const double track = 12; // Between the left and right wheels, in inches
+const double tickDistance = 2.75 * M_PI / 360; // A 2.75" tracking wheel on a 360 tick encoder
+const double acceleration = 150; // Inches per second per second
+const int updateMillis = 10;
+
+// A drivetrain whose wheels move toward the speeds they are set to, tracked in steps of 100 microseconds
+class SimDrivetrain {
+  private:
+    double leftTarget = 0, rightTarget = 0;
+    double leftSpeed = 0, rightSpeed = 0;
+    std::uint64_t time;
+  public:
+    double left = 0, right = 0;
+    Pose pose;
+
+    SimDrivetrain() : time(host::micros()) {}
+
+    void advanceTo(std::uint64_t now) {
+      const double step = 1e-4;
+      for (; time < now; time += 100) {
+        double change = acceleration * step;
+        leftSpeed += std::max(-change, std::min(change, leftTarget - leftSpeed));
+        rightSpeed += std::max(-change, std::min(change, rightTarget - rightSpeed));
+        double turn = (rightSpeed - leftSpeed) * step / track;
+        double heading = pose.theta + turn / 2;
+        pose.x += (leftSpeed + rightSpeed) / 2 * step * std::cos(heading);
+        pose.y += (leftSpeed + rightSpeed) / 2 * step * std::sin(heading);
+        pose.theta += turn;
+        left += leftSpeed * step;
+        right += rightSpeed * step;
+      }
+    }
+
+    void setSpeeds(double left, double right) {
+      advanceTo(host::micros());
+      leftTarget = left;
+      rightTarget = right;
+    }
+
+    bool stopped() {
+      return leftSpeed == 0 && rightSpeed == 0;
+    }
+};
+
+class SimOdometry : public Odometry {
+  private:
+    SimDrivetrain* drivetrain;
+
+    static double ticks(double distance) {
+      return std::floor(distance / tickDistance) * tickDistance;
+    }
+  public:
+    SimOdometry(SimDrivetrain* drivetrain) : Odometry(track), drivetrain(drivetrain) {}
+    OdometryReading read() {
+      drivetrain->advanceTo(host::micros());
+      OdometryReading reading;
+      reading.left = ticks(drivetrain->left);
+      reading.right = ticks(drivetrain->right);
+      return reading;
+    }
+};
+
+class Drive : public Subsystem {
+  public:
+    SimDrivetrain* drivetrain = NULL;
+    void initDefaultCommand() {}
+};
+
+// Whether every Pose a Command read was from the last odometry update
+bool fresh = true;
+
+Pose readPose(Odometry* odometry) {
+  Pose pose = odometry->getPose();
+  fresh &= pros::millis() - pose.time <= LIBITERATIVEROBOT_ODOMETRY_RATE;
+  return pose;
+}
+
+class DriveDistance : public Command {
+  private:
+    Drive* drive;
+    Odometry* odometry;
+    double distance;
+    Pose start;
+
+    double remaining() {
+      Pose pose = readPose(odometry);
+      return distance - std::hypot(pose.x - start.x, pose.y - start.y);
+    }
+  public:
+    DriveDistance(Drive* drive, Odometry* odometry, double distance)
+        : drive(drive), odometry(odometry), distance(distance) {
+      addRequirement(drive);
+    }
+    bool canRun() { return true; }
+    void initialize() { start = readPose(odometry); }
+    void execute() {
+      double speed = std::min(40.0, 4 * remaining());
+      drive->drivetrain->setSpeeds(speed, speed);
+    }
+    bool isFinished() { return remaining() < 0.25; }
+    void end() { drive->drivetrain->setSpeeds(0, 0); }
+    void interrupted() { end(); }
+    void blocked() {}
+};
+
+class Turn : public Command {
+  private:
+    Drive* drive;
+    Odometry* odometry;
+    double angle;
+    double start = 0;
+
+    double remaining() {
+      return angle - (readPose(odometry).theta - start);
+    }
+  public:
+    Turn(Drive* drive, Odometry* odometry, double angle) : drive(drive), odometry(odometry), angle(angle) {
+      addRequirement(drive);
+    }
+    bool canRun() { return true; }
+    void initialize() { start = readPose(odometry).theta; }
+    void execute() {
+      double speed = std::min(20.0, 30 * remaining());
+      drive->drivetrain->setSpeeds(-speed, speed);
+    }
+    bool isFinished() { return remaining() < 0.005; }
+    void end() { drive->drivetrain->setSpeeds(0, 0); }
+    void interrupted() { end(); }
+    void blocked() {}
+};
+
+class Square : public CommandGroup {
+  public:
+    bool finished = false;
+    DriveDistance side;
+    Turn corner;
+    Square(Drive* drive, Odometry* odometry) : side(drive, odometry, 36), corner(drive, odometry, M_PI / 2) {
+      for (int i = 0; i < 4; i++) {
+        addSequentialCommand(&side);
+        addSequentialCommand(&corner);
+      }
+    }
+    void end() {
+      CommandGroup::end();
+      finished = true;
+    }
+};
+
+// Winds left and right at speeds that depend only on the time, so every run follows the same path
+class Slalom : public Command {
+  private:
+    Drive* drive;
+    int updates = 0;
+  public:
+    bool finished = false;
+    Slalom(Drive* drive) : drive(drive) {
+      addRequirement(drive);
+    }
+    bool canRun() { return true; }
+    void initialize() { updates = 0; }
+    void execute() {
+      double swing = 25 * std::sin(updates++ * 0.05);
+      drive->drivetrain->setSpeeds(35 - swing, 35 + swing);
+    }
+    bool isFinished() { return updates >= 500; }
+    void end() {
+      drive->drivetrain->setSpeeds(0, 0);
+      finished = true;
+    }
+    void interrupted() { end(); }
+    void blocked() {}
+};
+
+void update() {
+  EventScheduler::getInstance()->update();
+  host::advance(updateMillis);
+}
+
+// Runs updates until the drivetrain comes to a stop after a Command finishes
+void settle(bool& finished, SimDrivetrain& drivetrain) {
+  while (!finished || !drivetrain.stopped()) {
+    update();
+  }
+  update();
+}
+
+double positionError(Odometry& odometry, SimDrivetrain& drivetrain) {
+  Pose tracked = odometry.getPose();
+  return std::hypot(tracked.x - drivetrain.pose.x, tracked.y - drivetrain.pose.y);
+}
+
+double headingError(Odometry& odometry, SimDrivetrain& drivetrain) {
+  return std::fabs(odometry.getPose().theta - drivetrain.pose.theta) * 180 / M_PI;
+}
+
+}
+
+int main() {
+  Drive drive;
+  EventScheduler::getInstance()->initialize();
+
+  // Drives a square, turning and stopping on the tracked Pose
+  SimDrivetrain drivetrain;
+  drive.drivetrain = &drivetrain;
+  SimOdometry odometry(&drivetrain);
+  odometry.start();
+  std::uint32_t start = pros::millis();
+  Square square(&drive, &odometry);
+  square.run();
+  settle(square.finished, drivetrain);
+  std::uint32_t elapsed = pros::millis() - start;
+  std::uint32_t updates = odometry.getUpdates();
+  std::printf("square: %u ms, %u odometry updates, ended %.3f in and %.3f deg from the true pose\n", elapsed, updates,
+              positionError(odometry, drivetrain), headingError(odometry, drivetrain));
+  check("odometry updated every 5 ms", updates >= elapsed / LIBITERATIVEROBOT_ODOMETRY_RATE &&
+                                           updates <= elapsed / LIBITERATIVEROBOT_ODOMETRY_RATE + 1);
+  check("every pose a command read was from the last update", fresh);
+  check("the robot went around the square", std::fabs(drivetrain.pose.theta - 2 * M_PI) < 0.1 &&
+                                                std::hypot(drivetrain.pose.x, drivetrain.pose.y) < 3);
+  check("tracked position is within 0.5 in of the truth", positionError(odometry, drivetrain) < 0.5);
+  check("tracked heading is within 1 deg of the truth", headingError(odometry, drivetrain) < 1);
+
+  // setPose() takes effect on the next odometry update
+  Pose corner;
+  corner.x = 24;
+  corner.y = -12;
+  odometry.setPose(corner);
+  update();
+  Pose moved = odometry.getPose();
+  check("setPose() moved the tracked pose", moved.x == 24 && moved.y == -12 && moved.theta == 0);
+  Pose first, second;
+  first.x = 1;
+  second.x = 2;
+  second.theta = 1;
+  odometry.setPose(first);
+  odometry.setPose(second);
+  update();
+  moved = odometry.getPose();
+  check("the last of two setPose() calls won", moved.x == 2 && moved.y == 0 && moved.theta == 1);
+  odometry.stop();
+  update();
+
+  // Two host threads race on a Seqlock, the writer publishing poses whose fields all match
+  const std::uint32_t stores = 2000000;
+  Seqlock<Pose> shared;
+  std::atomic<bool> writing(true);
+  std::thread writer([&] {
+    for (std::uint32_t i = 1; i <= stores; i++) {
+      Pose pose;
+      pose.x = pose.y = pose.theta = i;
+      pose.time = i;
+      shared.store(pose);
+    }
+    writing = false;
+  });
+  std::uint32_t reads = 0, torn = 0, backwards = 0;
+  std::uint32_t latest = 0;
+  while (writing || reads == 0) {
+    Pose pose = shared.load();
+    torn += pose.x != pose.y || pose.y != pose.theta || pose.theta != pose.time;
+    backwards += pose.time < latest;
+    latest = pose.time;
+    reads++;
+  }
+  writer.join();
+  std::printf("seqlock: %u stores, %u reads, %u retries\n", stores, reads, shared.getRetries());
+  check("no read saw a partly written pose", torn == 0);
+  check("reads never went back in time", backwards == 0 && shared.load().time == stores);
+
+  // The same winding path tracked every 5 ms and every 20 ms
+  double errors[2];
+  std::uint32_t rates[] = {5, 20};
+  for (int i = 0; i < 2; i++) {
+    SimDrivetrain path;
+    drive.drivetrain = &path;
+    SimOdometry* tracker = new SimOdometry(&path); // Left running on the host until the program exits
+    tracker->setRate(rates[i]);
+    tracker->start();
+    host::advance(updateMillis);
+    Slalom slalom(&drive);
+    slalom.run();
+    settle(slalom.finished, path);
+    tracker->stop();
+    errors[i] = positionError(*tracker, path);
+  }
+  std::printf("slalom: %.3f in off tracking every 5 ms, %.3f in off every 20 ms\n", errors[0], errors[1]);
+  check("tracking every 5 ms was at least as accurate", errors[0] <= errors[1]);
+  return bench::status();
+}
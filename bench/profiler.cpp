@@ -0,0 +1,110 @@
+/**
+ * Checks the per-command profiling done by the EventScheduler when LIBITERATIVEROBOT_PROFILE is defined.
+ *
+ * Runs a slow Command next to a fast one, a short CommandGroup and a Trigger for a fixed number of ticks, checks that
+ * the Profiler counted every call, including interrupted() and blocked(), and timed the slow Command's execute()
+ * exactly, and that a destroyed Command is taken off its list. Then it prints the Profiler's table. The slow Command
+ * advances the simulated clock instead of spinning, so the timings are exact. The program exits with a non-zero
+ * status if any check fails. Built with PROFILE=1 and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Profiler.h"
+#include "libIterativeRobot/events/Trigger.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+class BusyCommand : public Command {
+  private:
+    std::uint64_t busyMicros;
+    int ticks;
+    int remaining = 0;
+  public:
+    BusyCommand(std::uint64_t busyMicros, int ticks) : busyMicros(busyMicros), ticks(ticks) {}
+    bool canRun() { return true; }
+    void initialize() { remaining = ticks; }
+    void execute() {
+      // Stands in for an expensive execute(), like a blocking sensor read
+      host::advanceMicros(busyMicros);
+      remaining--;
+    }
+    bool isFinished() { return ticks >= 0 && remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class StepGroup : public CommandGroup {
+  public:
+    StepGroup(Command* first, Command* second) {
+      addSequentialCommand(first);
+      addSequentialCommand(second);
+    }
+};
+
+class HeldTrigger : public Trigger {
+  public:
+    bool getState() { return true; }
+    using Trigger::whileActive;
+};
+
+}
+
+int main() {
+  const int ticks = 100;
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  Profiler* profiler = Profiler::getInstance();
+
+  BusyCommand slow(500, -1);
+  BusyCommand fast(0, -1);
+  BusyCommand first(0, 3);
+  BusyCommand second(0, 3);
+  StepGroup group(&first, &second);
+  HeldTrigger trigger;
+  trigger.whileActive(&fast);
+
+  slow.run();
+  group.run();
+  for (int tick = 0; tick < ticks; tick++) {
+    scheduler->update();
+  }
+
+  CommandProfile& slowProfile = profiler->of(&slow);
+  CommandProfile& fastProfile = profiler->of(&fast);
+  check("slow execute calls", slowProfile.execute.calls, ticks);
+  check("slow initialize calls", slowProfile.initialize.calls, 1);
+  check("slow isFinished calls", slowProfile.isFinished.calls, ticks);
+  check("slow end calls", slowProfile.end.calls, 0);
+  check("group end calls", profiler->of(&group).end.calls, 1);
+  check("first step end calls", profiler->of(&first).end.calls, 1);
+  check("second step execute calls", profiler->of(&second).execute.calls, 3);
+  check("listener calls", profiler->of(&trigger).checkConditions.calls, ticks);
+  check("slow execute total", slowProfile.execute.totalMicros, 500 * ticks);
+  check("slow execute max", slowProfile.execute.maxMicros, 500);
+  check("fast execute total", fastProfile.execute.totalMicros, 0);
+  check("profiled commands", profiler->getCommands().size(), 5);
+
+  // stop() interrupts a running Command, and running a Command that is already queued blocks it
+  slow.stop();
+  second.run();
+  second.run();
+  check("slow interrupted calls", slowProfile.interrupted.calls, 1);
+  check("second step blocked calls", profiler->of(&second).blocked.calls, 1);
+
+  // A destroyed Command is taken off the Profiler's list
+  BusyCommand* temporary = new BusyCommand(0, 1);
+  profiler->of(temporary);
+  delete temporary;
+  check("profiled commands after one is destroyed", profiler->getCommands().size(), 5);
+
+  profiler->dump();
+
+  profiler->reset();
+  check("execute calls after reset", slowProfile.execute.calls, 0);
+  return bench::status();
+}
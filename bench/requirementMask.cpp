@@ -0,0 +1,114 @@
+/**
+ * Host-side microbenchmark for the requirement conflict check done by EventScheduler::update().
+ *
+ * Compares the old path (a std::vector of claimed Subsystems searched with std::find for every requirement of every
+ * queued command) with the new path (one SubsystemMask AND per command), across a range of command and subsystem
+ * counts. Built and run by host.mk (make host-bench).
+ */
+#include "libIterativeRobot/subsystems/SubsystemMask.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using libIterativeRobot::SubsystemMask;
+
+namespace {
+
+struct FakeCommand {
+  std::vector<const void*> requirements;
+  SubsystemMask requirementMask;
+};
+
+// One tick of the old scheduling loop's requirement check. Returns the number of commands that could run
+size_t oldTick(std::vector<FakeCommand>& queue, size_t numSubsystems) {
+  std::vector<const void*> usedSubsystems; // Allocated every tick, as it was in EventScheduler::update()
+  size_t ran = 0;
+  for (int i = queue.size() - 1; i >= 0; i--) {
+    std::vector<const void*>& commandRequirements = queue[i].requirements;
+    bool canRun = true;
+    if (usedSubsystems.size() == numSubsystems && commandRequirements.size() != 0) {
+      canRun = false;
+    } else {
+      for (const void* aSubsystem : commandRequirements) {
+        if (std::find(usedSubsystems.begin(), usedSubsystems.end(), aSubsystem) != usedSubsystems.end()) {
+          canRun = false;
+          break;
+        }
+      }
+    }
+    if (canRun) {
+      usedSubsystems.insert(usedSubsystems.end(), commandRequirements.begin(), commandRequirements.end());
+      ran++;
+    }
+  }
+  return ran;
+}
+
+// One tick of the new scheduling loop's requirement check
+size_t newTick(std::vector<FakeCommand>& queue, SubsystemMask& usedSubsystems) {
+  usedSubsystems.clear();
+  size_t ran = 0;
+  for (int i = queue.size() - 1; i >= 0; i--) {
+    SubsystemMask& commandRequirements = queue[i].requirementMask;
+    if (!commandRequirements.intersects(usedSubsystems)) {
+      usedSubsystems.merge(commandRequirements);
+      ran++;
+    }
+  }
+  return ran;
+}
+
+template <typename F>
+double nsPerTick(size_t ticks, F&& tick) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < ticks; i++) {
+    tick();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+}
+
+}
+
+int main() {
+  const size_t commandCounts[] = {8, 32, 128, 512};
+  const size_t subsystemCounts[] = {4, 16, 64, 128};
+  const size_t ticks = 20000;
+  std::vector<char> subsystems(128); // Addresses stand in for Subsystem pointers on the old path
+
+  std::printf("%10s %10s %14s %14s %9s\n", "commands", "subsystems", "old ns/tick", "new ns/tick", "speedup");
+  for (size_t numSubsystems : subsystemCounts) {
+    for (size_t numCommands : commandCounts) {
+      std::mt19937 rng(numCommands * 1000 + numSubsystems);
+      std::uniform_int_distribution<size_t> subsystemDist(0, numSubsystems - 1);
+      std::uniform_int_distribution<size_t> requirementCountDist(1, 3);
+
+      std::vector<FakeCommand> queue(numCommands);
+      for (FakeCommand& command : queue) {
+        size_t requirementCount = requirementCountDist(rng);
+        for (size_t r = 0; r < requirementCount; r++) {
+          size_t index = subsystemDist(rng);
+          const void* subsystem = &subsystems[index];
+          if (std::find(command.requirements.begin(), command.requirements.end(), subsystem) == command.requirements.end()) {
+            command.requirements.push_back(subsystem);
+            command.requirementMask.set(index);
+          }
+        }
+      }
+
+      SubsystemMask usedSubsystems;
+      size_t oldRan = 0, newRan = 0;
+      double oldNs = nsPerTick(ticks, [&] { oldRan = oldTick(queue, numSubsystems); });
+      double newNs = nsPerTick(ticks, [&] { newRan = newTick(queue, usedSubsystems); });
+
+      if (oldRan != newRan) {
+        std::printf("Mismatch: old path ran %zu commands, new path ran %zu\n", oldRan, newRan);
+        return 1;
+      }
+      std::printf("%10zu %10zu %14.1f %14.1f %8.1fx\n", numCommands, numSubsystems, oldNs, newNs, oldNs / newNs);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,446 @@
+/**
+ * Benchmark suite for EventScheduler::update() under synthetic workloads.
+ *
+ * Each workload builds a set of Subsystems, Commands, CommandGroups and Triggers, warms the scheduler up, and then
+ * times every tick (listener checks plus update()) and counts the allocations made during it. The workloads are:
+ *
+ *   defaultCommands     many Subsystems that only ever run their default commands
+ *   triggerBound        many triggers toggling whileActive, whenActivated and stop bindings
+ *   nestedGroups        CommandGroups nested several levels deep, re-run as soon as they finish
+ *   priorityContention  many Commands of different priorities competing for a few Subsystems
+ *   runStopChurn        Commands run() and stop()ped at random every tick
+ *
+ * The scheduler is a singleton that cannot forget Subsystems or listeners, so every workload runs in its own child
+ * process. Results are printed as a table, and can be written as JSON with --json <file>. Given --baseline <file> (JSON
+ * written by an earlier run), every workload is compared against it. Any increase in allocations per tick is flagged
+ * as a regression and makes the program exit with a non-zero status. Times are printed as the change from the
+ * baseline, but vary by tens of percent from run to run even on one machine, so they are only flagged when --tolerance
+ * is given: a mean or p99 time per tick more than that fraction above the baseline is then a regression too. Built and
+ * run by host.mk (make host-bench, make host-bench-compare).
+ */
+#include "AllocationCounter.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Trigger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace libIterativeRobot;
+
+namespace {
+
+const int warmupTicks = 500;
+const int measuredTicks = 5000;
+
+struct Result {
+  char name[32];
+  int ticks;
+  double nsPerTick;
+  double p50;
+  double p99;
+  double max;
+  double allocationsPerTick;
+};
+
+class BenchCommand : public Command {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    BenchCommand(int priority, int ticks) : ticks(ticks) {
+      this->priority = priority;
+    }
+    void require(Subsystem* subsystem) { addRequirement(subsystem); }
+    bool canRun() { return true; }
+    void initialize() { remaining = ticks; }
+    void execute() { remaining--; }
+    bool isFinished() { return ticks >= 0 && remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class BenchSubsystem : public Subsystem {
+  private:
+    BenchCommand* defaultCommand;
+  public:
+    BenchSubsystem(bool withDefault) : defaultCommand(withDefault ? new BenchCommand(Command::DefaultCommandPriority, -1) : NULL) {}
+    void initDefaultCommand() {
+      if (defaultCommand != NULL) {
+        setDefaultCommand(defaultCommand);
+      }
+    }
+};
+
+class BenchGroup : public CommandGroup {
+  public:
+    void sequential(Command* command) { addSequentialCommand(command); }
+    void parallel(Command* command) { addParallelCommand(command); }
+    bool running() { return status == Status::Running; }
+};
+
+class BenchTrigger : public Trigger {
+  public:
+    bool state = false;
+    bool getState() { return state; }
+    using Trigger::whenActivated;
+    using Trigger::whileActive;
+    using Trigger::whenDeactivated;
+    using Trigger::whileInactive;
+};
+
+/**
+ * A workload sets itself up in its constructor and changes its inputs in step(), which is called before every tick.
+ */
+class Workload {
+  public:
+    virtual ~Workload() {}
+    virtual void step(int tick) = 0;
+};
+
+class DefaultCommands : public Workload {
+  public:
+    DefaultCommands() {
+      for (int i = 0; i < 64; i++) {
+        new BenchSubsystem(true);
+      }
+    }
+    void step(int tick) {}
+};
+
+class TriggerBound : public Workload {
+  private:
+    std::vector<BenchTrigger*> triggers;
+  public:
+    TriggerBound() {
+      std::vector<BenchSubsystem*> subsystems;
+      for (int i = 0; i < 16; i++) {
+        subsystems.push_back(new BenchSubsystem(true));
+      }
+      for (int i = 0; i < 256; i++) {
+        BenchTrigger* trigger = new BenchTrigger();
+        BenchCommand* held = new BenchCommand(1 + i % 3, -1);
+        held->require(subsystems[i % subsystems.size()]);
+        trigger->whileActive(held);
+        trigger->whenDeactivated(held, Action::STOP);
+        BenchCommand* pulse = new BenchCommand(1, 5);
+        pulse->require(subsystems[(i + 1) % subsystems.size()]);
+        trigger->whenActivated(pulse);
+        triggers.push_back(trigger);
+      }
+    }
+    void step(int tick) {
+      for (size_t i = 0; i < triggers.size(); i++) {
+        triggers[i]->state = (tick / (8 + i % 32)) % 2 == 0;
+      }
+    }
+};
+
+class NestedGroups : public Workload {
+  private:
+    std::vector<BenchGroup*> groups;
+
+    // Builds a group with two sequential steps, each a leaf command in parallel with a group one level down
+    BenchGroup* build(std::vector<BenchSubsystem*>& subsystems, int depth, int& next) {
+      BenchGroup* group = new BenchGroup();
+      for (int step = 0; step < 2; step++) {
+        BenchCommand* leaf = new BenchCommand(2, 3 + next % 4);
+        leaf->require(subsystems[next++ % subsystems.size()]);
+        group->sequential(leaf);
+        if (depth > 0) {
+          group->parallel(build(subsystems, depth - 1, next));
+        }
+      }
+      return group;
+    }
+  public:
+    NestedGroups() {
+      std::vector<BenchSubsystem*> subsystems;
+      for (int i = 0; i < 32; i++) {
+        subsystems.push_back(new BenchSubsystem(true));
+      }
+      int next = 0;
+      for (int i = 0; i < 4; i++) {
+        groups.push_back(build(subsystems, 4, next));
+      }
+    }
+    void step(int tick) {
+      for (BenchGroup* group : groups) {
+        if (!group->running()) {
+          group->run();
+        }
+      }
+    }
+};
+
+class PriorityContention : public Workload {
+  private:
+    std::vector<BenchCommand*> commands;
+    std::mt19937 rng;
+  public:
+    PriorityContention() : rng(6) {
+      std::vector<BenchSubsystem*> subsystems;
+      for (int i = 0; i < 4; i++) {
+        subsystems.push_back(new BenchSubsystem(true));
+      }
+      for (int i = 0; i < 128; i++) {
+        BenchCommand* command = new BenchCommand(1 + i % 8, 2 + i % 10);
+        command->require(subsystems[i % subsystems.size()]);
+        command->require(subsystems[(i / 4) % subsystems.size()]);
+        commands.push_back(command);
+      }
+    }
+    void step(int tick) {
+      for (int i = 0; i < 16; i++) {
+        commands[rng() % commands.size()]->run();
+      }
+    }
+};
+
+class RunStopChurn : public Workload {
+  private:
+    std::vector<BenchCommand*> commands;
+    std::mt19937 rng;
+  public:
+    RunStopChurn() : rng(6) {
+      std::vector<BenchSubsystem*> subsystems;
+      for (int i = 0; i < 16; i++) {
+        subsystems.push_back(new BenchSubsystem(false));
+      }
+      for (int i = 0; i < 256; i++) {
+        BenchCommand* command = new BenchCommand(1 + i % 2, -1);
+        command->require(subsystems[i % subsystems.size()]);
+        commands.push_back(command);
+      }
+    }
+    void step(int tick) {
+      for (int i = 0; i < 64; i++) {
+        BenchCommand* command = commands[rng() % commands.size()];
+        if (rng() % 2 == 0) {
+          command->run();
+        } else {
+          command->stop();
+        }
+      }
+    }
+};
+
+struct WorkloadEntry {
+  const char* name;
+  Workload* (*create)();
+};
+
+template<typename T>
+Workload* create() {
+  return new T();
+}
+
+const WorkloadEntry workloads[] = {
+  {"defaultCommands", create<DefaultCommands>},
+  {"triggerBound", create<TriggerBound>},
+  {"nestedGroups", create<NestedGroups>},
+  {"priorityContention", create<PriorityContention>},
+  {"runStopChurn", create<RunStopChurn>},
+};
+
+double percentile(std::vector<double>& sorted, double fraction) {
+  return sorted[std::min(sorted.size() - 1, size_t(fraction * sorted.size()))];
+}
+
+Result measure(const WorkloadEntry& entry) {
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  scheduler->reserve(512, 64);
+  Workload* workload = entry.create();
+
+  std::vector<double> times;
+  times.reserve(measuredTicks);
+  size_t allocations = 0;
+  for (int tick = 0; tick < warmupTicks + measuredTicks; tick++) {
+    workload->step(tick);
+    size_t before = allocationCounter::count();
+    auto start = std::chrono::steady_clock::now();
+    scheduler->update();
+    auto end = std::chrono::steady_clock::now();
+    if (tick >= warmupTicks) {
+      allocations += allocationCounter::count() - before;
+      times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+  }
+
+  Result result;
+  std::snprintf(result.name, sizeof(result.name), "%s", entry.name);
+  result.ticks = measuredTicks;
+  double total = 0;
+  for (double time : times) {
+    total += time;
+  }
+  result.nsPerTick = total / times.size();
+  std::sort(times.begin(), times.end());
+  result.p50 = percentile(times, 0.50);
+  result.p99 = percentile(times, 0.99);
+  result.max = times.back();
+  result.allocationsPerTick = double(allocations) / measuredTicks;
+  return result;
+}
+
+// Runs a workload in a child process, so that it starts with an empty scheduler
+bool runIsolated(const WorkloadEntry& entry, Result& result) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  pid_t child = fork();
+  if (child == 0) {
+    close(fds[0]);
+    Result measured = measure(entry);
+    bool written = write(fds[1], &measured, sizeof(measured)) == sizeof(measured);
+    _exit(written ? 0 : 1);
+  }
+  close(fds[1]);
+  bool received = child > 0 && read(fds[0], &result, sizeof(result)) == sizeof(result);
+  close(fds[0]);
+  int status = 0;
+  if (child > 0) {
+    waitpid(child, &status, 0);
+  }
+  return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Each workload is written on its own line, which is all readBaseline() relies on
+void writeJson(const char* path, std::vector<Result>& results) {
+  FILE* file = std::fopen(path, "w");
+  if (file == NULL) {
+    std::printf("Could not write %s\n", path);
+    return;
+  }
+  std::fprintf(file, "{\n  \"benchmark\": \"schedulerSuite\",\n  \"workloads\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    Result& r = results[i];
+    std::fprintf(file, "    {\"name\": \"%s\", \"ticks\": %d, \"nsPerTick\": %.1f, \"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f, "
+                 "\"allocationsPerTick\": %.4f}%s\n", r.name, r.ticks, r.nsPerTick, r.p50, r.p99, r.max,
+                 r.allocationsPerTick, i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  std::fclose(file);
+}
+
+bool field(const std::string& line, const char* key, double& value) {
+  std::string pattern = std::string("\"") + key + "\": ";
+  size_t at = line.find(pattern);
+  if (at == std::string::npos) {
+    return false;
+  }
+  value = std::strtod(line.c_str() + at + pattern.size(), NULL);
+  return true;
+}
+
+bool readBaseline(const char* path, std::vector<Result>& baseline) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t nameAt = line.find("\"name\": \"");
+    if (nameAt == std::string::npos) {
+      continue;
+    }
+    Result r = {};
+    size_t start = nameAt + std::strlen("\"name\": \"");
+    std::snprintf(r.name, sizeof(r.name), "%s", line.substr(start, line.find('"', start) - start).c_str());
+    double ticks = 0;
+    field(line, "ticks", ticks);
+    r.ticks = int(ticks);
+    if (field(line, "nsPerTick", r.nsPerTick) && field(line, "p50", r.p50) && field(line, "p99", r.p99) &&
+        field(line, "max", r.max) && field(line, "allocationsPerTick", r.allocationsPerTick)) {
+      baseline.push_back(r);
+    }
+  }
+  return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+  const char* jsonPath = NULL;
+  const char* baselinePath = NULL;
+  double tolerance = -1; // Times are not checked unless a tolerance is given
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      jsonPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = std::atof(argv[++i]);
+    } else {
+      std::printf("Usage: %s [--json <file>] [--baseline <file>] [--tolerance <fraction>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<Result> results;
+  std::printf("%-20s %10s %10s %10s %10s %12s\n", "workload", "ns/tick", "p50", "p99", "max", "allocs/tick");
+  for (const WorkloadEntry& entry : workloads) {
+    Result result;
+    if (!runIsolated(entry, result)) {
+      std::printf("FAILED: workload %s did not finish\n", entry.name);
+      return 1;
+    }
+    std::printf("%-20s %10.0f %10.0f %10.0f %10.0f %12.4f\n", result.name, result.nsPerTick, result.p50, result.p99,
+                result.max, result.allocationsPerTick);
+    results.push_back(result);
+  }
+
+  if (jsonPath != NULL) {
+    writeJson(jsonPath, results);
+  }
+  if (baselinePath == NULL) {
+    return 0;
+  }
+
+  std::vector<Result> baseline;
+  if (!readBaseline(baselinePath, baseline)) {
+    std::printf("Could not read baseline %s\n", baselinePath);
+    return 2;
+  }
+
+  int regressions = 0;
+  if (tolerance >= 0) {
+    std::printf("\nCompared with %s (time tolerance %.0f%%):\n", baselinePath, tolerance * 100);
+  } else {
+    std::printf("\nCompared with %s (allocations only):\n", baselinePath);
+  }
+  for (Result& result : results) {
+    const Result* previous = NULL;
+    for (Result& b : baseline) {
+      if (std::strcmp(b.name, result.name) == 0) {
+        previous = &b;
+      }
+    }
+    if (previous == NULL) {
+      std::printf("%-20s not in baseline\n", result.name);
+      continue;
+    }
+
+    bool slower = tolerance >= 0 && (result.nsPerTick > previous->nsPerTick * (1 + tolerance) ||
+                                     result.p99 > previous->p99 * (1 + tolerance));
+    bool allocates = result.allocationsPerTick > previous->allocationsPerTick;
+    std::printf("%-20s ns/tick %+6.1f%%  p99 %+6.1f%%  allocs/tick %.4f -> %.4f%s%s\n", result.name,
+                100 * (result.nsPerTick / previous->nsPerTick - 1), 100 * (result.p99 / previous->p99 - 1),
+                previous->allocationsPerTick, result.allocationsPerTick, slower ? "  REGRESSION: time" : "",
+                allocates ? "  REGRESSION: allocations" : "");
+    if (slower || allocates) {
+      regressions++;
+    }
+  }
+  return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/**
+ * Runs a short match on the simulated clock and checks that the robot loop behaves the same way every time.
+ *
+ * The Robot is started with RobotBase::initializeRobot() like on the brain, then the match is driven from outside of
+ * the robot task: one second disabled, two seconds of autonomous and three seconds of teleop, with a controller button
+ * held for half a second partway through teleop. Because the stand-in's clock only moves when the simulation advances
+ * it, every count below is exact, and the program exits with a non-zero status if any of them is off. Built and run by
+ * host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "Robot.h"
+#include "libIterativeRobot/events/JoystickButton.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+struct Counts {
+  int robotInit = 0;
+  int disabledInit = 0;
+  int disabledPeriodic = 0;
+  int autonInit = 0;
+  int autonPeriodic = 0;
+  int teleopInit = 0;
+  int teleopPeriodic = 0;
+  int commandExecutes = 0;
+};
+
+Counts counts;
+
+class HeldCommand : public Command {
+  public:
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() { counts.commandExecutes++; }
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+}
+
+// The bench provides the Robot that RobotBase::initializeRobot() starts
+Robot* Robot::instance = 0;
+
+Robot::Robot() {
+}
+
+void Robot::robotInit() {
+  counts.robotInit++;
+  static pros::Controller controller(pros::E_CONTROLLER_MASTER);
+  JoystickButton* button = new JoystickButton(&controller, pros::E_CONTROLLER_DIGITAL_A);
+  HeldCommand* command = new HeldCommand();
+  button->whileHeld(command);
+  button->whenReleased(command, Action::STOP);
+}
+
+void Robot::autonInit() {
+  counts.autonInit++;
+}
+
+void Robot::autonPeriodic() {
+  counts.autonPeriodic++;
+}
+
+void Robot::teleopInit() {
+  counts.teleopInit++;
+}
+
+void Robot::teleopPeriodic() {
+  counts.teleopPeriodic++;
+}
+
+void Robot::disabledInit() {
+  counts.disabledInit++;
+}
+
+void Robot::disabledPeriodic() {
+  counts.disabledPeriodic++;
+}
+
+Robot* Robot::getInstance() {
+  if (instance == NULL) {
+    instance = new Robot();
+  }
+  return instance;
+}
+
+int main() {
+  host::setCompetitionStatus(COMPETITION_CONNECTED | COMPETITION_DISABLED);
+  RobotBase::initializeRobot();
+
+  // The loop runs at t = 0, 10, 20 ... so each phase sees one cycle per 10ms, the first of which calls its init. The
+  // held command starts on the second cycle that sees the button down, since whileHeld waits for it to stay pressed
+  host::advance(1000);
+  host::setCompetitionStatus(COMPETITION_CONNECTED | COMPETITION_AUTONOMOUS);
+  host::advance(2000);
+  host::setCompetitionStatus(COMPETITION_CONNECTED);
+  host::advance(1000);
+  host::setDigital(pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_A, true);
+  host::advance(500);
+  host::setDigital(pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_A, false);
+  host::advance(1500);
+
+  check("robotInit", counts.robotInit, 1);
+  check("disabledInit", counts.disabledInit, 1);
+  check("disabledPeriodic", counts.disabledPeriodic, 100);
+  check("autonInit", counts.autonInit, 1);
+  check("autonPeriodic", counts.autonPeriodic, 199);
+  check("teleopInit", counts.teleopInit, 1);
+  check("teleopPeriodic", counts.teleopPeriodic, 299);
+  check("commandExecutes", counts.commandExecutes, 49);
+  check("simulated ms", int(pros::millis()), 6000);
+  check("tasks", int(host::taskCount()), 1);
+  return bench::status();
+}
@@ -0,0 +1,245 @@
+/**
+ * Checks the library built with LIBITERATIVEROBOT_STATIC, where every container has a fixed capacity.
+ *
+ * A robot is set up the way robotInit() would set it up: subsystems with default Commands, JoystickButtons on two
+ * controllers bound to Commands, a CommandGroup, and a ConditionalGroup that caches its branches. It is then driven
+ * through a scripted stretch of updates that presses the buttons and re-runs both groups. The program checks that
+ * nothing goes through operator new, from the first EventScheduler::getInstance() to the last update. It then goes past
+ * each capacity in turn: more Commands at once than LIBITERATIVEROBOT_MAX_COMMANDS, a CommandGroup with too many
+ * commands, more EventListeners than LIBITERATIVEROBOT_MAX_LISTENERS, and a third controller. Each must be counted by
+ * StorageDiagnostics and dropped without disturbing what fits, still without allocating. The program prints the size
+ * of the main objects. It exits with a non-zero status if any check fails. Built with LIBITERATIVEROBOT_STATIC and run
+ * by host.mk (make host-bench).
+ */
+#include "AllocationCounter.h"
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/commands/ConditionalGroup.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/JoystickButton.h"
+#include <cstdio>
+#include <new>
+
+#ifndef LIBITERATIVEROBOT_STATIC
+#error "staticStorage.cpp checks the LIBITERATIVEROBOT_STATIC build"
+#endif
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int numSubsystems = 4;
+const int numButtons = 4;
+const int ticks = 1000;
+
+class CountedCommand : public Command {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    int starts = 0, ends = 0, interruptions = 0, blocks = 0;
+    CountedCommand(Subsystem* subsystem = NULL, int ticks = 3, int priority = 1) : ticks(ticks) {
+      if (subsystem != NULL) {
+        addRequirement(subsystem);
+      }
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() { starts++; remaining = ticks; }
+    void execute() { remaining--; }
+    bool isFinished() { return ticks >= 0 && remaining <= 0; }
+    void end() { ends++; }
+    void interrupted() { interruptions++; }
+    void blocked() { blocks++; }
+};
+
+class BenchSubsystem : public Subsystem {
+  public:
+    CountedCommand defaultCommand{NULL, -1, Command::DefaultCommandPriority};
+    void initDefaultCommand() {
+      setDefaultCommand(&defaultCommand);
+    }
+};
+
+class Sequence : public CommandGroup {
+  public:
+    Sequence(CountedCommand* commands, int count) {
+      for (int i = 0; i < count; i++) {
+        addSequentialCommand(&commands[i]);
+      }
+    }
+};
+
+class Wide : public CommandGroup {
+  public:
+    int ends = 0;
+    void end() {
+      CommandGroup::end();
+      ends++;
+    }
+    Wide(CountedCommand* commands, int count) {
+      for (int i = 0; i < count; i++) {
+        addParallelCommand(&commands[i]);
+      }
+    }
+};
+
+class Alternating : public ConditionalGroup {
+  private:
+    CountedCommand* left;
+    CountedCommand* right;
+    int runs = 0;
+  public:
+    int bodies = 0;
+    Alternating(CountedCommand* left, CountedCommand* right) : left(left), right(right) {}
+    int conditionalBranch() { return runs % 2; }
+    void conditionalBody() {
+      bodies++;
+      addSequentialCommand(conditionalBranch() == 0 ? left : right);
+    }
+    void run() {
+      ConditionalGroup::run();
+      runs++;
+    }
+};
+
+class CountedListener : public EventListener {
+  public:
+    int checks = 0;
+    void checkConditions() { checks++; }
+};
+
+void update(int count = 1) {
+  for (int i = 0; i < count; i++) {
+    EventScheduler::getInstance()->update();
+  }
+}
+
+}
+
+int main() {
+  std::size_t allocations = allocationCounter::count();
+
+  // Sets up the robot
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  BenchSubsystem subsystems[numSubsystems];
+  pros::Controller master(pros::E_CONTROLLER_MASTER), partner(pros::E_CONTROLLER_PARTNER);
+  pros::Controller* controllers[] = {&master, &partner};
+  pros::controller_id_e_t ids[] = {pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_PARTNER};
+  CountedCommand buttonCommands[2][numButtons] = {
+      {{&subsystems[0]}, {&subsystems[1]}, {&subsystems[2]}, {&subsystems[3]}},
+      {{&subsystems[0], 5, 2}, {&subsystems[1], 5, 2}, {&subsystems[2], 5, 2}, {&subsystems[3], 5, 2}}};
+  JoystickButton* buttons[2][numButtons];
+  alignas(JoystickButton) static unsigned char buttonStorage[2][numButtons][sizeof(JoystickButton)];
+  for (int controller = 0; controller < 2; controller++) {
+    for (int button = 0; button < numButtons; button++) {
+      buttons[controller][button] = new (buttonStorage[controller][button])
+          JoystickButton(controllers[controller], pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button));
+      buttons[controller][button]->whenPressed(&buttonCommands[controller][button]);
+    }
+  }
+  CountedCommand steps[3] = {{&subsystems[0], 4}, {&subsystems[1], 4}, {&subsystems[2], 4}};
+  Sequence sequence(steps, 3);
+  CountedCommand branchCommands[2] = {{&subsystems[3], 2}, {&subsystems[3], 6}};
+  Alternating alternating(&branchCommands[0], &branchCommands[1]);
+
+  // Drives it through a scripted stretch of updates
+  for (int tick = 0; tick < ticks; tick++) {
+    for (int controller = 0; controller < 2; controller++) {
+      for (int button = 0; button < numButtons; button++) {
+        host::setDigital(ids[controller], pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button),
+                         (tick / (7 + 3 * button + 5 * controller)) % 3 == 1);
+      }
+    }
+    if (tick % 50 == 0) {
+      sequence.run();
+    }
+    if (tick % 30 == 15) {
+      alternating.run();
+    }
+    update();
+  }
+  for (int controller = 0; controller < 2; controller++) {
+    for (int button = 0; button < numButtons; button++) {
+      host::setDigital(ids[controller], pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button), false);
+    }
+  }
+  update(20);
+
+  int buttonStarts = 0;
+  for (int controller = 0; controller < 2; controller++) {
+    for (int button = 0; button < numButtons; button++) {
+      buttonStarts += buttonCommands[controller][button].starts;
+    }
+  }
+  std::printf("%d updates: %d button commands, %d sequences, %d branch runs with %d bodies built\n", ticks,
+              buttonStarts, steps[2].ends, branchCommands[0].starts + branchCommands[1].starts, alternating.bodies);
+  check("setup and updates allocated nothing", allocationCounter::count() == allocations);
+  check("nothing overflowed", StorageDiagnostics::getOverflows() == 0);
+  check("default commands ran", subsystems[0].defaultCommand.starts > 0);
+  check("buttons ran their commands", buttonStarts > 0);
+  check("sequence ran to the end", steps[2].ends > 0 && steps[2].ends <= ticks / 50);
+  check("each cached branch was built once", alternating.bodies == 2 && branchCommands[1].starts > 0);
+
+  // More Commands at once than the EventScheduler holds are blocked, and the rest run
+  const int extra = 6;
+  static CountedCommand crowd[LIBITERATIVEROBOT_MAX_COMMANDS + extra];
+  std::uint32_t overflows = StorageDiagnostics::getOverflows();
+  for (CountedCommand& command : crowd) {
+    command.run();
+  }
+  update();
+  int started = 0, blocked = 0;
+  for (CountedCommand& command : crowd) {
+    started += command.starts;
+    blocked += command.blocks;
+  }
+  std::printf("%d commands run at once: %d started, %d blocked\n", LIBITERATIVEROBOT_MAX_COMMANDS + extra, started,
+              blocked);
+  check("commands past the capacity were blocked", started == LIBITERATIVEROBOT_MAX_COMMANDS - numSubsystems &&
+                                                       started + blocked == LIBITERATIVEROBOT_MAX_COMMANDS + extra);
+  check("each blocked command was counted", StorageDiagnostics::getOverflows() - overflows == std::uint32_t(blocked));
+  for (CountedCommand& command : crowd) {
+    command.stop();
+  }
+  update();
+  check("stopping them interrupted the ones that started", crowd[0].interruptions == 1);
+
+  // A CommandGroup keeps the commands that fit and runs them
+  static CountedCommand wideCommands[LIBITERATIVEROBOT_MAX_GROUP_COMMANDS + 3];
+  overflows = StorageDiagnostics::getOverflows();
+  Wide wide(wideCommands, LIBITERATIVEROBOT_MAX_GROUP_COMMANDS + 3);
+  check("commands past a group's capacity were counted", StorageDiagnostics::getOverflows() - overflows == 3);
+  wide.run();
+  update(10);
+  check("the group ran the commands that fit", wideCommands[0].ends == 1 &&
+                                                   wideCommands[LIBITERATIVEROBOT_MAX_GROUP_COMMANDS - 1].ends == 1 &&
+                                                   wideCommands[LIBITERATIVEROBOT_MAX_GROUP_COMMANDS].starts == 0 &&
+                                                   wide.ends == 1);
+
+  // EventListeners past the capacity are never checked
+  overflows = StorageDiagnostics::getOverflows();
+  static CountedListener listeners[LIBITERATIVEROBOT_MAX_LISTENERS];
+  size_t fitting = LIBITERATIVEROBOT_MAX_LISTENERS - 2 * numButtons;
+  update();
+  check("listeners past the capacity were counted", StorageDiagnostics::getOverflows() - overflows == 2 * numButtons &&
+                                                        scheduler->getListenerCount() == LIBITERATIVEROBOT_MAX_LISTENERS);
+  check("only the listeners that fit were checked", listeners[fitting - 1].checks == 1 && listeners[fitting].checks == 0);
+
+  // A third controller gets a snapshot that never reads a press
+  overflows = StorageDiagnostics::getOverflows();
+  pros::Controller third(pros::E_CONTROLLER_MASTER);
+  ControllerSnapshot* snapshot = scheduler->getControllerSnapshot(&third);
+  host::setDigital(pros::E_CONTROLLER_MASTER, pros::E_CONTROLLER_DIGITAL_L1, true);
+  snapshot->useDigital(pros::E_CONTROLLER_DIGITAL_L1);
+  update();
+  check("a third controller was counted", StorageDiagnostics::getOverflows() - overflows == 1);
+  check("its snapshot is never captured", !snapshot->getDigital(pros::E_CONTROLLER_DIGITAL_L1));
+  check("going past every capacity allocated nothing", allocationCounter::count() == allocations);
+
+  std::printf("sizeof EventScheduler %zu, Command %zu, CommandGroup %zu, ConditionalGroup %zu, JoystickButton %zu bytes\n",
+              sizeof(EventScheduler), sizeof(Command), sizeof(CommandGroup), sizeof(ConditionalGroup),
+              sizeof(JoystickButton));
+  return bench::status();
+}
@@ -0,0 +1,142 @@
+/**
+ * Checks that EventScheduler::update() does not allocate once the scheduler has warmed up.
+ *
+ * Builds a steady-state workload out of default commands, trigger-bound commands that are repeatedly run and stopped,
+ * short commands that finish and are re-run, and a CommandGroup that is re-run every few ticks. After a warm-up period
+ * every call to update() is checked with the allocation counter, and the program exits with a non-zero status if any
+ * allocation happens. Built and run by host.mk (make host-bench).
+ */
+#include "AllocationCounter.h"
+#include "Check.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Trigger.h"
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+class IdleCommand : public Command {
+  public:
+    IdleCommand(int priority) {
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {}
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class TimedCommand : public Command {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    TimedCommand(Subsystem* subsystem, int priority, int ticks) : ticks(ticks) {
+      addRequirement(subsystem);
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() { remaining = ticks; }
+    void execute() { remaining--; }
+    bool isFinished() { return remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class BenchSubsystem : public Subsystem {
+  private:
+    IdleCommand defaultCommand;
+  public:
+    BenchSubsystem() : defaultCommand(Command::DefaultCommandPriority) {}
+    void initDefaultCommand() {
+      setDefaultCommand(&defaultCommand);
+    }
+};
+
+class BenchGroup : public CommandGroup {
+  public:
+    BenchGroup(std::vector<Command*>& steps) {
+      for (size_t i = 0; i < steps.size(); i++) {
+        if (i % 2 == 0) {
+          addSequentialCommand(steps[i]);
+        } else {
+          addParallelCommand(steps[i]);
+        }
+      }
+    }
+};
+
+class BenchTrigger : public Trigger {
+  public:
+    bool state = false;
+    bool getState() { return state; }
+    using Trigger::whenActivated;
+    using Trigger::whileActive;
+    using Trigger::whileInactive;
+};
+
+}
+
+int main() {
+  const int numSubsystems = 8;
+  const int numTriggers = 24;
+  const int warmupTicks = 500;
+  const int measuredTicks = 5000;
+
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  scheduler->reserve(128, 16);
+
+  std::vector<BenchSubsystem*> subsystems;
+  for (int i = 0; i < numSubsystems; i++) {
+    subsystems.push_back(new BenchSubsystem());
+  }
+
+  // Triggers bound to commands with every kind of binding, toggled on different periods
+  std::vector<BenchTrigger*> triggers;
+  for (int i = 0; i < numTriggers; i++) {
+    BenchTrigger* trigger = new BenchTrigger();
+    Subsystem* subsystem = subsystems[i % numSubsystems];
+    trigger->whileActive(new TimedCommand(subsystem, 2 + i % 3, 1000));
+    trigger->whenActivated(new TimedCommand(subsystems[(i + 1) % numSubsystems], 1, 3));
+    trigger->whileInactive(new TimedCommand(subsystem, 1, 1000), Action::STOP);
+    triggers.push_back(trigger);
+  }
+
+  // A CommandGroup that is re-run whenever it finishes
+  std::vector<Command*> steps;
+  for (int i = 0; i < 6; i++) {
+    steps.push_back(new TimedCommand(subsystems[i % numSubsystems], 3, 2 + i));
+  }
+  BenchGroup group(steps);
+
+  size_t allocatingTicks = 0;
+  size_t totalAllocations = 0;
+  for (int tick = 0; tick < warmupTicks + measuredTicks; tick++) {
+    for (int i = 0; i < numTriggers; i++) {
+      triggers[i]->state = (tick / (5 + i)) % 2 == 0;
+    }
+    if (tick % 40 == 0) {
+      group.run();
+    }
+
+    size_t before = allocationCounter::count();
+    scheduler->update();
+    size_t allocations = allocationCounter::count() - before;
+
+    if (tick >= warmupTicks && allocations != 0) {
+      allocatingTicks++;
+      totalAllocations += allocations;
+    }
+  }
+
+  std::printf("%d steady-state ticks, %zu ticks allocated, %zu allocations\n", measuredTicks, allocatingTicks, totalAllocations);
+  check("ticks that allocated after warm-up", allocatingTicks, 0);
+  return bench::status();
+}
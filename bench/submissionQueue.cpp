@@ -0,0 +1,177 @@
+/**
+ * Stress tests the SubmissionQueue that carries run and stop requests from other tasks to the EventScheduler.
+ *
+ * First, several producer threads push numbered requests into a SubmissionQueue as fast as they can while the main
+ * thread pops them, retrying whenever the queue is full. Every request must be popped exactly once, and each
+ * producer's requests must come out in the order it pushed them. Then the same number of threads stand in for tasks
+ * like vision or odometry, submitting requests to run and stop Commands through EventScheduler::submit() while the
+ * main thread keeps updating the scheduler, and every request must take effect. Real threads are used rather than the
+ * stand-in's tasks, which take turns on the simulated clock and so never race. The program prints the throughput of
+ * the queue and how often it was full. It exits with a non-zero status if any check fails. Built and run by host.mk
+ * (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/SubmissionQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int producers = 4;
+const int requestsPerProducer = 200000;
+const int roundsPerTask = 2000;
+
+// Stands in for a Command in the raw queue test, where the pointers are only compared and never called
+char tokens[producers][requestsPerProducer];
+
+struct QueueResult {
+  long popped = 0;
+  long duplicates = 0;
+  long outOfOrder = 0;
+  long retries = 0;
+  double seconds = 0;
+};
+
+QueueResult stressQueue() {
+  static SubmissionQueue queue;
+  QueueResult result;
+  std::atomic<long> retries(0);
+  std::atomic<bool> go(false);
+  std::vector<std::thread> threads;
+  for (int producer = 0; producer < producers; producer++) {
+    threads.emplace_back([&, producer]() {
+      while (!go.load()) { std::this_thread::yield(); }
+      long failed = 0;
+      for (int i = 0; i < requestsPerProducer; i++) {
+        SubmissionQueue::Request request = i % 2 == 0 ? SubmissionQueue::Request::Run : SubmissionQueue::Request::Stop;
+        while (!queue.push(reinterpret_cast<Command*>(&tokens[producer][i]), request)) {
+          failed++;
+          std::this_thread::yield();
+        }
+      }
+      retries += failed;
+    });
+  }
+
+  // The next request expected from each producer
+  int next[producers] = {};
+  long total = long(producers) * requestsPerProducer;
+  auto start = std::chrono::steady_clock::now();
+  go.store(true);
+  while (result.popped + result.duplicates < total) {
+    Command* command;
+    SubmissionQueue::Request request;
+    if (!queue.pop(command, request)) {
+      std::this_thread::yield(); // Lets the producers run on machines with fewer cores than threads
+      continue;
+    }
+    char* token = reinterpret_cast<char*>(command);
+    int producer = (token - &tokens[0][0]) / requestsPerProducer;
+    int i = (token - &tokens[0][0]) % requestsPerProducer;
+    SubmissionQueue::Request expected = i % 2 == 0 ? SubmissionQueue::Request::Run : SubmissionQueue::Request::Stop;
+    if (i < next[producer]) {
+      result.duplicates++;
+      continue;
+    }
+    if (i != next[producer] || request != expected) {
+      result.outOfOrder++;
+    }
+    next[producer] = i + 1;
+    result.popped++;
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  Command* command;
+  SubmissionQueue::Request request;
+  result.duplicates += queue.pop(command, request) ? 1 : 0; // Nothing is left over
+  result.retries = retries;
+  if (std::uint32_t(retries.load()) != queue.getDropped()) {
+    result.outOfOrder++; // Every failed push is counted as dropped
+  }
+  return result;
+}
+
+// Runs until it is stopped, counting how often it starts and is interrupted
+class WorkerCommand : public Command {
+  public:
+    std::atomic<int> starts{0};
+    std::atomic<int> interruptions{0};
+    bool canRun() { return true; }
+    void initialize() { starts++; }
+    void execute() {}
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() { interruptions++; }
+    void blocked() {}
+};
+
+struct SchedulerResult {
+  long starts = 0;
+  long interruptions = 0;
+  long updates = 0;
+};
+
+SchedulerResult stressScheduler() {
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  std::vector<WorkerCommand> commands(producers);
+  std::atomic<int> finished(0);
+  std::vector<std::thread> threads;
+  for (int producer = 0; producer < producers; producer++) {
+    threads.emplace_back([&, producer]() {
+      WorkerCommand& command = commands[producer];
+      for (int round = 0; round < roundsPerTask; round++) {
+        // Starts the command and waits for the scheduler to initialize it, then stops it and waits for the interruption
+        while (!scheduler->submit(&command, SubmissionQueue::Request::Run)) { std::this_thread::yield(); }
+        while (command.starts.load() <= round) { std::this_thread::yield(); }
+        while (!scheduler->submit(&command, SubmissionQueue::Request::Stop)) { std::this_thread::yield(); }
+        while (command.interruptions.load() <= round) { std::this_thread::yield(); }
+      }
+      finished++;
+    });
+  }
+
+  SchedulerResult result;
+  while (finished.load() < producers) {
+    scheduler->update();
+    result.updates++;
+    std::this_thread::yield();
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (WorkerCommand& command : commands) {
+    result.starts += command.starts;
+    result.interruptions += command.interruptions;
+  }
+  return result;
+}
+
+}
+
+int main() {
+  QueueResult queue = stressQueue();
+  long total = long(producers) * requestsPerProducer;
+  std::printf("%d producers, %ld requests: %.1f M requests/s, queue full on %ld pushes\n", producers, total,
+              total / queue.seconds / 1e6, queue.retries);
+  check("every request popped", queue.popped == total);
+  check("no request popped twice", queue.duplicates == 0);
+  check("each producer's requests in order", queue.outOfOrder == 0);
+
+  SchedulerResult scheduler = stressScheduler();
+  long rounds = long(producers) * roundsPerTask;
+  std::printf("%d tasks, %ld run/stop rounds over %ld updates\n", producers, rounds, scheduler.updates);
+  check("every submitted run started its command", scheduler.starts == rounds);
+  check("every submitted stop interrupted its command", scheduler.interruptions == rounds);
+  check("no submission dropped", EventScheduler::getInstance()->getDroppedSubmissions() == 0);
+  return bench::status();
+}
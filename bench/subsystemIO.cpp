@@ -0,0 +1,239 @@
+/**
+ * Checks that Subsystem::readInputs() and Subsystem::writeOutputs() batch a Subsystem's device traffic into one read
+ * and one write per update.
+ *
+ * A drive is used by a default Command, a higher priority Command that holds a heading, a Trigger that watches for the
+ * drive stalling, and a CommandGroup step that logs the distance driven. The drive is built twice. The ad hoc drive has
+ * every user read the encoder and set the motor itself, the way Commands usually do in execute(). The batched drive
+ * reads the encoder once in readInputs() and sets the motor once in writeOutputs(), and its users only touch the cached
+ * values. The simulated encoder moves a little between reads, as a real one does during an update. The program checks
+ * that the batched drive reads and writes each device once per update, and that every user of it sees the same reading
+ * within an update. It checks that readInputs() runs before any Trigger or Command and writeOutputs() after all of
+ * them, including Commands started by a CommandGroup during the update. It prints the device transactions per update
+ * for both drives. It exits with a non-zero status if any check fails. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "libIterativeRobot/commands/CommandGroup.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Trigger.h"
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int updates = 1000;
+
+// Stands in for a smart port device, counting every transaction
+struct Device {
+  int reads = 0;
+  int writes = 0;
+  double position = 0;
+  double power = 0;
+
+  double read() {
+    reads++;
+    position += 0.25; // The robot moves a little between reads in the same update
+    return position;
+  }
+
+  void write(double value) {
+    writes++;
+    power = value;
+  }
+};
+
+// The order things happen in during an update
+enum Step { ReadInputs, Checked, Executed, WriteOutputs };
+std::vector<Step> steps;
+
+// The readings each user of the drive saw during the current update
+std::vector<double> readings;
+
+class Drive : public Subsystem {
+  private:
+    bool batched;
+    Command* defaultDrive = NULL;
+  public:
+    Device encoder, motor;
+    double position = 0;
+    double power = 0;
+    int readCalls = 0, writeCalls = 0;
+
+    Drive(bool batched) : batched(batched) {}
+
+    void setDefault(Command* command) {
+      defaultDrive = command;
+    }
+
+    void initDefaultCommand() {
+      if (defaultDrive != NULL) {
+        setDefaultCommand(defaultDrive);
+      }
+    }
+
+    // The ad hoc drive talks to its devices on every call, while the batched one uses what readInputs() read
+    double getPosition() {
+      double value = batched ? position : encoder.read();
+      readings.push_back(value);
+      return value;
+    }
+
+    void setPower(double value) {
+      if (batched) {
+        power = value;
+      } else {
+        motor.write(value);
+      }
+    }
+
+    void readInputs() {
+      readCalls++;
+      steps.push_back(ReadInputs);
+      if (batched) {
+        position = encoder.read();
+      }
+    }
+
+    void writeOutputs() {
+      writeCalls++;
+      steps.push_back(WriteOutputs);
+      if (batched) {
+        motor.write(power);
+      }
+    }
+};
+
+class DriveCommand : public Command {
+  private:
+    Drive* drive;
+    double power;
+  public:
+    DriveCommand(Drive* drive, double power, int priority) : drive(drive), power(power) {
+      addRequirement(drive);
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {
+      steps.push_back(Executed);
+      drive->setPower(power - drive->getPosition() * 0.001);
+    }
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// Reads the drive without requiring it, the way a logging or odometry Command would
+class LogDistance : public Command {
+  private:
+    Drive* drive;
+  public:
+    double logged = 0;
+    LogDistance(Drive* drive) : drive(drive) {}
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {
+      steps.push_back(Executed);
+      logged = drive->getPosition();
+    }
+    bool isFinished() { return true; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class LogGroup : public CommandGroup {
+  public:
+    LogGroup(LogDistance* log) {
+      addSequentialCommand(log);
+    }
+};
+
+class StallTrigger : public Trigger {
+  private:
+    Drive* drive;
+    double last = 0;
+  public:
+    StallTrigger(Drive* drive) : drive(drive) {}
+    bool getState() {
+      steps.push_back(Checked);
+      double position = drive->getPosition();
+      bool stalled = position == last;
+      last = position;
+      return stalled;
+    }
+};
+
+struct Result {
+  double readsPerUpdate;
+  double writesPerUpdate;
+  bool consistent;
+  bool ordered;
+  bool hooksOncePerUpdate;
+};
+
+Result run(Drive& drive) {
+  DriveCommand defaultDrive(&drive, 0.5, Command::DefaultCommandPriority);
+  DriveCommand holdHeading(&drive, 0.8, 1);
+  LogDistance log(&drive);
+  LogGroup logGroup(&log);
+  StallTrigger stall(&drive);
+  drive.setDefault(&defaultDrive);
+  holdHeading.run();
+
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  scheduler->initialize(); // Adds the drive's default Command on the next update
+  scheduler->update();
+
+  int reads = drive.encoder.reads, writes = drive.motor.writes;
+  int readCalls = drive.readCalls, writeCalls = drive.writeCalls;
+  Result result = {0, 0, true, true, true};
+  for (int i = 0; i < updates; i++) {
+    if (i % 10 == 0) {
+      logGroup.run(); // Starts a Command partway through the update
+    }
+    steps.clear();
+    readings.clear();
+    scheduler->update();
+
+    // Every reading in an update is the same, and each hook runs before or after everything else
+    for (double reading : readings) {
+      result.consistent &= reading == readings[0];
+    }
+    result.ordered &= !steps.empty() && steps.front() == ReadInputs && steps.back() == WriteOutputs;
+  }
+  result.readsPerUpdate = double(drive.encoder.reads - reads) / updates;
+  result.writesPerUpdate = double(drive.motor.writes - writes) / updates;
+  result.hooksOncePerUpdate = drive.readCalls - readCalls == updates && drive.writeCalls - writeCalls == updates;
+  holdHeading.stop();
+  drive.setDefault(NULL); // Its default Command goes out of scope, so it is not added again
+  scheduler->initialize(true);
+  scheduler->update();
+  return result;
+}
+
+}
+
+int main() {
+  Drive* adHocDrive = new Drive(false);
+  Result adHoc = run(*adHocDrive);
+  Drive* batchedDrive = new Drive(true);
+  Result batched = run(*batchedDrive);
+
+  std::printf("ad hoc:  %.2f encoder reads, %.2f motor writes per update\n", adHoc.readsPerUpdate,
+              adHoc.writesPerUpdate);
+  std::printf("batched: %.2f encoder reads, %.2f motor writes per update\n", batched.readsPerUpdate,
+              batched.writesPerUpdate);
+  check("ad hoc drive reads the encoder more than once", adHoc.readsPerUpdate > 2);
+  check("ad hoc readings differ within an update", !adHoc.consistent);
+  check("batched drive reads the encoder once per update", batched.readsPerUpdate == 1);
+  check("batched drive writes the motor once per update", batched.writesPerUpdate == 1);
+  check("every user of the batched drive saw the same reading", batched.consistent);
+  check("readInputs() ran first and writeOutputs() last", adHoc.ordered && batched.ordered);
+  check("each hook ran once per update", adHoc.hooksOncePerUpdate && batched.hooksOncePerUpdate);
+  return bench::status();
+}
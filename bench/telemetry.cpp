@@ -0,0 +1,305 @@
+/**
+ * Checks that what Telemetry streams is what the EventScheduler did, and measures how much it sends.
+ *
+ * A drivetrain with a default Command and an arm run a scripted series of Commands, one of which the Telemetry is not
+ * told about, while the Telemetry samples the Status of each Command, which Command is using each Subsystem, the time
+ * each update took and two values, writing its frames to a file from its own task. The program records what it
+ * expects each update to look like, decodes the file with a TelemetryDecoder and checks that every update matches.
+ * It then runs a burst of updates without giving the writer task a chance to run, and checks that the frames that did
+ * not fit were counted, that the updates read afterwards are still right, and that the stream picks up again at the
+ * next keyframe. It checks that a damaged stream, one with printf() text mixed in and one read from partway through
+ * are read without a wrong row, that the CSV has a row for every update with the names of the Commands, and that
+ * sampling allocates nothing. It prints the bytes sent per update next to what printf() would send for the same
+ * values, and the time sampling adds to an update. It exits with a non-zero status if any check fails. Built and run
+ * by host.mk (make host-bench).
+ */
+#include "AllocationCounter.h"
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Telemetry.h"
+#include "libIterativeRobot/events/TelemetryDecoder.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int updateMillis = 10;
+
+// Whether the drivetrain's default Command takes some time on each update, as a real one reading sensors would
+bool busy = true;
+
+// A Command that keeps track of the Status the EventScheduler gives it, by way of the method it calls
+class Tracked : public Command {
+  private:
+    int updates;
+    int length;
+  public:
+    Status seen = Status::Idle;
+    Tracked(Subsystem* requirement, int priority, int length) : length(length) {
+      if (requirement != NULL) {
+        addRequirement(requirement);
+      }
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() {
+      seen = Status::Running;
+      updates = 0;
+    }
+    void execute() {
+      if (busy && priority == 0) {
+        host::advanceMicros(150 + updates % 5 * 10);
+      }
+      updates++;
+    }
+    bool isFinished() { return length > 0 && updates >= length; }
+    void end() { seen = Status::Finished; }
+    void interrupted() { seen = Status::Interrupted; }
+    void blocked() { seen = Status::Blocked; }
+};
+
+class Drive : public Subsystem {
+  public:
+    Tracked defaultCommand{this, 0, 0};
+    void initDefaultCommand() {
+      setDefaultCommand(&defaultCommand);
+    }
+};
+
+class Arm : public Subsystem {
+  public:
+    void initDefaultCommand() {}
+};
+
+// Collects the rows a TelemetryDecoder reads
+class Collector : public TelemetryDecoder {
+  protected:
+    void row(std::uint32_t update, const std::vector<std::int64_t>& values) {
+      rows[update] = values;
+    }
+  public:
+    std::map<std::uint32_t, std::vector<std::int64_t>> rows;
+};
+
+std::vector<std::uint8_t> readFile(FILE* file) {
+  std::vector<std::uint8_t> data;
+  std::fflush(file);
+  std::rewind(file);
+  std::uint8_t chunk[4096];
+  size_t size;
+  while ((size = std::fread(chunk, 1, sizeof(chunk), file)) != 0) {
+    data.insert(data.end(), chunk, chunk + size);
+  }
+  std::fseek(file, 0, SEEK_END); // So the writer task carries on from the end
+  return data;
+}
+
+// Whether every row decoded is the one expected for its update
+bool allMatch(const Collector& collector, const std::vector<std::vector<std::int64_t>>& expected) {
+  for (const auto& row : collector.rows) {
+    if (row.first >= expected.size() || row.second != expected[row.first]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int main() {
+  Drive drive;
+  Arm arm;
+  Tracked turn(&drive, 1, 30), lift(&arm, 1, 40), nudge(&arm, 2, 5);
+  double armAngle = 0, battery = 12.6;
+
+  FILE* stream = std::tmpfile();
+  Telemetry* telemetry = new Telemetry();
+  telemetry->addCommand("driveDefault", &drive.defaultCommand);
+  telemetry->addCommand("turn", &turn);
+  telemetry->addCommand("lift", &lift);
+  telemetry->addSubsystem("drive", &drive);
+  telemetry->addSubsystem("arm", &arm);
+  telemetry->addValue("armAngle", &armAngle, 1000);
+  telemetry->addValue("battery", &battery, 100);
+  telemetry->setOutput(stream);
+  telemetry->start();
+  check("a file output left the serial port's COBS alone", host::serialCobs());
+  Telemetry* console = new Telemetry();
+  console->start();
+  check("a stdout output turned the serial port's COBS off", !host::serialCobs());
+
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  scheduler->reserve(8, 2);
+  scheduler->setTelemetry(telemetry);
+  scheduler->initialize();
+
+  // What each update should look like, in the order the channels were added, and what printf() would send for it
+  std::vector<std::vector<std::int64_t>> expected;
+  size_t printfBytes = 0;
+  std::size_t allocations = 0;
+  auto active = [](std::initializer_list<std::pair<Tracked*, std::int64_t>> commands) -> std::int64_t {
+    for (const auto& command : commands) {
+      if (command.first->seen == Status::Running) {
+        return command.second;
+      }
+    }
+    return 0;
+  };
+  auto step = [&](int update, bool advance) {
+    Tracked* started = update % 200 == 50 ? &turn : update % 200 == 100 ? &lift : update % 200 == 120 ? &nudge : NULL;
+    if (started != NULL) {
+      started->run();
+      started->seen = Status::Idle; // As run() sets it
+    }
+    armAngle = 90 * std::sin(update * 0.05);
+    battery = 12.6 - update * 0.0001;
+    std::uint64_t start = host::micros();
+    std::size_t before = allocationCounter::count();
+    scheduler->update();
+    allocations += allocationCounter::count() - before;
+    std::int64_t updateMicros = std::int64_t(host::micros() - start);
+    std::int64_t driveActive = active({{&turn, 2}, {&drive.defaultCommand, 1}});
+    std::int64_t armActive = nudge.seen == Status::Running ? -1 : active({{&lift, 3}});
+    expected.push_back({updateMicros, std::int64_t(drive.defaultCommand.seen), std::int64_t(turn.seen),
+                        std::int64_t(lift.seen), driveActive, armActive, std::llround(armAngle * 1000),
+                        std::llround(battery * 100)});
+    char line[128];
+    printfBytes += std::snprintf(line, sizeof(line), "%d,%lld,%d,%d,%d,%lld,%lld,%.3f,%.2f\n", update,
+                                 (long long)updateMicros, int(drive.defaultCommand.seen), int(turn.seen),
+                                 int(lift.seen), (long long)driveActive, (long long)armActive, armAngle, battery);
+    if (advance) {
+      host::advance(updateMillis);
+    }
+  };
+
+  // Steady running, during which updates should not allocate once every Command has run once
+  const int steadyUpdates = 600;
+  for (int update = 0; update < 200; update++) {
+    step(update, true);
+  }
+  allocations = 0;
+  for (int update = 200; update < steadyUpdates; update++) {
+    step(update, true);
+  }
+  host::advance(100);
+  std::uint32_t steadyBytes = telemetry->getBytesWritten();
+  check("every frame was written", telemetry->getDroppedFrames() == 0 && telemetry->getSamples() == steadyUpdates);
+  check("sampling did not allocate", allocations == 0);
+
+  Collector steady;
+  std::vector<std::uint8_t> data = readFile(stream);
+  steady.feed(data.data(), data.size());
+  const std::vector<TelemetryChannelInfo>& channels = steady.getChannels();
+  check("the layout names every channel", channels.size() == 8 && channels[0].name == "updateMicros" &&
+                                              channels[4].kind == TelemetryChannelKind::ActiveCommand &&
+                                              channels[7].name == "battery" && channels[7].scale == 100);
+  check("every update was read back as it was sampled",
+        steady.rows.size() == size_t(steadyUpdates) && allMatch(steady, expected) && steady.getBadFrames() == 0);
+  bool sawTurn = false, sawNudge = false, sawTime = false;
+  for (const auto& row : steady.rows) {
+    sawTurn |= row.second[4] == 2;
+    sawNudge |= row.second[5] == -1;
+    sawTime |= row.second[0] > 0;
+  }
+  check("it saw commands it was and was not told about", sawTurn && sawNudge && sawTime);
+
+  // A burst of updates with no chance to write fills the buffer, and frames are dropped until it is written out
+  busy = false;
+  for (int update = steadyUpdates; update < steadyUpdates + 1000; update++) {
+    step(update, false);
+  }
+  std::uint32_t dropped = telemetry->getDroppedFrames();
+  busy = true;
+  const int totalUpdates = steadyUpdates + 1200;
+  for (int update = steadyUpdates + 1000; update < totalUpdates; update++) {
+    step(update, true);
+  }
+  host::advance(100);
+
+  Collector burst;
+  data = readFile(stream);
+  burst.feed(data.data(), data.size());
+  dropped = telemetry->getDroppedFrames(); // Including keyframes dropped until the writer task next ran
+  std::printf("burst: %u frames dropped, %u samples skipped by the reader after the gap\n", dropped,
+              burst.getSkippedSamples());
+  check("frames that did not fit were dropped and counted", dropped > 0);
+  check("every update read after the gap is right", allMatch(burst, expected) && burst.getBadFrames() == 0);
+  check("the stream picked up again at the next keyframe",
+        burst.rows.rbegin()->first == std::uint32_t(totalUpdates - 1) &&
+            burst.rows.size() + dropped + burst.getSkippedSamples() <= size_t(totalUpdates) &&
+            burst.rows.size() >= size_t(totalUpdates) - dropped - LIBITERATIVEROBOT_TELEMETRY_KEYFRAME);
+
+  // printf() text mixed into the stream, and a damaged byte, only lose the frames they land in
+  std::vector<std::uint8_t> noisy;
+  const char* text = "printed by the robot program\n";
+  size_t frames = 0;
+  for (size_t i = 0; i < data.size(); i++) {
+    noisy.push_back(i == data.size() / 3 ? data[i] ^ 0x5a : data[i]);
+    if (data[i] == 0 && ++frames % 97 == 0) {
+      noisy.insert(noisy.end(), text, text + std::strlen(text));
+    }
+  }
+  Collector damaged;
+  damaged.feed(noisy.data(), noisy.size());
+  std::printf("damaged: %u of %u frames skipped, %zu of %zu updates read\n", damaged.getBadFrames(),
+              damaged.getFrames(), damaged.rows.size(), burst.rows.size());
+  check("damaged frames were skipped without a wrong row",
+        damaged.getBadFrames() > 0 && allMatch(damaged, expected) && damaged.rows.size() > burst.rows.size() / 2);
+
+  // A reader that starts partway through waits for a layout and a keyframe
+  Collector joined;
+  joined.feed(data.data() + data.size() / 2, data.size() - data.size() / 2);
+  check("a reader joining partway through picked up correctly",
+        !joined.rows.empty() && allMatch(joined, expected) &&
+            joined.rows.rbegin()->first == std::uint32_t(totalUpdates - 1));
+
+  // The CSV has a header and a row for each update read, with Commands and Statuses by name
+  FILE* csvFile = std::tmpfile();
+  TelemetryCsv csv(csvFile);
+  csv.feed(data.data(), data.size());
+  std::vector<std::uint8_t> csvData = readFile(csvFile);
+  std::string csvText(csvData.begin(), csvData.end());
+  size_t lines = 0;
+  for (char c : csvText) {
+    lines += c == '\n';
+  }
+  std::vector<std::int64_t>& sample = expected[60];
+  char turnRow[128];
+  std::snprintf(turnRow, sizeof(turnRow), "\n60,%lld,Blocked,Running,Idle,turn,,%.6g,%.6g\n", (long long)sample[0],
+                sample[6] / 1000.0, sample[7] / 100.0);
+  std::string header = "update,updateMicros,driveDefault,turn,lift,drive,arm,armAngle,battery\n";
+  check("the CSV has a row for every update read",
+        csvText.compare(0, header.size(), header) == 0 && lines == burst.rows.size() + 1);
+  check("the CSV names statuses and commands", csvText.find(turnRow) != std::string::npos);
+  std::fclose(csvFile);
+
+  std::printf("%u bytes for %d updates: %.1f bytes per update, %.1f per update with printf()\n", steadyBytes,
+              steadyUpdates, double(steadyBytes) / steadyUpdates, double(printfBytes) / totalUpdates);
+  check("frames are under half the size of printf() lines",
+        double(steadyBytes) / steadyUpdates < double(printfBytes) / totalUpdates / 2);
+
+  // What sampling adds to an update, timed on the host with the writer task never running
+  busy = false;
+  double nanos[2];
+  for (int attached = 0; attached < 2; attached++) {
+    scheduler->setTelemetry(attached ? telemetry : NULL);
+    auto begin = std::chrono::steady_clock::now();
+    for (int update = 0; update < 20000; update++) {
+      scheduler->update();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    nanos[attached] = std::chrono::duration<double, std::nano>(elapsed).count() / 20000;
+  }
+  std::printf("an update took %.0f ns, or %.0f ns while sampling\n", nanos[0], nanos[1]);
+  std::fclose(stream);
+  return bench::status();
+}
@@ -0,0 +1,199 @@
+/**
+ * Checks the events the Tracer records for an autonomous routine that is interrupted by a higher priority Command.
+ *
+ * A CommandGroup drives, then drives and moves an arm in parallel, then drives again. While it is in its second step, a
+ * trigger runs a higher priority Command on the drive, which interrupts the group's drive Command. That interrupts the
+ * group, which stops the arm Command. The program checks that the trace shows this cascade in order, that every span
+ * it records is closed, that objects keep their names once destroyed or once the name ids run out, and that the ring
+ * buffer drops the oldest events once it is full. Given a file name, it also writes the trace of the routine there, for
+ * tools/traceToChrome. It exits with a non-zero status if any check fails.
+ * Built with tracing enabled and run by host.mk (make host-bench, make host-trace).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/commands/CommandGroup.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Tracer.h"
+#include "libIterativeRobot/events/Trigger.h"
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+class BenchSubsystem : public Subsystem {
+  public:
+    void initDefaultCommand() {}
+};
+
+// Runs for a number of ticks, spending some simulated time in each execute()
+class TimedCommand : public Command {
+  private:
+    int ticks;
+    int remaining = 0;
+  public:
+    TimedCommand(Subsystem* subsystem, int priority, int ticks) : ticks(ticks) {
+      addRequirement(subsystem);
+      this->priority = priority;
+    }
+    bool canRun() { return true; }
+    void initialize() { remaining = ticks; }
+    void execute() { remaining--; host::advanceMicros(300); }
+    bool isFinished() { return remaining <= 0; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class Routine : public CommandGroup {
+  public:
+    Routine(Command* drive1, Command* arm, Command* drive2, Command* drive3) {
+      addSequentialCommand(drive1);
+      addSequentialCommand(arm);
+      addParallelCommand(drive2);
+      addSequentialCommand(drive3);
+    }
+};
+
+class FlagTrigger : public Trigger {
+  public:
+    bool flag = false;
+    bool getState() { return flag; }
+    using Trigger::whenActivated;
+};
+
+// Finds the first event of a type about an object at or after an index, or returns -1
+int find(TraceEventType type, std::uint16_t object, int from = 0) {
+  Tracer* tracer = Tracer::getInstance();
+  for (std::uint32_t i = from < 0 ? tracer->getEventCount() : std::uint32_t(from); i < tracer->getEventCount(); i++) {
+    TraceEvent event = tracer->getEvent(i);
+    if (event.type == std::uint8_t(type) && event.object == object) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Dumps the trace to a temporary file and reads back the name given to each name id
+std::map<std::uint16_t, std::string> dumpNames() {
+  std::map<std::uint16_t, std::string> names;
+  FILE* file = std::tmpfile();
+  if (file == NULL || !Tracer::getInstance()->dump(file)) {
+    return names;
+  }
+  std::rewind(file);
+  TraceFileHeader header;
+  bool read = std::fread(&header, sizeof(header), 1, file) == 1;
+  for (std::uint16_t i = 0; read && i < header.nameCount; i++) {
+    TraceName name;
+    read = std::fread(&name, sizeof(name), 1, file) == 1;
+    std::string text(read ? name.length : 0, '\0');
+    read = read && std::fread(&text[0], 1, text.size(), file) == text.size();
+    names[name.object] = text;
+  }
+  std::fclose(file);
+  return names;
+}
+
+}
+
+int main(int argc, char** argv) {
+  Tracer* tracer = Tracer::getInstance();
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  BenchSubsystem drive, arm;
+  TimedCommand drive1(&drive, 1, 3), armMove(&arm, 1, 6), drive2(&drive, 1, 6), drive3(&drive, 1, 3);
+  TimedCommand override(&drive, 5, 2);
+  Routine routine(&drive1, &armMove, &drive2, &drive3);
+  FlagTrigger trigger;
+  trigger.whenActivated(&override);
+
+  routine.run();
+  for (int tick = 0; tick < 12; tick++) {
+    trigger.flag = tick >= 5;
+    scheduler->update();
+    host::advance(10);
+  }
+
+  std::uint16_t routineId = tracer->of(&routine), armId = tracer->of(&armMove), drive2Id = tracer->of(&drive2);
+  std::uint16_t overrideId = tracer->of(&override), triggerId = tracer->of(&trigger);
+  int fired = find(TraceEventType::ListenerFired, triggerId);
+  int overrideStarted = find(TraceEventType::CommandInitialized, overrideId);
+  int driveInterrupted = find(TraceEventType::CommandInterrupted, drive2Id);
+  int routineInterrupted = find(TraceEventType::CommandInterrupted, routineId);
+  int armInterrupted = find(TraceEventType::CommandInterrupted, armId);
+
+  check("routine moved on to its second step", find(TraceEventType::GroupStepAdvanced, routineId) >= 0);
+  check("trigger fired before the override was queued",
+        fired >= 0 && find(TraceEventType::CommandQueued, overrideId) > fired);
+  check("override interrupted the routine's drive command", overrideStarted >= 0 && driveInterrupted >= 0);
+  check("drive interruption interrupted the routine", routineInterrupted > driveInterrupted);
+  check("routine interruption stopped the arm", armInterrupted > routineInterrupted);
+  check("routine never reached its third step", find(TraceEventType::CommandInitialized, tracer->of(&drive3)) < 0);
+
+  // Every update and execute() span is closed, and timestamps never go backwards
+  int updates = 0, executes = 0;
+  bool ordered = true;
+  for (std::uint32_t i = 0; i < tracer->getEventCount(); i++) {
+    TraceEvent event = tracer->getEvent(i);
+    updates += event.type == std::uint8_t(TraceEventType::UpdateBegin) ? 1 :
+               event.type == std::uint8_t(TraceEventType::UpdateEnd) ? -1 : 0;
+    executes += event.type == std::uint8_t(TraceEventType::ExecuteBegin) ? 1 :
+                event.type == std::uint8_t(TraceEventType::ExecuteEnd) ? -1 : 0;
+    ordered &= i == 0 || event.micros >= tracer->getEvent(i - 1).micros;
+  }
+  check("every update span is closed", updates == 0);
+  check("every execute span is closed", executes == 0);
+  check("timestamps are in order", ordered);
+  check("nothing was dropped", tracer->getDropped() == 0);
+
+  if (argc > 1) {
+    FILE* file = std::fopen(argv[1], "wb");
+    bool written = file != NULL && tracer->dump(file);
+    written &= file != NULL && std::fclose(file) == 0;
+    check("trace written", written);
+  }
+
+  // A traced object can be destroyed before the trace is dumped
+  std::unique_ptr<TimedCommand> destroyed(new TimedCommand(&arm, 1, 1));
+  std::uint16_t destroyedId = tracer->of(destroyed.get());
+  tracer->record(TraceEventType::CommandQueued, destroyed.get());
+  destroyed.reset();
+  std::map<std::uint16_t, std::string> names = dumpNames();
+  check("a destroyed object keeps its name", names[destroyedId].find("TimedCommand") != std::string::npos);
+
+  // Once every name id is given out, later objects share TraceOverflowObject, and keep it
+  std::vector<std::unique_ptr<TimedCommand>> many;
+  while (many.empty() || tracer->of(many.back().get()) != TraceOverflowObject) {
+    many.emplace_back(new TimedCommand(&arm, 1, 1));
+  }
+  TimedCommand late(&arm, 1, 1);
+  check("name ids run out at LIBITERATIVEROBOT_TRACE_OBJECTS",
+        tracer->of(many[many.size() - 2].get()) == LIBITERATIVEROBOT_TRACE_OBJECTS);
+  check("later objects share the overflow id",
+        tracer->of(&late) == TraceOverflowObject && tracer->of(many.back().get()) == TraceOverflowObject);
+  check("named objects keep their name ids", tracer->of(&routine) == routineId);
+  names = dumpNames();
+  check("the overflow id is named", names.count(TraceOverflowObject) == 1 && names.count(0) == 0);
+
+  // Once the buffer is full, the oldest events are overwritten
+  tracer->clear();
+  const std::uint32_t extra = 10;
+  for (std::uint32_t i = 0; i < LIBITERATIVEROBOT_TRACE_CAPACITY + extra; i++) {
+    tracer->record(TraceEventType::UpdateBegin);
+    host::advanceMicros(1);
+  }
+  check("a full buffer holds its capacity", tracer->getEventCount() == LIBITERATIVEROBOT_TRACE_CAPACITY);
+  check("a full buffer counts what it dropped", tracer->getDropped() == extra);
+  check("a full buffer keeps the newest events",
+        tracer->getEvent(LIBITERATIVEROBOT_TRACE_CAPACITY - 1).micros - tracer->getEvent(0).micros ==
+            LIBITERATIVEROBOT_TRACE_CAPACITY - 1);
+  tracer->setEnabled(false);
+  tracer->record(TraceEventType::UpdateBegin);
+  check("nothing is recorded while disabled", tracer->getDropped() == extra);
+  return bench::status();
+}
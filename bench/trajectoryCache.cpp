@@ -0,0 +1,248 @@
+/**
+ * Checks the TrajectoryGenerator, the TrajectoryCache and FollowTrajectory.
+ *
+ * Three paths are generated the way tools/generatePaths would generate them. Two are saved to files and added to the
+ * TrajectoryCache by path, and one is added from memory, the way an array compiled into flash would be. The program
+ * checks that each generated trajectory starts and ends at rest on its first and last waypoints and keeps to its
+ * velocity and acceleration limits. It checks that nothing is read from a file until a FollowTrajectory first runs,
+ * that what is read matches what was generated, and that a missing or damaged trajectory blocks the Command without
+ * being read again on every update. A FollowTrajectory then drives a simulated drivetrain along each path, and the
+ * program checks that it ends up at the last waypoint and that the wheels are stopped when it finishes or is
+ * interrupted. It prints the time taken to generate the paths and to load them, and their size. It exits with a
+ * non-zero status if any check fails. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/commands/FollowTrajectory.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/paths/TrajectoryCache.h"
+#include "libIterativeRobot/paths/TrajectoryGenerator.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const double track = 12;
+const int updateMillis = 10;
+const TrajectoryConstraints constraints = {48, 96, track, updateMillis};
+
+struct PathDefinition {
+  const char* name;
+  std::vector<Waypoint> waypoints;
+};
+
+// A drivetrain whose wheels turn at exactly the velocities they are set to
+class Drive : public Subsystem {
+  public:
+    double left = 0, right = 0;
+    double x = 0, y = 0, theta = 0;
+
+    void initDefaultCommand() {}
+
+    void moveFor(int milliseconds) {
+      for (int i = 0; i < milliseconds; i++) {
+        double turn = (right - left) / 1000 / track;
+        double heading = theta + turn / 2;
+        x += (left + right) / 2000 * std::cos(heading);
+        y += (left + right) / 2000 * std::sin(heading);
+        theta += turn;
+      }
+    }
+
+    void place(const Waypoint& waypoint) {
+      x = waypoint.x;
+      y = waypoint.y;
+      theta = waypoint.heading;
+    }
+};
+
+class Follow : public FollowTrajectory {
+  private:
+    Drive* drive;
+  protected:
+    void follow(const TrajectorySample& sample) {
+      drive->left = sample.leftVelocity;
+      drive->right = sample.rightVelocity;
+    }
+  public:
+    int blocks = 0;
+    bool finished = false;
+    Follow(Drive* drive, const char* name) : FollowTrajectory(drive, name), drive(drive) {}
+    void end() {
+      FollowTrajectory::end();
+      finished = true;
+    }
+    void blocked() {
+      blocks++;
+    }
+};
+
+void update(Drive& drive) {
+  EventScheduler::getInstance()->update();
+  host::advance(updateMillis);
+  drive.moveFor(updateMillis);
+}
+
+// Checks that a trajectory starts and ends at rest at its ends and keeps to its limits
+bool withinLimits(const Trajectory& trajectory, const std::vector<Waypoint>& waypoints) {
+  TrajectorySample first = trajectory.getSample(0);
+  TrajectorySample last = trajectory.getSample(trajectory.getSampleCount() - 1);
+  bool valid = std::hypot(first.x - waypoints.front().x, first.y - waypoints.front().y) < 0.05 &&
+               std::hypot(last.x - waypoints.back().x, last.y - waypoints.back().y) < 0.05 &&
+               first.leftVelocity == 0 && first.rightVelocity == 0 && last.leftVelocity == 0 &&
+               last.rightVelocity == 0;
+  double period = trajectory.getPeriod() / 1000.0;
+  double previous = 0;
+  for (size_t i = 0; i < trajectory.getSampleCount(); i++) {
+    TrajectorySample sample = trajectory.getSample(i);
+    double velocity = (sample.leftVelocity + sample.rightVelocity) / 2;
+    valid &= std::fabs(sample.leftVelocity) <= constraints.maxVelocity + 0.01 &&
+             std::fabs(sample.rightVelocity) <= constraints.maxVelocity + 0.01;
+    // The last sample is cut short, so it may stop a little harder
+    valid &= i + 1 == trajectory.getSampleCount() ||
+             std::fabs(velocity - previous) <= constraints.maxAcceleration * period * 1.05 + 0.02;
+    previous = velocity;
+  }
+  return valid;
+}
+
+bool sameSamples(const Trajectory& a, const Trajectory& b) {
+  if (a.getSampleCount() != b.getSampleCount() || a.getPeriod() != b.getPeriod()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.getSampleCount(); i++) {
+    TrajectorySample x = a.getSample(i), y = b.getSample(i);
+    if (x.x != y.x || x.y != y.y || x.heading != y.heading || x.leftVelocity != y.leftVelocity ||
+        x.rightVelocity != y.rightVelocity) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool writeFile(const std::string& filename, const std::vector<std::uint8_t>& data, size_t size) {
+  FILE* file = std::fopen(filename.c_str(), "wb");
+  if (file == NULL) {
+    return false;
+  }
+  bool written = std::fwrite(data.data(), 1, size, file) == size;
+  return std::fclose(file) == 0 && written;
+}
+
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  const double right = M_PI / 2;
+  std::vector<PathDefinition> paths = {
+      {"toGoal", {{0, 0, 0}, {48, 24, right}, {48, 60, right}}},
+      {"scurve", {{0, 0, 0}, {36, 24, 0}, {72, 0, 0}}},
+      {"straight", {{0, 0, 0}, {60, 0, 0}}}};
+
+  // Generates every path, as tools/generatePaths would ahead of time
+  std::vector<std::vector<std::uint8_t>> generated(paths.size());
+  bool generatedAll = true;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < paths.size(); i++) {
+    generatedAll &= TrajectoryGenerator::generate(paths[i].waypoints.data(), paths[i].waypoints.size(), constraints,
+                                                  generated[i]);
+  }
+  double generateMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+  check("every path was generated", generatedAll);
+  bool limits = true;
+  size_t bytes = 0;
+  double seconds = 0;
+  for (size_t i = 0; i < paths.size(); i++) {
+    Trajectory trajectory;
+    limits &= trajectory.parse(generated[i].data(), generated[i].size()) && withinLimits(trajectory, paths[i].waypoints);
+    bytes += generated[i].size();
+    seconds += trajectory.getDuration() / 1000.0;
+  }
+  check("each starts and ends at rest and keeps to its limits", limits);
+  std::vector<Waypoint> tooFar = {{0, 0, 0}, {400, 0, 0}};
+  std::vector<std::uint8_t> unused;
+  check("a path outside the format's range was refused",
+        !TrajectoryGenerator::generate(tooFar.data(), tooFar.size(), constraints, unused));
+
+  // Two are saved to files and one is kept in memory, as if compiled into flash
+  std::string base(argv[0]);
+  std::string toGoalFile = base + ".toGoal.traj", scurveFile = base + ".scurve.traj";
+  std::string damagedFile = base + ".damaged.traj";
+  bool written = writeFile(toGoalFile, generated[0], generated[0].size()) &&
+                 writeFile(scurveFile, generated[1], generated[1].size()) &&
+                 writeFile(damagedFile, generated[1], generated[1].size() / 2);
+  TrajectoryCache* cache = TrajectoryCache::getInstance();
+  bool added = written && cache->addFile("toGoal", toGoalFile.c_str()) && cache->addFile("scurve", scurveFile.c_str()) &&
+               cache->addFile("damaged", damagedFile.c_str()) &&
+               cache->add("straight", generated[2].data(), generated[2].size());
+  check("trajectories were added to the cache", added && !cache->addFile("toGoal", toGoalFile.c_str()));
+  check("nothing was read until it was needed", cache->getFilesLoaded() == 0);
+
+  // Follows each path on the simulated drivetrain
+  Drive drive;
+  EventScheduler::getInstance()->initialize();
+  bool arrived = true, stopped = true, loadedOnRun = true;
+  double loadMicros = 0;
+  for (size_t i = 0; i < paths.size(); i++) {
+    Follow follow(&drive, paths[i].name);
+    drive.place(paths[i].waypoints.front());
+    std::uint32_t filesBefore = cache->getFilesLoaded();
+    begin = std::chrono::steady_clock::now();
+    follow.run();
+    update(drive);
+    loadMicros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    loadedOnRun &= cache->getFilesLoaded() == filesBefore + (i < 2 ? 1 : 0);
+    while (!follow.finished) {
+      update(drive);
+    }
+    const Waypoint& last = paths[i].waypoints.back();
+    std::printf("%-8s ended %.2f in and %.2f deg from its last waypoint\n", paths[i].name,
+                std::hypot(drive.x - last.x, drive.y - last.y), std::fabs(drive.theta - last.heading) * 180 / M_PI);
+    arrived &= std::hypot(drive.x - last.x, drive.y - last.y) < 1 && std::fabs(drive.theta - last.heading) < 0.05;
+    stopped &= drive.left == 0 && drive.right == 0;
+  }
+  check("each file was read the first time it was followed", loadedOnRun && cache->getFilesLoaded() == 2);
+  check("what was read matches what was generated", sameSamples(*cache->get("toGoal"), [&] {
+    Trajectory trajectory;
+    trajectory.parse(generated[0].data(), generated[0].size());
+    return trajectory;
+  }()));
+  check("the drivetrain ended on each last waypoint", arrived);
+  check("the wheels were stopped at the end", stopped);
+
+  // An interrupted FollowTrajectory stops the wheels
+  Follow interrupted(&drive, "scurve");
+  interrupted.run();
+  for (int i = 0; i < 20; i++) {
+    update(drive);
+  }
+  bool moving = drive.left != 0 && drive.right != 0;
+  interrupted.stop();
+  update(drive);
+  check("interrupting it stopped the wheels", moving && drive.left == 0 && drive.right == 0);
+
+  // A missing or damaged trajectory blocks the Command, and a damaged file is only read once
+  Follow missing(&drive, "nowhere"), damaged(&drive, "damaged");
+  missing.run();
+  damaged.run();
+  update(drive);
+  damaged.run();
+  update(drive);
+  check("a missing trajectory blocked the command", missing.blocks == 1);
+  check("a damaged file blocked it without being loaded", damaged.blocks == 2 && cache->getFilesLoaded() == 2 &&
+                                                              cache->get("damaged") == NULL);
+
+  std::printf("%zu paths, %.1f s of driving in %zu bytes (%.0f bytes/s)\n", paths.size(), seconds, bytes,
+              bytes / seconds);
+  std::printf("generating them took %.0f us, loading them from the cache %.0f us\n", generateMicros, loadMicros);
+  std::remove(toGoalFile.c_str());
+  std::remove(scurveFile.c_str());
+  std::remove(damagedFile.c_str());
+  return bench::status();
+}
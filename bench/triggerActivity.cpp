@@ -0,0 +1,174 @@
+/**
+ * Compares listener checks per tick for triggers that are polled on every update and triggers that are notified of
+ * changes.
+ *
+ * A driver setup binds many commands to presses and releases of the controller buttons, a few to buttons being held,
+ * and some to flags that are not read from a controller. The buttons are pressed and released on a fixed script. The
+ * setup runs once with JoystickButtons that are notified by their controller's snapshot, and once with JoystickButtons
+ * that ask to be polled on every update, each in its own process because the scheduler cannot forget listeners. Held
+ * buttons and flags are checked on every update either way. The program checks that both setups start the same
+ * commands, that polling checks every listener on every update, and that notified buttons are only checked on the
+ * updates where their button changed. It exits with a non-zero status if any check fails. Built and run by host.mk
+ * (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/JoystickButton.h"
+#include <chrono>
+#include <cstdio>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int ticks = 5000;
+const int numButtons = pros::E_CONTROLLER_DIGITAL_A - pros::E_CONTROLLER_DIGITAL_L1 + 1;
+const int edgeTriggersPerButton = 12;
+const int heldButtons = 4;
+const int numFlags = 16;
+
+int starts = 0;
+
+class CountingCommand : public Command {
+  public:
+    bool canRun() { return true; }
+    void initialize() { starts++; }
+    void execute() {}
+    bool isFinished() { return true; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+// A JoystickButton that is checked on every update, the way every trigger used to be
+class PolledButton : public JoystickButton {
+  public:
+    PolledButton(pros::Controller* controller, pros::controller_digital_e_t button) : JoystickButton(controller, button) {
+      setNotifiedOnChange(false);
+    }
+};
+
+bool flags[numFlags];
+
+// A trigger on something that does not notify it, so it is always checked
+class FlagTrigger : public Trigger {
+  private:
+    int flag;
+  public:
+    FlagTrigger(int flag) : flag(flag) {}
+    bool getState() { return flags[flag]; }
+    using Trigger::whenActivated;
+};
+
+// Whether a button is pressed on a tick of the script
+bool pressed(int button, int tick) {
+  return (tick / (10 + 3 * button)) % 2 == 1;
+}
+
+struct Result {
+  long checks;
+  long starts;
+  double nsPerTick;
+  int listeners;
+};
+
+Result measure(bool polled) {
+  pros::Controller master(pros::E_CONTROLLER_MASTER);
+  Result result = {0, 0, 0, 0};
+
+  for (int button = 0; button < numButtons; button++) {
+    pros::controller_digital_e_t id = pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button);
+    for (int i = 0; i < edgeTriggersPerButton; i++) {
+      JoystickButton* trigger = polled ? new PolledButton(&master, id) : new JoystickButton(&master, id);
+      if (i % 2 == 0) {
+        trigger->whenPressed(new CountingCommand());
+      } else {
+        trigger->whenReleased(new CountingCommand());
+      }
+    }
+    if (button < heldButtons) {
+      (new JoystickButton(&master, id))->whileHeld(new CountingCommand());
+    }
+  }
+  for (int flag = 0; flag < numFlags; flag++) {
+    (new FlagTrigger(flag))->whenActivated(new CountingCommand());
+  }
+
+  EventScheduler* scheduler = EventScheduler::getInstance();
+  result.listeners = scheduler->getListenerCount();
+  auto start = std::chrono::steady_clock::now();
+  for (int tick = 0; tick < ticks; tick++) {
+    for (int button = 0; button < numButtons; button++) {
+      host::setDigital(pros::E_CONTROLLER_MASTER, pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button),
+                       pressed(button, tick));
+    }
+    for (int flag = 0; flag < numFlags; flag++) {
+      flags[flag] = (tick / 40) % 2 == 1;
+    }
+    scheduler->update();
+    result.checks += scheduler->getListenerChecks();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  result.nsPerTick = std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+  result.starts = starts;
+  return result;
+}
+
+// Runs a setup in a child process, so that it starts with an empty scheduler
+bool runIsolated(bool polled, Result& result) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  pid_t child = fork();
+  if (child == 0) {
+    close(fds[0]);
+    Result measured = measure(polled);
+    bool written = write(fds[1], &measured, sizeof(measured)) == sizeof(measured);
+    _exit(written ? 0 : 1);
+  }
+  close(fds[1]);
+  bool received = child > 0 && read(fds[0], &result, sizeof(result)) == sizeof(result);
+  close(fds[0]);
+  int status = 0;
+  if (child > 0) {
+    waitpid(child, &status, 0);
+  }
+  return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+}
+
+int main() {
+  Result polled, notified;
+  if (!runIsolated(true, polled) || !runIsolated(false, notified)) {
+    std::printf("FAILED: a setup did not finish\n");
+    return 1;
+  }
+
+  // A notified button is checked once for each change of its button, which starts out released
+  long changes = 0;
+  for (int button = 0; button < numButtons; button++) {
+    for (int tick = 0; tick < ticks; tick++) {
+      if (pressed(button, tick) != (tick > 0 && pressed(button, tick - 1))) {
+        changes++;
+      }
+    }
+  }
+  long alwaysChecked = heldButtons + numFlags;
+  long expectedChecks = ticks * alwaysChecked + changes * edgeTriggersPerButton;
+
+  std::printf("%d listeners, %ld always checked\n", polled.listeners, alwaysChecked);
+  std::printf("%-12s %12s %12s\n", "setup", "checks/tick", "ns/tick");
+  std::printf("%-12s %12.1f %12.0f\n", "polled", double(polled.checks) / ticks, polled.nsPerTick);
+  std::printf("%-12s %12.1f %12.0f\n", "notified", double(notified.checks) / ticks, notified.nsPerTick);
+
+  check("commands started when notified", notified.starts, polled.starts);
+  check("checks when polled", polled.checks, long(ticks) * polled.listeners);
+  check("checks when notified", notified.checks, expectedChecks);
+  return bench::status();
+}
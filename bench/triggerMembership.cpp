@@ -0,0 +1,140 @@
+/**
+ * Host-side benchmark for scheduler membership checks driven by trigger-bound commands.
+ *
+ * Every whileActive binding calls run() on its command every tick, so with hundreds of held triggers the EventScheduler
+ * spends most of each update deciding whether commands are already in the scheduler. For increasing numbers of held
+ * triggers, with a mix of run and stop bindings, this benchmark compares the membership checks of one tick on the old
+ * path (std::find over the commandBuffer and the commandQueue for every run() and stop()) with the new path (reading
+ * the location each Command keeps), and then measures one full tick (listener checks plus update()) of the real
+ * EventScheduler. Built and run by host.mk (make host-bench).
+ */
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/events/Trigger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace libIterativeRobot;
+
+namespace {
+
+class HeldCommand : public Command {
+  public:
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() {}
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class HeldTrigger : public Trigger {
+  public:
+    bool getState() { return true; }
+    using Trigger::whileActive;
+};
+
+// Where a FakeCommand is, as Command::SchedulerLocation records it on the new path
+enum class FakeLocation { None, CommandBuffer, CommandQueue };
+
+struct FakeCommand {
+  FakeLocation location = FakeLocation::None;
+};
+
+// A held trigger's bindings: a command it keeps running, and maybe one it keeps stopped
+struct FakeBinding {
+  FakeCommand* run;
+  FakeCommand* stop;
+};
+
+// The membership checks of one tick on the old path. Returns the number of commands found in the scheduler
+size_t oldTick(std::vector<FakeBinding>& bindings, std::vector<FakeCommand*>& commandBuffer,
+               std::vector<FakeCommand*>& commandQueue) {
+  size_t found = 0;
+  auto inScheduler = [&](FakeCommand* command) {
+    bool inCommandBuffer = std::find(commandBuffer.begin(), commandBuffer.end(), command) != commandBuffer.end();
+    bool inCommandQueue = std::find(commandQueue.begin(), commandQueue.end(), command) != commandQueue.end();
+    return inCommandBuffer || inCommandQueue;
+  };
+  for (FakeBinding& binding : bindings) {
+    found += inScheduler(binding.run);
+    if (binding.stop != NULL) {
+      found += inScheduler(binding.stop);
+    }
+  }
+  return found;
+}
+
+// The same checks on the new path
+size_t newTick(std::vector<FakeBinding>& bindings) {
+  size_t found = 0;
+  auto inScheduler = [](FakeCommand* command) {
+    return command->location == FakeLocation::CommandBuffer || command->location == FakeLocation::CommandQueue;
+  };
+  for (FakeBinding& binding : bindings) {
+    found += inScheduler(binding.run);
+    if (binding.stop != NULL) {
+      found += inScheduler(binding.stop);
+    }
+  }
+  return found;
+}
+
+template <typename F>
+double nsPerTick(size_t ticks, F&& tick) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < ticks; i++) {
+    tick();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+}
+
+}
+
+int main() {
+  const size_t triggerCounts[] = {50, 100, 200, 400, 800};
+  const int ticks = 2000;
+  EventScheduler* scheduler = EventScheduler::getInstance();
+
+  std::vector<HeldTrigger*> triggers;
+  std::vector<FakeCommand> fakeCommands(2 * triggerCounts[4]);
+  std::vector<FakeBinding> bindings;
+  std::vector<FakeCommand*> commandBuffer, commandQueue; // Held commands are queued, so the buffer stays empty
+
+  std::printf("%10s %14s %14s %9s %14s\n", "triggers", "old ns/tick", "new ns/tick", "speedup", "update ns/tick");
+  for (size_t numTriggers : triggerCounts) {
+    // Every trigger holds one command running, and every fourth one also keeps another command stopped
+    while (triggers.size() < numTriggers) {
+      HeldTrigger* trigger = new HeldTrigger();
+      trigger->whileActive(new HeldCommand());
+      FakeBinding binding = {&fakeCommands[2 * triggers.size()], NULL};
+      binding.run->location = FakeLocation::CommandQueue;
+      commandQueue.push_back(binding.run);
+      if (triggers.size() % 4 == 0) {
+        trigger->whileActive(new HeldCommand(), Action::STOP);
+        binding.stop = &fakeCommands[2 * triggers.size() + 1];
+      }
+      triggers.push_back(trigger);
+      bindings.push_back(binding);
+    }
+
+    size_t oldFound = 0, newFound = 0;
+    double oldNs = nsPerTick(ticks, [&] { oldFound = oldTick(bindings, commandBuffer, commandQueue); });
+    double newNs = nsPerTick(ticks, [&] { newFound = newTick(bindings); });
+    if (oldFound != newFound) {
+      std::printf("Mismatch: old path found %zu commands, new path found %zu\n", oldFound, newFound);
+      return 1;
+    }
+
+    // Warm up until every held command is in the commandQueue
+    for (int tick = 0; tick < 10; tick++) {
+      scheduler->update();
+    }
+    double updateNs = nsPerTick(ticks, [&] { scheduler->update(); });
+    std::printf("%10zu %14.0f %14.0f %8.1fx %14.0f\n", numTriggers, oldNs, newNs, oldNs / newNs, updateNs);
+  }
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * Checks that CoalescedOutputs skip motor and ADI writes that would not change anything.
+ *
+ * Two drives are run side by side by default Commands that set their motors from the same joystick on every update.
+ * The ad hoc drive calls motor_move() each time, the way most default Commands do. The coalesced drive sets
+ * CoalescedMotors with an epsilon of 2, and a CoalescedADIOutput for its claw. The joystick is first held still with
+ * a little noise for ten seconds of 10 ms updates. The program checks that the coalesced drive only sends its first
+ * values and a refresh every LIBITERATIVEROBOT_OUTPUT_REFRESH milliseconds, and that every skipped write is counted.
+ * It then checks that a change past the epsilon, a change to zero within it, a change of move function and a call to
+ * refresh() are each sent on the update they happen, and that turning the refresh off leaves an unchanged value
+ * alone. It prints the motor writes each drive made while the joystick was still. It exits with a non-zero status if
+ * any check fails. Built and run by host.mk (make host-bench).
+ */
+#include "Check.h"
+#include "HostSim.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/subsystems/CoalescedADIOutput.h"
+#include "libIterativeRobot/subsystems/CoalescedMotor.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+using bench::check;
+
+namespace {
+
+const int stillUpdates = 1000;
+const int updateMillis = 10;
+
+// What the drivers are asking for
+int joystick = 0;
+bool velocityMode = false;
+bool clawClosed = true;
+
+template <typename Drive>
+class DriveWithJoystick : public Command {
+  private:
+    Drive* drive;
+  public:
+    DriveWithJoystick(Drive* drive) : drive(drive) {}
+    bool canRun() { return true; }
+    void initialize() {}
+    void execute() { drive->drive(joystick); }
+    bool isFinished() { return false; }
+    void end() {}
+    void interrupted() {}
+    void blocked() {}
+};
+
+class AdHocDrive : public Subsystem {
+  private:
+    DriveWithJoystick<AdHocDrive> defaultDrive{this};
+  public:
+    void initDefaultCommand() {
+      setDefaultCommand(&defaultDrive);
+    }
+    void drive(int power) {
+      pros::c::motor_move(3, power);
+      pros::c::motor_move(4, power);
+    }
+};
+
+class CoalescedDrive : public Subsystem {
+  private:
+    DriveWithJoystick<CoalescedDrive> defaultDrive{this};
+  public:
+    CoalescedMotor left{this, 1};
+    CoalescedMotor right{this, 2};
+    CoalescedADIOutput claw{this, 'A'};
+
+    CoalescedDrive() {
+      left.setEpsilon(2);
+      right.setEpsilon(2);
+    }
+    void initDefaultCommand() {
+      setDefaultCommand(&defaultDrive);
+    }
+    void drive(int power) {
+      if (velocityMode) {
+        left.moveVelocity(power);
+        right.moveVelocity(power);
+      } else {
+        left.move(power);
+        right.move(power);
+      }
+      claw.setValue(clawClosed);
+    }
+};
+
+// Runs one update and moves the clock to the next, returning the number of motor writes the update made
+std::size_t update() {
+  std::size_t writes = host::motorWrites();
+  EventScheduler::getInstance()->update();
+  host::advance(updateMillis);
+  return host::motorWrites() - writes;
+}
+
+}
+
+int main() {
+  AdHocDrive adHoc;
+  CoalescedDrive coalesced;
+  EventScheduler::getInstance()->initialize();
+
+  // A still joystick with a little noise
+  std::uint32_t leftWrites = coalesced.left.getWrites(), leftSkipped = coalesced.left.getSkipped();
+  std::size_t motorWrites = host::motorWrites(), adiWrites = host::adiWrites();
+  int lastSent = -1, longestGap = 0, refreshes = 0;
+  bool steady = true;
+  for (int i = 0; i < stillUpdates; i++) {
+    joystick = 50 + i % 3 - 1;
+    std::size_t writes = update();
+    // Each coalesced write is both sides at once, on top of the ad hoc drive's two
+    if (writes > 2) {
+      steady &= writes == 4;
+      if (lastSent >= 0) {
+        longestGap = i - lastSent > longestGap ? i - lastSent : longestGap;
+        refreshes++;
+      }
+      lastSent = i;
+    }
+  }
+  std::size_t totalMotorWrites = host::motorWrites() - motorWrites;
+  std::size_t coalescedWrites = totalMotorWrites - 2 * stillUpdates;
+  std::uint32_t saved = coalesced.left.getSkipped() - leftSkipped + coalesced.right.getSkipped();
+  std::printf("%d updates with a still joystick: %d motor writes ad hoc, %zu coalesced, %u saved\n", stillUpdates,
+              2 * stillUpdates, coalescedWrites, saved);
+  int expectedSends = 1 + (stillUpdates - 1) / (LIBITERATIVEROBOT_OUTPUT_REFRESH / updateMillis);
+  check("coalesced drive sent its first value and each refresh", coalescedWrites == std::size_t(2 * expectedSends));
+  check("both sides were sent together", steady);
+  check("refreshes were sent every refresh interval",
+        longestGap == LIBITERATIVEROBOT_OUTPUT_REFRESH / updateMillis && refreshes == expectedSends - 1);
+  check("the claw was sent as often as the motors", host::adiWrites() - adiWrites == std::size_t(expectedSends));
+  check("every update was either sent or counted as skipped",
+        coalesced.left.getWrites() - leftWrites + coalesced.left.getSkipped() - leftSkipped == stillUpdates);
+  check("the totals match the device writes",
+        CoalescedOutput::getTotalWrites() == host::motorWrites() - 2 * stillUpdates + host::adiWrites() &&
+            CoalescedOutput::getTotalSkipped() == saved + coalesced.claw.getSkipped());
+
+  // Changes that matter are sent on the update they happen
+  joystick = 80;
+  update();
+  check("a change past the epsilon was sent", host::motorValue(1) == 80 && host::motorValue(2) == 80);
+  joystick = 1;
+  update();
+  joystick = 0;
+  update();
+  check("a change to zero within the epsilon was sent", host::motorValue(1) == 0);
+  velocityMode = true;
+  check("a change of move function was sent", update() == 4);
+  clawClosed = false;
+  update();
+  check("opening the claw was sent", host::adiValue('A') == 0);
+
+  // With the refresh off, an unchanged value is left alone until refresh() is called
+  coalesced.left.setRefreshInterval(0);
+  coalesced.right.setRefreshInterval(0);
+  std::size_t writes = 0;
+  for (int i = 0; i < stillUpdates; i++) {
+    writes += update();
+  }
+  check("an unchanged value was never sent again", writes == std::size_t(2 * stillUpdates));
+  coalesced.left.refresh();
+  check("refresh() sent it on the next update", update() == 3 && update() == 2);
+  return bench::status();
+}
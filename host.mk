@@ -0,0 +1,144 @@
+################################################################################
+# Builds libIterativeRobot for the host machine against the PROS stand-in in
+# host/, so the scheduler can be run, benchmarked and checked without a brain.
+#
+#   make host              builds the library, the stand-in and the benchmarks
+#   make host-bench        builds and runs every benchmark, failing if any fails
+#   make host-bench-compare  runs the scheduler suite against this machine's baseline
+#   make host-trace        writes a scheduler trace to bin/host/trace.json
+#   make -f host.mk baseline replaces the baseline with a fresh run
+#   make -f host.mk clean  removes the host build
+#
+# PROFILE=1 builds everything with LIBITERATIVEROBOT_PROFILE and
+# LIBITERATIVEROBOT_TRACE defined into a separate directory, along with the
+# benchmarks that need them. STATIC=1 does the same with
+# LIBITERATIVEROBOT_STATIC. make host-bench also builds and runs both.
+################################################################################
+ROOT=.
+SRCDIR=$(ROOT)/src
+INCDIR=$(ROOT)/include
+HOSTDIR=$(ROOT)/host
+BENCHDIR=$(ROOT)/bench
+TOOLDIR=$(ROOT)/tools
+BINDIR=$(ROOT)/bin/host
+LIBNAME:=libIterativeRobot
+
+HOSTCXX?=g++
+HOSTCXXFLAGS=-std=gnu++17 -O2 -g -Wall -pthread -MMD -MP
+HOSTLDFLAGS=-pthread
+
+# Robot.cpp and the example files belong to the user's project, not the library
+LIB_SRC=$(filter-out $(SRCDIR)/$(LIBNAME)/Robot.cpp, $(wildcard $(SRCDIR)/$(LIBNAME)/*.cpp $(SRCDIR)/$(LIBNAME)/*/*.cpp))
+STANDIN_SRC=$(wildcard $(HOSTDIR)/src/*.cpp)
+BENCH_SRC=$(filter-out $(BENCHDIR)/AllocationCounter.cpp $(PROFILE_BENCH_SRC) $(STATIC_BENCH_SRC), $(wildcard $(BENCHDIR)/*.cpp))
+TOOL_SRC=$(wildcard $(TOOLDIR)/*.cpp)
+
+# Benchmarks that only build with profiling and tracing enabled
+PROFILE_BENCH_SRC=$(BENCHDIR)/profiler.cpp $(BENCHDIR)/tracing.cpp
+
+# Benchmarks that only build with every container's capacity fixed
+STATIC_BENCH_SRC=$(BENCHDIR)/staticStorage.cpp
+
+# Benchmarks that use C++20 features, such as CoroutineCommand, and are compiled as gnu++20 against the gnu++17 library
+CXX20_BENCH_SRC=$(BENCHDIR)/coroutineCommand.cpp
+
+ifeq ($(PROFILE),1)
+BINDIR=$(ROOT)/bin/host/profile
+HOSTCXXFLAGS+=-DLIBITERATIVEROBOT_PROFILE -DLIBITERATIVEROBOT_TRACE
+BENCH_SRC=$(PROFILE_BENCH_SRC)
+TOOL_SRC=
+endif
+
+ifeq ($(STATIC),1)
+BINDIR=$(ROOT)/bin/host/static
+HOSTCXXFLAGS+=-DLIBITERATIVEROBOT_STATIC
+BENCH_SRC=$(STATIC_BENCH_SRC)
+TOOL_SRC=
+endif
+
+LIB_OBJ=$(patsubst $(ROOT)/%.cpp, $(BINDIR)/obj/%.o, $(LIB_SRC))
+STANDIN_OBJ=$(patsubst $(ROOT)/%.cpp, $(BINDIR)/obj/%.o, $(STANDIN_SRC))
+BENCH_BIN=$(patsubst $(BENCHDIR)/%.cpp, $(BINDIR)/bench/%, $(BENCH_SRC))
+TOOL_BIN=$(patsubst $(TOOLDIR)/%.cpp, $(BINDIR)/tools/%, $(TOOL_SRC))
+ALLOCATION_COUNTER=$(BINDIR)/obj/bench/AllocationCounter.o
+
+.PHONY: all bench compare baseline trace clean
+.SECONDARY:
+.DEFAULT_GOAL=all
+
+all: $(BINDIR)/$(LIBNAME).a $(BINDIR)/libprosHost.a $(BENCH_BIN) $(TOOL_BIN)
+
+bench: all
+	@for program in $(BENCH_BIN); do \
+		echo "== $$program"; \
+		$$program || { echo "$$program failed"; exit 1; }; \
+	done
+ifeq ($(PROFILE)$(STATIC),)
+	$(MAKE) -f host.mk PROFILE=1 bench
+	$(MAKE) -f host.mk STATIC=1 bench
+	$(MAKE) -f host.mk trace
+endif
+
+# Timings depend on the machine, so the baseline is not stored with the sources. It is written by the first compare on
+# each machine, and only replaced by make -f host.mk baseline, so it should be taken before the change being measured.
+# Only an increase in allocations fails the comparison; pass SUITE_TOLERANCE=0.5 to also fail on ticks 50% slower.
+SUITE_BASELINE=$(BINDIR)/baseline/schedulerSuite.json
+SUITE_TOLERANCE?=
+
+compare: $(BINDIR)/bench/schedulerSuite | $(SUITE_BASELINE)
+	$< --json $(BINDIR)/schedulerSuite.json --baseline $(SUITE_BASELINE) $(if $(SUITE_TOLERANCE),--tolerance $(SUITE_TOLERANCE))
+
+$(SUITE_BASELINE): | $(BINDIR)/bench/schedulerSuite
+	@mkdir -p $(dir $@)
+	@echo "No baseline for this machine yet, writing $@"
+	$(BINDIR)/bench/schedulerSuite --json $@
+
+baseline: $(BINDIR)/bench/schedulerSuite
+	@mkdir -p $(dir $(SUITE_BASELINE))
+	$< --json $(SUITE_BASELINE)
+
+# Traces the routine in bench/tracing.cpp and converts it for chrome://tracing or Perfetto
+trace: $(BINDIR)/tools/traceToChrome
+	$(MAKE) -f host.mk PROFILE=1 all
+	$(ROOT)/bin/host/profile/bench/tracing $(BINDIR)/trace.bin
+	$< $(BINDIR)/trace.bin $(BINDIR)/trace.json
+
+clean:
+	rm -rf $(BINDIR)
+
+$(BINDIR)/$(LIBNAME).a: $(LIB_OBJ)
+	ar rcs $@ $^
+
+$(BINDIR)/libprosHost.a: $(STANDIN_OBJ)
+	ar rcs $@ $^
+
+# Library sources get the same per-directory include path as in common.mk
+$(BINDIR)/obj/src/%.o: $(SRCDIR)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) -c -iquote$(INCDIR) -iquote$(INCDIR)/$(dir $*) $(HOSTCXXFLAGS) -o $@ $<
+
+$(BINDIR)/obj/host/%.o: $(HOSTDIR)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) -c -iquote$(INCDIR) -iquote$(HOSTDIR)/include $(HOSTCXXFLAGS) -o $@ $<
+
+$(patsubst $(BENCHDIR)/%.cpp, $(BINDIR)/obj/bench/%.o, $(CXX20_BENCH_SRC)): HOSTCXXFLAGS+=-std=gnu++20
+
+$(BINDIR)/obj/bench/%.o: $(BENCHDIR)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) -c -iquote$(INCDIR) -iquote$(INCDIR)/$(LIBNAME) -iquote$(HOSTDIR)/include $(HOSTCXXFLAGS) -o $@ $<
+
+$(BINDIR)/obj/tools/%.o: $(TOOLDIR)/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) -c -iquote$(INCDIR) $(HOSTCXXFLAGS) -o $@ $<
+
+# Tools link against the library for the parts of it that do not depend on PROS, such as TrajectoryGenerator
+$(BINDIR)/tools/%: $(BINDIR)/obj/tools/%.o $(BINDIR)/$(LIBNAME).a
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(HOSTLDFLAGS) -o $@ $< $(BINDIR)/$(LIBNAME).a
+
+$(BINDIR)/bench/%: $(BINDIR)/obj/bench/%.o $(ALLOCATION_COUNTER) $(BINDIR)/$(LIBNAME).a $(BINDIR)/libprosHost.a
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(HOSTLDFLAGS) -o $@ $< $(ALLOCATION_COUNTER) $(BINDIR)/$(LIBNAME).a $(BINDIR)/libprosHost.a
+
+-include $(LIB_OBJ:.o=.d) $(STANDIN_OBJ:.o=.d) $(patsubst $(BINDIR)/bench/%, $(BINDIR)/obj/bench/%.d, $(BENCH_BIN))
+-include $(patsubst $(BINDIR)/tools/%, $(BINDIR)/obj/tools/%.d, $(TOOL_BIN))
@@ -0,0 +1,115 @@
+#ifndef _HOST_HOSTSIM_H_
+#define _HOST_HOSTSIM_H_
+
+#include "api.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Controls the PROS stand-in used when libIterativeRobot is built for the host machine with host.mk.
+ *
+ * The stand-in implements the parts of the PROS API the library uses on top of a simulated clock. Time only moves
+ * when the program driving the simulation advances it, either with advance() or by calling pros::delay() from outside
+ * of a pros::Task. Tasks run one at a time, like they would on the brain's single core: each one runs until it
+ * delays, and tasks that wake at the same time run in order of priority and then of how long they have waited. Given
+ * the same inputs, a simulation always runs the same way, no matter how fast the host machine is.
+ */
+namespace host {
+  /**
+   * @brief Gets the simulated time
+   * @return The number of microseconds since the simulation started
+   */
+  std::uint64_t micros();
+
+  /**
+   * @brief Moves the simulated clock forward
+   *
+   * Every task that wakes up during the interval runs until it delays again, in the order it wakes up. This must be
+   * called from outside of a pros::Task.
+   *
+   * @param milliseconds The number of milliseconds to advance the clock by
+   */
+  void advance(std::uint32_t milliseconds);
+
+  /**
+   * @brief Moves the simulated clock forward
+   * @param microseconds The number of microseconds to advance the clock by
+   */
+  void advanceMicros(std::uint64_t microseconds);
+
+  /**
+   * @brief Gets the number of tasks that have been created and have not returned
+   * @return The number of live tasks
+   */
+  std::size_t taskCount();
+
+  /**
+   * @brief Sets the state of a controller button
+   * @param id The controller the button is on
+   * @param button The button to set
+   * @param pressed Whether or not the button is pressed
+   */
+  void setDigital(pros::controller_id_e_t id, pros::controller_digital_e_t button, bool pressed);
+
+  /**
+   * @brief Sets the value of a controller joystick channel
+   * @param id The controller the channel is on
+   * @param channel The channel to set
+   * @param value The value of the channel, from -127 to 127
+   */
+  void setAnalog(pros::controller_id_e_t id, pros::controller_analog_e_t channel, std::int32_t value);
+
+  /**
+   * @brief Sets the competition control status
+   * @param status A mask of COMPETITION_DISABLED, COMPETITION_AUTONOMOUS and COMPETITION_CONNECTED
+   */
+  void setCompetitionStatus(std::uint8_t status);
+
+  /**
+   * @brief Gets the number of controller reads made through the PROS API
+   *
+   * Each call to get_digital() or get_analog() on a controller counts as one read, which on the brain would be one
+   * access to the controller's state.
+   *
+   * @return The number of controller reads since the simulation started
+   */
+  std::size_t controllerReads();
+
+  /**
+   * @brief Gets the number of commands sent to motors through the PROS API
+   *
+   * Each call to motor_move(), motor_move_velocity() or motor_move_voltage() counts as one write, which on the brain
+   * would be one device transaction.
+   *
+   * @return The number of motor writes since the simulation started
+   */
+  std::size_t motorWrites();
+
+  /**
+   * @brief Gets the last command sent to a motor
+   * @param port The V5 port number from 1-21
+   * @return The last value passed to any of the motor's move functions, or 0 if none has been
+   */
+  std::int32_t motorValue(std::uint8_t port);
+
+  /**
+   * @brief Gets the number of values written to ADI ports through the PROS API
+   * @return The number of calls to adi_port_set_value() since the simulation started
+   */
+  std::size_t adiWrites();
+
+  /**
+   * @brief Gets the last value written to an ADI port
+   * @param port The ADI port number (from 1-8, 'a'-'h', 'A'-'H')
+   * @return The last value written to the port, or 0 if none has been
+   */
+  std::int32_t adiValue(std::uint8_t port);
+
+  /**
+   * @brief Gets whether the serial driver would wrap what is written to stdout in COBS packets
+   * @return False once serctl() has been called with SERCTL_DISABLE_COBS, until it is called with SERCTL_ENABLE_COBS
+   */
+  bool serialCobs();
+}
+
+#endif // _HOST_HOSTSIM_H_
@@ -0,0 +1,219 @@
+#include "Kernel.h"
+#include "HostSim.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace host;
+
+struct kernel::SimTask {
+  void (*function)(void*);
+  void* parameters;
+  std::uint32_t priority;
+  std::size_t sequence;
+  const char* name;
+  std::uint64_t wakeTime;
+  bool finished;
+  bool removed;
+  std::uint32_t notification;
+  bool waitingForNotification;
+  std::condition_variable turn;
+};
+
+namespace {
+  // All of the kernel's state is allocated once and never freed, so that tasks still blocked when the program exits
+  // never touch destroyed objects
+  struct KernelState {
+    std::mutex lock;
+    std::condition_variable driverTurn;
+    std::vector<kernel::SimTask*> tasks;
+    kernel::SimTask* running = NULL;
+    std::uint64_t now = 0;
+    std::size_t sequence = 0;
+  };
+
+  KernelState& state() {
+    static KernelState* instance = new KernelState();
+    return *instance;
+  }
+
+  thread_local kernel::SimTask* self = NULL;
+
+  // Hands control back to the driver and waits until this task is run again
+  void yield(std::unique_lock<std::mutex>& lock) {
+    KernelState& kernel = state();
+    self->sequence = kernel.sequence++;
+    kernel.running = NULL;
+    kernel.driverTurn.notify_all();
+    self->turn.wait(lock, [&] { return kernel.running == self; });
+  }
+
+  void taskEntry(kernel::SimTask* task) {
+    KernelState& kernel = state();
+    {
+      std::unique_lock<std::mutex> lock(kernel.lock);
+      self = task;
+      task->turn.wait(lock, [&] { return kernel.running == task; });
+    }
+
+    task->function(task->parameters);
+
+    std::unique_lock<std::mutex> lock(kernel.lock);
+    task->finished = true;
+    kernel.running = NULL;
+    kernel.driverTurn.notify_all();
+  }
+
+  // Finds the next task to wake up no later than a given time. Ties go to the higher priority, then to the task that
+  // has waited the longest since it last ran
+  kernel::SimTask* nextTask(std::uint64_t limit) {
+    kernel::SimTask* next = NULL;
+    for (kernel::SimTask* task : state().tasks) {
+      if (task->finished || task->removed || task->wakeTime > limit) {
+        continue;
+      }
+      if (next == NULL || task->wakeTime < next->wakeTime ||
+          (task->wakeTime == next->wakeTime && task->priority > next->priority) ||
+          (task->wakeTime == next->wakeTime && task->priority == next->priority && task->sequence < next->sequence)) {
+        next = task;
+      }
+    }
+    return next;
+  }
+}
+
+kernel::SimTask* kernel::createTask(void (*function)(void*), void* parameters, std::uint32_t priority, const char* name) {
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+
+  SimTask* task = new SimTask();
+  task->function = function;
+  task->parameters = parameters;
+  task->priority = priority;
+  task->sequence = kernel.sequence++;
+  task->name = name;
+  task->wakeTime = kernel.now;
+  task->finished = false;
+  task->removed = false;
+  task->notification = 0;
+  task->waitingForNotification = false;
+  kernel.tasks.push_back(task);
+
+  std::thread(taskEntry, task).detach();
+  return task;
+}
+
+kernel::SimTask* kernel::currentTask() {
+  return self;
+}
+
+void kernel::delayMicros(std::uint64_t microseconds) {
+  if (self == NULL) {
+    advanceMicros(microseconds);
+    return;
+  }
+
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+  self->wakeTime = kernel.now + microseconds;
+  yield(lock);
+}
+
+void kernel::removeTask(SimTask* task) {
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+  task->removed = true;
+  if (task == self) {
+    // A task removing itself never runs again, so its thread stays blocked here for the rest of the program
+    yield(lock);
+  }
+}
+
+void kernel::notify(SimTask* task) {
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+  task->notification++;
+  if (task->waitingForNotification && task->wakeTime > kernel.now) {
+    task->wakeTime = kernel.now; // Runs as soon as the task that notified it delays, or the driver advances the clock
+  }
+}
+
+std::uint32_t kernel::notifyTake(bool clearOnExit, std::uint32_t timeout) {
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+  if (self != NULL && self->notification == 0 && timeout != 0) {
+    self->wakeTime = timeout == TIMEOUT_MAX ? UINT64_MAX : kernel.now + std::uint64_t(timeout) * 1000;
+    self->waitingForNotification = true;
+    yield(lock);
+    self->waitingForNotification = false;
+  }
+  SimTask* task = self;
+  if (task == NULL) {
+    return 0;
+  }
+  std::uint32_t value = task->notification;
+  if (value != 0) {
+    task->notification = clearOnExit ? 0 : value - 1;
+  }
+  return value;
+}
+
+std::uint32_t kernel::getPriority(SimTask* task) {
+  std::unique_lock<std::mutex> lock(state().lock);
+  return task->priority;
+}
+
+void kernel::setPriority(SimTask* task, std::uint32_t priority) {
+  std::unique_lock<std::mutex> lock(state().lock);
+  task->priority = priority;
+}
+
+std::uint32_t kernel::getState(SimTask* task) {
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+  if (task->finished || task->removed) {
+    return pros::E_TASK_STATE_DELETED;
+  }
+  if (kernel.running == task) {
+    return pros::E_TASK_STATE_RUNNING;
+  }
+  return task->wakeTime <= kernel.now ? pros::E_TASK_STATE_READY : pros::E_TASK_STATE_BLOCKED;
+}
+
+std::uint64_t host::micros() {
+  std::unique_lock<std::mutex> lock(state().lock);
+  return state().now;
+}
+
+void host::advance(std::uint32_t milliseconds) {
+  advanceMicros(std::uint64_t(milliseconds) * 1000);
+}
+
+void host::advanceMicros(std::uint64_t microseconds) {
+  KernelState& kernel = state();
+  std::unique_lock<std::mutex> lock(kernel.lock);
+  std::uint64_t target = kernel.now + microseconds;
+
+  // Runs each task that wakes up before the target time, one at a time, moving the clock to when it wakes up
+  while (kernel::SimTask* task = nextTask(target)) {
+    if (task->wakeTime > kernel.now) {
+      kernel.now = task->wakeTime;
+    }
+    kernel.running = task;
+    task->turn.notify_all();
+    kernel.driverTurn.wait(lock, [&] { return kernel.running == NULL; });
+  }
+  kernel.now = target;
+}
+
+std::size_t host::taskCount() {
+  std::unique_lock<std::mutex> lock(state().lock);
+  std::size_t count = 0;
+  for (kernel::SimTask* task : state().tasks) {
+    if (!task->finished && !task->removed) {
+      count++;
+    }
+  }
+  return count;
+}
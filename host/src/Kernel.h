@@ -0,0 +1,77 @@
+#ifndef _HOST_KERNEL_H_
+#define _HOST_KERNEL_H_
+
+#include <cstdint>
+
+/**
+ * The simulated kernel behind the PROS stand-in. Only the stand-in's own sources use this header; programs driving a
+ * simulation use HostSim.h.
+ */
+namespace host {
+  namespace kernel {
+    /**
+     * @brief A task created through the stand-in's task_create()
+     */
+    struct SimTask;
+
+    /**
+     * @brief Creates a task that starts running the next time the simulation runs tasks
+     * @return A handle to the task
+     */
+    SimTask* createTask(void (*function)(void*), void* parameters, std::uint32_t priority, const char* name);
+
+    /**
+     * @brief Gets the task that is currently running
+     * @return The current task, or NULL if called from outside of a task
+     */
+    SimTask* currentTask();
+
+    /**
+     * @brief Blocks the calling task for a length of simulated time
+     *
+     * Called from outside of a task, this advances the clock instead.
+     *
+     * @param microseconds The length of time to block for
+     */
+    void delayMicros(std::uint64_t microseconds);
+
+    /**
+     * @brief Stops a task from ever being woken up again
+     * @param task The task to remove
+     */
+    void removeTask(SimTask* task);
+
+    /**
+     * @brief Gets a task's priority
+     */
+    std::uint32_t getPriority(SimTask* task);
+
+    /**
+     * @brief Sets a task's priority
+     */
+    void setPriority(SimTask* task, std::uint32_t priority);
+
+    /**
+     * @brief Increments a task's notification value, waking it up if it is waiting for a notification
+     */
+    void notify(SimTask* task);
+
+    /**
+     * @brief Waits for the calling task's notification value to be nonzero, then clears or decrements it
+     *
+     * Called from outside of a task, this does not wait.
+     *
+     * @param clearOnExit Whether to clear the notification value instead of decrementing it
+     * @param timeout The longest time to wait for in milliseconds, or TIMEOUT_MAX to wait forever
+     * @return The notification value before it was cleared or decremented
+     */
+    std::uint32_t notifyTake(bool clearOnExit, std::uint32_t timeout);
+
+    /**
+     * @brief Gets the state of a task as a pros::task_state_e_t value
+     */
+    std::uint32_t getState(SimTask* task);
+  }
+}
+
+#endif // _HOST_KERNEL_H_
@@ -0,0 +1,48 @@
+#include "HostSim.h"
+#include <atomic>
+
+namespace {
+  // The last value written to each ADI port, and the number of values written to every port
+  std::atomic<std::int32_t> values[8];
+  std::atomic<std::size_t> writes(0);
+
+  // Turns 1-8, 'a'-'h' or 'A'-'H' into 0-7, or -1 for anything else
+  int index(std::uint8_t port) {
+    if (port >= 'a' && port <= 'h') {
+      return port - 'a';
+    }
+    if (port >= 'A' && port <= 'H') {
+      return port - 'A';
+    }
+    if (port >= 1 && port <= 8) {
+      return port - 1;
+    }
+    return -1;
+  }
+}
+
+namespace pros {
+namespace c {
+
+int32_t adi_port_set_value(uint8_t port, int32_t value) {
+  int i = index(port);
+  if (i < 0) {
+    errno = ENXIO;
+    return PROS_ERR;
+  }
+  writes++;
+  values[i] = value;
+  return 1;
+}
+
+}  // namespace c
+}  // namespace pros
+
+std::size_t host::adiWrites() {
+  return writes;
+}
+
+std::int32_t host::adiValue(std::uint8_t port) {
+  int i = index(port);
+  return i < 0 ? 0 : values[i].load();
+}
@@ -0,0 +1,103 @@
+#include "HostSim.h"
+#include "pros/misc.hpp"
+#include <atomic>
+
+namespace {
+  // The simulated controller state, set by the program driving the simulation and read by the robot code
+  struct ControllerState {
+    std::atomic<bool> digital[pros::E_CONTROLLER_DIGITAL_A + 1];
+    std::atomic<bool> newPress[pros::E_CONTROLLER_DIGITAL_A + 1];
+    std::atomic<std::int32_t> analog[pros::E_CONTROLLER_ANALOG_RIGHT_Y + 1];
+  };
+
+  ControllerState controllers[2];
+  std::atomic<std::uint8_t> competitionStatus(0);
+  std::atomic<std::size_t> reads(0);
+}
+
+namespace pros {
+namespace c {
+
+uint8_t competition_get_status(void) {
+  return competitionStatus;
+}
+
+int32_t controller_is_connected(controller_id_e_t id) {
+  return id == E_CONTROLLER_MASTER || id == E_CONTROLLER_PARTNER;
+}
+
+int32_t controller_get_analog(controller_id_e_t id, controller_analog_e_t channel) {
+  reads++;
+  return controllers[id].analog[channel];
+}
+
+int32_t controller_get_digital(controller_id_e_t id, controller_digital_e_t button) {
+  reads++;
+  return controllers[id].digital[button];
+}
+
+int32_t controller_get_digital_new_press(controller_id_e_t id, controller_digital_e_t button) {
+  reads++;
+  return controllers[id].newPress[button].exchange(false);
+}
+
+}  // namespace c
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected(void) {
+  return c::controller_is_connected(_id);
+}
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) {
+  return c::controller_get_analog(_id, channel);
+}
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) {
+  return c::controller_get_digital(_id, button);
+}
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+  return c::controller_get_digital_new_press(_id, button);
+}
+
+namespace competition {
+
+std::uint8_t get_status(void) {
+  return c::competition_get_status();
+}
+
+std::uint8_t is_autonomous(void) {
+  return (c::competition_get_status() & COMPETITION_AUTONOMOUS) != 0;
+}
+
+std::uint8_t is_connected(void) {
+  return (c::competition_get_status() & COMPETITION_CONNECTED) != 0;
+}
+
+std::uint8_t is_disabled(void) {
+  return (c::competition_get_status() & COMPETITION_DISABLED) != 0;
+}
+
+}  // namespace competition
+}  // namespace pros
+
+void host::setDigital(pros::controller_id_e_t id, pros::controller_digital_e_t button, bool pressed) {
+  ControllerState& controller = controllers[id];
+  if (pressed && !controller.digital[button]) {
+    controller.newPress[button] = true;
+  }
+  controller.digital[button] = pressed;
+}
+
+void host::setAnalog(pros::controller_id_e_t id, pros::controller_analog_e_t channel, std::int32_t value) {
+  controllers[id].analog[channel] = value;
+}
+
+void host::setCompetitionStatus(std::uint8_t status) {
+  competitionStatus = status;
+}
+
+std::size_t host::controllerReads() {
+  return reads;
+}
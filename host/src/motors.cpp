@@ -0,0 +1,44 @@
+#include "HostSim.h"
+#include <atomic>
+
+namespace {
+  // The last command sent to each V5 port, and the number of commands sent to every motor
+  std::atomic<std::int32_t> values[22];
+  std::atomic<std::size_t> writes(0);
+
+  int32_t record(uint8_t port, int32_t value) {
+    if (port < 1 || port > 21) {
+      errno = ENXIO;
+      return PROS_ERR;
+    }
+    writes++;
+    values[port] = value;
+    return 1;
+  }
+}
+
+namespace pros {
+namespace c {
+
+int32_t motor_move(uint8_t port, int32_t voltage) {
+  return record(port, voltage);
+}
+
+int32_t motor_move_velocity(uint8_t port, const int32_t velocity) {
+  return record(port, velocity);
+}
+
+int32_t motor_move_voltage(uint8_t port, const int32_t voltage) {
+  return record(port, voltage);
+}
+
+}  // namespace c
+}  // namespace pros
+
+std::size_t host::motorWrites() {
+  return writes;
+}
+
+std::int32_t host::motorValue(std::uint8_t port) {
+  return port >= 1 && port <= 21 ? values[port].load() : 0;
+}
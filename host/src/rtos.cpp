@@ -0,0 +1,126 @@
+#include "Kernel.h"
+#include "HostSim.h"
+#include "pros/rtos.hpp"
+
+using namespace host;
+
+namespace pros {
+namespace c {
+
+uint32_t millis(void) {
+  return host::micros() / 1000;
+}
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t stack_depth,
+                   const char* const name) {
+  (void)stack_depth; // Host threads get the default stack size
+  return kernel::createTask(function, parameters, prio, name);
+}
+
+void task_delete(task_t task) {
+  kernel::removeTask(static_cast<kernel::SimTask*>(task == CURRENT_TASK ? kernel::currentTask() : task));
+}
+
+void task_delay(const uint32_t milliseconds) {
+  kernel::delayMicros(std::uint64_t(milliseconds) * 1000);
+}
+
+void delay(const uint32_t milliseconds) {
+  task_delay(milliseconds);
+}
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+  // Wakes up delta milliseconds after the previous wake time, or immediately if that time has already passed
+  std::uint64_t wakeTime = std::uint64_t(*prev_time + delta) * 1000;
+  std::uint64_t now = host::micros();
+  *prev_time += delta;
+  if (wakeTime > now) {
+    kernel::delayMicros(wakeTime - now);
+  }
+}
+
+uint32_t task_get_priority(task_t task) {
+  return kernel::getPriority(static_cast<kernel::SimTask*>(task == CURRENT_TASK ? kernel::currentTask() : task));
+}
+
+void task_set_priority(task_t task, uint32_t prio) {
+  kernel::setPriority(static_cast<kernel::SimTask*>(task == CURRENT_TASK ? kernel::currentTask() : task), prio);
+}
+
+task_state_e_t task_get_state(task_t task) {
+  return task_state_e_t(kernel::getState(static_cast<kernel::SimTask*>(task)));
+}
+
+task_t task_get_current() {
+  return kernel::currentTask();
+}
+
+uint32_t task_get_count(void) {
+  return host::taskCount();
+}
+
+uint32_t task_notify(task_t task) {
+  kernel::notify(static_cast<kernel::SimTask*>(task == CURRENT_TASK ? kernel::currentTask() : task));
+  return 1;
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+  return kernel::notifyTake(clear_on_exit, timeout);
+}
+
+}  // namespace c
+
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name) {
+  task = c::task_create(function, parameters, prio, stack_depth, name);
+}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task Task::current() {
+  return Task(c::task_get_current());
+}
+
+void Task::operator=(const task_t in) {
+  task = in;
+}
+
+void Task::remove() {
+  c::task_delete(task);
+}
+
+std::uint32_t Task::get_priority(void) {
+  return c::task_get_priority(task);
+}
+
+void Task::set_priority(std::uint32_t prio) {
+  c::task_set_priority(task, prio);
+}
+
+std::uint32_t Task::get_state(void) {
+  return c::task_get_state(task);
+}
+
+void Task::delay(const std::uint32_t milliseconds) {
+  c::task_delay(milliseconds);
+}
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+  c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count(void) {
+  return c::task_get_count();
+}
+
+std::uint32_t Task::notify(void) {
+  return c::task_notify(task);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+  return c::task_notify_take(clear_on_exit, timeout);
+}
+
+}  // namespace pros
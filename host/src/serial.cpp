@@ -0,0 +1,35 @@
+#include "HostSim.h"
+#include "pros/apix.h"
+#include <atomic>
+
+namespace {
+  // Whether the serial driver would wrap stdout in COBS packets, which it does until told not to
+  std::atomic<bool> cobs(true);
+}
+
+namespace pros {
+namespace c {
+
+int32_t serctl(const uint32_t action, void* const extra_arg) {
+  (void)extra_arg;
+  if (action == SERCTL_ENABLE_COBS) {
+    cobs = true;
+  } else if (action == SERCTL_DISABLE_COBS) {
+    cobs = false;
+  }
+  return 0;
+}
+
+int32_t fdctl(int file, const uint32_t action, void* const extra_arg) {
+  (void)file;
+  (void)action;
+  (void)extra_arg;
+  return 0;
+}
+
+}  // namespace c
+}  // namespace pros
+
+bool host::serialCobs() {
+  return cobs;
+}
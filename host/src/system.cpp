@@ -0,0 +1,6 @@
+#include "HostSim.h"
+
+// The V5 runtime's microsecond timer, which reads the simulated clock like millis() does
+extern "C" std::uint64_t vexSystemHighResTimeGet(void) {
+  return host::micros();
+}
@@ -0,0 +1,25 @@
+#ifndef _CLOCK_H_
+#define _CLOCK_H_
+
+#include <cstdint>
+
+// The microsecond timer from the V5 runtime, which PROS 3.2 does not expose
+extern "C" std::uint64_t vexSystemHighResTimeGet(void);
+
+namespace libIterativeRobot {
+
+/**
+ * @brief Gets the current time from the brain's microsecond timer
+ *
+ * Used wherever the library times something shorter than the millisecond resolution of pros::c::millis(), such as a
+ * single update or a call to one of a Command's methods.
+ *
+ * @return The number of microseconds since the program started
+ */
+inline std::uint64_t micros() {
+  return vexSystemHighResTimeGet();
+}
+
+};
+
+#endif // _CLOCK_H_
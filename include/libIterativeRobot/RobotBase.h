@@ -3,8 +3,75 @@
 
 #include "main.h"
 #include "pros/rtos.hpp"
+#include "libIterativeRobot/Storage.h"
+#include <cstdint>
 
 namespace libIterativeRobot {
+  /**
+   * Timing of the robot's main loop, collected by RobotBase on every cycle
+   *
+   * A cycle is one pass of the loop, which happens once every base period. Its duration is the time doOneCycle() and
+   * any periodic callbacks due on that cycle took, and its jitter is how late the cycle started compared to when it
+   * was scheduled to. Both are also counted in histograms: bucket i counts values from i to i + 1 times the bucket
+   * width, and the last bucket also counts everything above it.
+   */
+  struct CycleStatistics {
+    /**
+     * @brief The number of buckets in each histogram
+     */
+    static const std::size_t HistogramBuckets = 20;
+
+    /**
+     * @brief The width of each bucket of the duration histogram, in microseconds
+     */
+    static const std::uint32_t DurationBucketMicros = 500;
+
+    /**
+     * @brief The width of each bucket of the jitter histogram, in microseconds
+     */
+    static const std::uint32_t JitterBucketMicros = 100;
+
+    /**
+     * @brief The number of cycles that have run
+     */
+    std::uint32_t cycles = 0;
+
+    /**
+     * @brief The number of cycles that finished after the next cycle should have started
+     */
+    std::uint32_t overruns = 0;
+
+    /**
+     * @brief The number of times a cycle should have started but could not, because the cycle before it overran
+     */
+    std::uint32_t missedDeadlines = 0;
+
+    /**
+     * @brief The total duration of every cycle, in microseconds
+     */
+    std::uint64_t totalMicros = 0;
+
+    /**
+     * @brief The duration of the longest cycle, in microseconds
+     */
+    std::uint32_t maxMicros = 0;
+
+    /**
+     * @brief The largest jitter of any cycle, in microseconds
+     */
+    std::uint32_t maxJitterMicros = 0;
+
+    /**
+     * @brief The number of cycles in each range of durations
+     */
+    std::uint32_t durationHistogram[HistogramBuckets] = {};
+
+    /**
+     * @brief The number of cycles in each range of jitter
+     */
+    std::uint32_t jitterHistogram[HistogramBuckets] = {};
+  };
+
   class RobotBase {
     private:
       /**
@@ -22,6 +89,55 @@ namespace libIterativeRobot {
        */
       RobotState lastState = RobotState::None;
 
+      /**
+       * @brief Timing of every cycle since the robot started or the statistics were last reset
+       */
+      CycleStatistics cycleStatistics;
+
+      /**
+       * @brief A function registered with addPeriodic()
+       */
+      struct Periodic {
+        void (*callback)(void*);
+        void* parameter;
+        std::uint32_t multiple;
+        std::uint32_t phase;
+      };
+
+      /**
+       * @brief The functions registered with addPeriodic(), in the order they were registered
+       */
+      Storage<Periodic, LIBITERATIVEROBOT_MAX_PERIODICS> periodics;
+
+      /**
+       * @brief The base period of the loop in milliseconds
+       */
+      std::uint32_t period = 10;
+
+      /**
+       * @brief The number of base periods between calls to doOneCycle()
+       */
+      std::uint32_t cycleMultiple = 1;
+
+      /**
+       * @brief Runs everything that is due on one cycle of the loop
+       *
+       * Runs doOneCycle() if the cycle is a multiple of cycleMultiple, and then every periodic function that is due.
+       *
+       * @param cycle The number of base periods since the loop started
+       */
+      void doOneTick(std::uint32_t cycle);
+
+      /**
+       * @brief Records the timing of one cycle and calls cycleOverrun() if it ran past the start of the next cycle
+       * @param scheduled When the cycle should have started, in microseconds
+       * @param start When the cycle started, in microseconds
+       * @param end When the cycle finished, in microseconds
+       * @param period The loop period, in microseconds
+       * @return The number of cycle start times that passed while the cycle was running
+       */
+      std::uint32_t recordCycle(std::uint64_t scheduled, std::uint64_t start, std::uint64_t end, std::uint32_t period);
+
       /**
        * @brief Main loop of the entire robot.
        *
@@ -69,6 +185,54 @@ namespace libIterativeRobot {
         */
       virtual void disabledPeriodic() = 0;
 
+      /**
+        * @brief Runs right after a cycle that took longer than the loop period.
+        *
+        * Called from the robot task, so it should return quickly. The cycles that should have started while the slow
+        * cycle was running are skipped rather than run late, and are counted in the cycle statistics as missed
+        * deadlines.
+        *
+        * @param cycleMicros How long the cycle took, in microseconds
+        */
+      virtual void cycleOverrun(std::uint32_t cycleMicros);
+
+      /**
+        * @brief Sets the base period of the robot's main loop.
+        *
+        * Every other rate is a multiple of the base period: robot states and the EventScheduler run every
+        * setCycleMultiple() periods, and each function added with addPeriodic() runs at its own multiple. Takes effect
+        * from the next cycle, so it can be called from robotInit().
+        *
+        * @param milliseconds The base period, which is 10ms by default
+        */
+      void setPeriod(std::uint32_t milliseconds);
+
+      /**
+        * @brief Sets how often the robot states and the EventScheduler run.
+        *
+        * For example, with a 5ms base period and a multiple of 2, the init and periodic methods and the EventScheduler
+        * run every 10ms while functions added with addPeriodic() can run every 5ms.
+        *
+        * @param multiple The number of base periods between runs, which is 1 by default
+        */
+      void setCycleMultiple(std::uint32_t multiple);
+
+      /**
+        * @brief Adds a function to be called at a multiple of the base period.
+        *
+        * Periodic functions run in the robot task in every robot state, after doOneCycle() on cycles where both are due,
+        * and in the order they were added. Giving slow, low priority work such as telemetry or screen updates a large
+        * multiple and a phase that differs from other periodic functions keeps it from running on the same cycles as
+        * each other. A cycle that is skipped because of an overrun skips the periodic functions due on it as well.
+        *
+        * @param callback The function to call
+        * @param parameter The parameter to pass to the function
+        * @param multiple The number of base periods between calls. For example, 10 runs the function every 100ms with
+        * the default 10ms base period
+        * @param phase Which cycle out of every multiple to run the function on, from 0 to multiple - 1
+        */
+      void addPeriodic(void (*callback)(void*), void* parameter, std::uint32_t multiple, std::uint32_t phase = 0);
+
       /**
        * @brief Starts the task that runs doOneCycle
        */
@@ -83,6 +247,17 @@ namespace libIterativeRobot {
         * This should be called in the initialize function in initialize.cpp
         */
       static void initializeRobot();
+
+      /**
+       * @brief Gets the timing of the robot's main loop
+       * @return The statistics of every cycle since the robot started or resetCycleStatistics() was last called
+       */
+      const CycleStatistics& getCycleStatistics();
+
+      /**
+       * @brief Clears the timing of the robot's main loop, for example to measure one period of a match on its own
+       */
+      void resetCycleStatistics();
   };
 }
 #endif // _ROBOTBASE_H_
@@ -0,0 +1,118 @@
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace libIterativeRobot {
+
+/**
+ * A Seqlock shares a value written by one task with any number of readers, without locks and without the readers ever
+ * seeing a value that is partly written.
+ *
+ * The writer makes the sequence number odd, copies the value in, and makes it even again. A reader copies the value out
+ * between two reads of the sequence number, and copies it again if the number was odd or changed in between, which only
+ * happens if the writer ran in the middle of the read. The value is kept in atomic words so that the copies are not
+ * data races.
+ *
+ * A reader spins while a write is in progress, so on the brain's single core the writer's task must have a higher
+ * priority than every reader's, so that no reader can preempt it partway through a write.
+ */
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value, "A Seqlock copies its value word by word");
+
+  private:
+    /**
+     * @brief The number of words the value takes up
+     */
+    static const std::size_t words = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+
+    /**
+     * @brief Twice the number of writes so far, plus one while a write is in progress
+     */
+    std::atomic<std::uint32_t> sequence;
+
+    /**
+     * @brief The value, one word at a time
+     */
+    std::atomic<std::uint32_t> data[words];
+
+    /**
+     * @brief The number of times a reader had to copy the value again
+     */
+    mutable std::atomic<std::uint32_t> retries;
+  public:
+    /**
+     * @brief Creates a Seqlock
+     * @param value The value to start with
+     */
+    Seqlock(const T& value = T()) : sequence(0), retries(0) {
+      for (std::atomic<std::uint32_t>& word : data) {
+        word.store(0, std::memory_order_relaxed);
+      }
+      store(value);
+    }
+
+    /**
+     * @brief Sets the value, which must only be done from one task
+     * @param value The new value
+     */
+    void store(const T& value) {
+      std::uint32_t buffer[words] = {};
+      std::memcpy(buffer, &value, sizeof(T));
+      std::uint32_t current = sequence.load(std::memory_order_relaxed);
+      sequence.store(current + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (std::size_t i = 0; i < words; i++) {
+        data[i].store(buffer[i], std::memory_order_relaxed);
+      }
+      sequence.store(current + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Gets the value
+     * @return The value as of the last completed store()
+     */
+    T load() const {
+      std::uint32_t buffer[words];
+      while (true) {
+        std::uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+          for (std::size_t i = 0; i < words; i++) {
+            buffer[i] = data[i].load(std::memory_order_relaxed);
+          }
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (sequence.load(std::memory_order_relaxed) == before) {
+            break;
+          }
+        }
+        retries.fetch_add(1, std::memory_order_relaxed);
+      }
+      T value;
+      std::memcpy(&value, buffer, sizeof(T));
+      return value;
+    }
+
+    /**
+     * @brief Gets the number of times the value has been set, counting the one it was created with
+     * @return The number of completed stores
+     */
+    std::uint32_t getVersion() const {
+      return sequence.load(std::memory_order_acquire) / 2;
+    }
+
+    /**
+     * @brief Gets the number of times a reader had to copy the value again because a write was in progress
+     * @return The number of retries
+     */
+    std::uint32_t getRetries() const {
+      return retries.load(std::memory_order_relaxed);
+    }
+};
+
+};
+
+#endif // _SEQLOCK_H_
@@ -0,0 +1,289 @@
+#ifndef _STORAGE_H_
+#define _STORAGE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Defining LIBITERATIVEROBOT_STATIC gives every container the library keeps a fixed capacity, set by the macros below,
+ * so the scheduler's memory is reserved in static storage when the program is linked instead of on the heap. Anything
+ * added past a capacity is dropped and counted by StorageDiagnostics rather than allocated. Without it, the containers
+ * are std::vectors that grow as needed, and the capacities are ignored.
+ */
+
+/**
+ * The most Subsystems the EventScheduler tracks
+ */
+#ifndef LIBITERATIVEROBOT_MAX_SUBSYSTEMS
+#define LIBITERATIVEROBOT_MAX_SUBSYSTEMS 16
+#endif
+
+/**
+ * The most Commands in the EventScheduler at once, and the most waiting to be queued
+ */
+#ifndef LIBITERATIVEROBOT_MAX_COMMANDS
+#define LIBITERATIVEROBOT_MAX_COMMANDS 64
+#endif
+
+/**
+ * The most CommandGroups in the EventScheduler at once
+ */
+#ifndef LIBITERATIVEROBOT_MAX_COMMAND_GROUPS
+#define LIBITERATIVEROBOT_MAX_COMMAND_GROUPS 16
+#endif
+
+/**
+ * The most distinct Command priorities in the EventScheduler at once
+ */
+#ifndef LIBITERATIVEROBOT_MAX_PRIORITIES
+#define LIBITERATIVEROBOT_MAX_PRIORITIES 8
+#endif
+
+/**
+ * The most EventListeners registered with the EventScheduler at once
+ */
+#ifndef LIBITERATIVEROBOT_MAX_LISTENERS
+#define LIBITERATIVEROBOT_MAX_LISTENERS 64
+#endif
+
+/**
+ * The most sequential steps in a CommandGroup
+ */
+#ifndef LIBITERATIVEROBOT_MAX_GROUP_STEPS
+#define LIBITERATIVEROBOT_MAX_GROUP_STEPS 16
+#endif
+
+/**
+ * The most Commands and CommandGroups in a CommandGroup, counting every step
+ */
+#ifndef LIBITERATIVEROBOT_MAX_GROUP_COMMANDS
+#define LIBITERATIVEROBOT_MAX_GROUP_COMMANDS 32
+#endif
+
+/**
+ * The most cached branches in a ConditionalGroup. A branch taken once the cache is full is rebuilt on every run.
+ */
+#ifndef LIBITERATIVEROBOT_MAX_BRANCHES
+#define LIBITERATIVEROBOT_MAX_BRANCHES 4
+#endif
+
+/**
+ * The most Subsystems a Command requires
+ */
+#ifndef LIBITERATIVEROBOT_MAX_REQUIREMENTS
+#define LIBITERATIVEROBOT_MAX_REQUIREMENTS 8
+#endif
+
+/**
+ * The most Commands bound to each event of a Trigger, counting run and stop bindings separately
+ */
+#ifndef LIBITERATIVEROBOT_MAX_BINDINGS
+#define LIBITERATIVEROBOT_MAX_BINDINGS 4
+#endif
+
+/**
+ * The most controllers the EventScheduler keeps snapshots of
+ */
+#ifndef LIBITERATIVEROBOT_MAX_CONTROLLERS
+#define LIBITERATIVEROBOT_MAX_CONTROLLERS 2
+#endif
+
+/**
+ * The most buttons and channels subscribed to across each ControllerSnapshot
+ */
+#ifndef LIBITERATIVEROBOT_MAX_SUBSCRIPTIONS
+#define LIBITERATIVEROBOT_MAX_SUBSCRIPTIONS 32
+#endif
+
+/**
+ * The most functions registered with RobotBase::addPeriodic()
+ */
+#ifndef LIBITERATIVEROBOT_MAX_PERIODICS
+#define LIBITERATIVEROBOT_MAX_PERIODICS 8
+#endif
+
+namespace libIterativeRobot {
+
+/**
+ * StorageDiagnostics counts what was dropped because a fixed capacity was full. It always reads zero unless
+ * LIBITERATIVEROBOT_STATIC is defined, and a nonzero count means one of the LIBITERATIVEROBOT_MAX_ capacities should be
+ * raised.
+ */
+class StorageDiagnostics {
+  private:
+    /**
+     * @brief The number of elements dropped so far
+     */
+    static std::atomic<std::uint32_t> overflows;
+  public:
+    /**
+     * @brief Counts an element dropped because its container was full
+     */
+    static void recordOverflow() {
+      overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of elements dropped because their container was full
+     * @return The number of dropped elements
+     */
+    static std::uint32_t getOverflows() {
+      return overflows.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * A StaticVector holds up to N elements in place, with the subset of the std::vector interface that the library uses,
+ * so the two can be swapped for each other. Adding past the capacity drops the element and records an overflow instead
+ * of allocating, so push_back() and insert() report whether the element was added.
+ */
+template <typename T, size_t N>
+class StaticVector {
+  private:
+    /**
+     * @brief The elements, of which the first count are in use
+     */
+    T items[N == 0 ? 1 : N];
+
+    /**
+     * @brief The number of elements in use
+     */
+    size_t count = 0;
+  public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    /**
+     * @brief Adds an element to the end
+     * @param value The element to add
+     * @return True if it was added, false if the StaticVector was full
+     */
+    bool push_back(const T& value) {
+      if (count == N) {
+        StorageDiagnostics::recordOverflow();
+        return false;
+      }
+      items[count++] = value;
+      return true;
+    }
+
+    /**
+     * @brief Adds an element before another, shifting the rest up by one
+     * @param position Where to add the element
+     * @param value The element to add
+     * @return The added element, or end() if the StaticVector was full
+     */
+    iterator insert(iterator position, const T& value) {
+      if (count == N) {
+        StorageDiagnostics::recordOverflow();
+        return end();
+      }
+      for (iterator shifted = end(); shifted != position; shifted--) {
+        *shifted = *(shifted - 1);
+      }
+      *position = value;
+      count++;
+      return position;
+    }
+
+    /**
+     * @brief Removes a range of elements, shifting the rest down over them
+     * @param first The first element to remove
+     * @param last The element after the last one to remove
+     * @return The element that followed the removed ones
+     */
+    iterator erase(iterator first, iterator last) {
+      iterator kept = first;
+      for (iterator moved = last; moved != end(); moved++) {
+        *kept++ = *moved;
+      }
+      count -= last - first;
+      return first;
+    }
+
+    /**
+     * @brief Sets the number of elements, filling any new ones with a value
+     *
+     * Sizes past the capacity are cut down to it and recorded as an overflow.
+     *
+     * @param size The new number of elements
+     * @param value The value of any new elements
+     */
+    void resize(size_t size, const T& value = T()) {
+      if (size > N) {
+        StorageDiagnostics::recordOverflow();
+        size = N;
+      }
+      for (size_t i = count; i < size; i++) {
+        items[i] = value;
+      }
+      count = size;
+    }
+
+    /**
+     * @brief Replaces every element with a number of copies of a value
+     * @param size The new number of elements
+     * @param value The value of every element
+     */
+    void assign(size_t size, const T& value) {
+      count = 0;
+      resize(size, value);
+    }
+
+    /**
+     * @brief Does nothing, since the storage is already reserved; kept so a StaticVector can stand in for a std::vector
+     */
+    void reserve(size_t) {}
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T& back() { return items[count - 1]; }
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+};
+
+/**
+ * The container the library keeps up to N elements in: a StaticVector with LIBITERATIVEROBOT_STATIC defined, and a
+ * std::vector otherwise
+ */
+#ifdef LIBITERATIVEROBOT_STATIC
+template <typename T, size_t N>
+using Storage = StaticVector<T, N>;
+#else
+template <typename T, size_t N>
+using Storage = std::vector<T>;
+#endif
+
+/**
+ * @brief Checks whether one more element fits in a container, recording an overflow if it does not
+ *
+ * Used before adding an element whose loss would leave other state out of step, such as a Command's recorded slot.
+ * A std::vector always has room.
+ *
+ * @param container The container to check
+ * @return Whether an element can be added
+ */
+template <typename T, typename Allocator>
+inline bool hasRoom(const std::vector<T, Allocator>&) {
+  return true;
+}
+
+template <typename T, size_t N>
+inline bool hasRoom(const StaticVector<T, N>& container) {
+  if (container.size() >= N) {
+    StorageDiagnostics::recordOverflow();
+    return false;
+  }
+  return true;
+}
+
+};
+
+#endif // _STORAGE_H_
@@ -0,0 +1,143 @@
+#ifndef _COMMANDS_ASYNCCOMMAND_H_
+#define _COMMANDS_ASYNCCOMMAND_H_
+
+#include "main.h"
+#include "libIterativeRobot/commands/Command.h"
+#include <atomic>
+#include <cstdint>
+
+namespace libIterativeRobot {
+
+/**
+ * An AsyncCommand is a Command whose slow work, such as generating a path or processing vision blobs, runs on one of
+ * the WorkerPool's tasks instead of in execute(), so the EventScheduler keeps updating every other Command while it
+ * runs.
+ *
+ * When the AsyncCommand starts, start() is called and its work() method is handed to the WorkerPool. While the work is
+ * running, poll() is called on every update in place of execute(), and the AsyncCommand finishes on the first update
+ * after work() returns, at which point end() is called as usual. Anything work() stores for end() to use is safe to
+ * read from there.
+ *
+ * If the AsyncCommand is interrupted, cancelled() is called and isCancelled() starts returning true, and work() should
+ * check it regularly and return early once it does. If the work had not been given to a worker yet, it never runs.
+ * If the AsyncCommand is run again while cancelled work is still returning, start() and the new work wait until the old
+ * work has returned, so the two never share the AsyncCommand's state.
+ *
+ * The EventScheduler handles the AsyncCommand's status like any other Command's: it is Running from when it starts
+ * until its work is done or it is interrupted. start(), poll(), cancelled(), end() and blocked() are called from the
+ * EventScheduler's task, and work() from a worker's task.
+ */
+class AsyncCommand : public Command {
+  private:
+    /**
+     * @brief Where the AsyncCommand's work is
+     */
+    enum class Phase : std::uint8_t {
+      Idle, // No work has been started, or it was cancelled before a worker took it
+      Waiting, // The work is waiting for a worker
+      Working, // A worker is doing the work
+      Done // The work has returned
+    };
+
+    /**
+     * @brief Where the AsyncCommand's work is, which is only changed from Working by the worker
+     */
+    std::atomic<Phase> phase;
+
+    /**
+     * @brief Whether the work has been asked to stop
+     */
+    std::atomic<bool> cancelRequested;
+
+    /**
+     * @brief Whether the AsyncCommand was started again while cancelled work was still running
+     */
+    bool restartPending = false;
+
+    /**
+     * @brief Calls start() and hands new work to the WorkerPool
+     */
+    void begin();
+
+    /**
+     * @brief Hands the work to the WorkerPool if it is waiting for a worker
+     */
+    void dispatch();
+
+    /**
+     * @brief Does the work, then marks it as done. Called on a worker task
+     */
+    void performWork();
+
+    /**
+     * Accesses performWork()
+     */
+    friend class WorkerPool;
+  protected:
+    /**
+     * @brief Called once when the AsyncCommand starts, before its work is handed to the WorkerPool
+     */
+    virtual void start();
+
+    /**
+     * @brief Does the AsyncCommand's slow work on a worker task
+     *
+     * Should return early once isCancelled() returns true.
+     */
+    virtual void work() = 0;
+
+    /**
+     * @brief Called on every update while the work is running
+     */
+    virtual void poll();
+
+    /**
+     * @brief Called once when the AsyncCommand is interrupted, after its work has been asked to stop
+     */
+    virtual void cancelled();
+
+    /**
+     * @brief Checks whether the work has been asked to stop because the AsyncCommand was interrupted
+     * @return True if work() should return, false otherwise
+     */
+    bool isCancelled();
+  public:
+    /**
+     * @brief Creates a new AsyncCommand
+     */
+    AsyncCommand();
+
+    /**
+     * @brief Calls start() and hands the work to the WorkerPool, unless cancelled work is still returning
+     */
+    void initialize();
+
+    /**
+     * @brief Starts the work if it was held back or every worker was busy before, then calls poll()
+     */
+    void execute();
+
+    /**
+     * @brief Checks whether the work has returned
+     * @return True if the work has returned, false otherwise
+     */
+    bool isFinished();
+
+    /**
+     * @brief Asks the work to stop, then calls cancelled()
+     */
+    void interrupted();
+
+    /**
+     * @brief Checks whether a worker is doing the AsyncCommand's work
+     *
+     * Cancelled work counts until it returns.
+     *
+     * @return True if the work is running on a worker, false otherwise
+     */
+    bool isWorking();
+};
+
+}; // namespace libIterativeRobot
+
+#endif // _COMMANDS_ASYNCCOMMAND_H_
@@ -3,7 +3,10 @@
 
 #include "main.h"
 #include "libIterativeRobot/subsystems/Subsystem.h"
-#include <vector>
+#include "libIterativeRobot/subsystems/SubsystemMask.h"
+#include "libIterativeRobot/events/Profiler.h"
+#include "libIterativeRobot/events/Tracer.h"
+#include "libIterativeRobot/Storage.h"
 #include "libIterativeRobot/commands/Status.h"
 
 namespace libIterativeRobot {
@@ -29,7 +32,7 @@ namespace libIterativeRobot {
  *
  * When a command is interrupted, its interrupted() method is called and it is removed from the EventScheduler
  *
- * Subsystems that a command uses should be declared by calling the requires() method in its constructor.
+ * Subsystems that a command uses should be declared by calling the addRequirement() method in its constructor.
  *
  * Every command has a priority which determines how it will interact with other commands.
  * If two commands use one or more of the same subsystems, the one with the higher priority will interrupt
@@ -41,7 +44,7 @@ namespace libIterativeRobot {
  * As a result, the EventScheduler continually attempts to run all default commands, and default commands
  * are constantly run while no other commands require the same subsystem. A command is a default command
  * if it is passed to a subsystem's setDefaultCommand() method. The subsystem that the default command requires
- * is automatically added to its list of requirements, so it is not necessary to use the requires() method to add it.
+ * is automatically added to its list of requirements, so it is not necessary to use the addRequirement() method to add it.
  */
 class Command {
   private:
@@ -59,7 +62,60 @@ class Command {
      * </script>
      * @endhtmlonly
      */
-    std::vector<Subsystem*> subsystemRequirements;
+    Storage<Subsystem*, LIBITERATIVEROBOT_MAX_REQUIREMENTS> subsystemRequirements;
+
+    /**
+     * @brief The command's requirements as a bitset of Subsystem indexes
+     *
+     * Kept in sync with subsystemRequirements by addRequirement(), so the EventScheduler can check for conflicting
+     * requirements with a single AND instead of searching through a vector
+     */
+    SubsystemMask requirementMask;
+
+    /**
+     * @brief The queues and buffers of the EventScheduler that a Command or CommandGroup can be stored in
+     */
+    enum class SchedulerLocation {
+      None,
+      CommandBuffer,
+      CommandQueue,
+      CommandGroupBuffer,
+      IntermediateGroupBuffer,
+      CommandGroupQueue
+    };
+
+    /**
+     * @brief Which of the EventScheduler's queues or buffers the command is in, if any
+     *
+     * Lets the EventScheduler check whether a command has already been added without searching its queues
+     */
+    SchedulerLocation schedulerLocation = SchedulerLocation::None;
+
+    /**
+     * @brief The command's index in the queue or buffer given by schedulerLocation
+     *
+     * Lets the EventScheduler remove a command without searching for it
+     */
+    size_t schedulerSlot = 0;
+
+    /**
+     * @brief The index of the CommandQueue bucket the command is in, when it is in the commandQueue
+     */
+    size_t schedulerBucket = 0;
+
+#ifdef LIBITERATIVEROBOT_PROFILE
+    /**
+     * @brief How long each of the command's methods has taken when called by the EventScheduler
+     */
+    CommandProfile profile;
+#endif
+
+#ifdef LIBITERATIVEROBOT_TRACE
+    /**
+     * @brief The command's name id in traces, or 0 if it has not been traced yet
+     */
+    std::uint16_t traceId = 0;
+#endif
   protected:
     /**
      * @brief Higher priority commands interrupt lower priority commands
@@ -70,7 +126,21 @@ class Command {
      * @brief Adds a subsystem as one of a command's requirements
      * @param aSubsystem The subsystem that the command requires
      */
-    void requires(Subsystem* aSubsystem);
+    void addRequirement(Subsystem* aSubsystem);
+
+#if __cplusplus <= 201703L
+    /**
+     * @brief Adds a subsystem as one of a command's requirements
+     *
+     * Deprecated, since requires is a keyword in C++20, so this is only declared before C++20. Use addRequirement()
+     * instead.
+     *
+     * @param aSubsystem The subsystem that the command requires
+     */
+    [[deprecated("use addRequirement() instead")]] void requires(Subsystem* aSubsystem) {
+      addRequirement(aSubsystem);
+    }
+#endif
 
     /**
      * @brief Keeps track of the status of the command
@@ -84,10 +154,19 @@ class Command {
      *
      * @return The command's requirements as a vector pointer
      */
-    std::vector<Subsystem*>& getRequirements();
+    Storage<Subsystem*, LIBITERATIVEROBOT_MAX_REQUIREMENTS>& getRequirements();
+
+    /**
+     * @brief Gets the requirements that a command uses as a SubsystemMask
+     *
+     * Used by the EventScheduler to decide whether the command can run
+     *
+     * @return The command's requirements as a SubsystemMask
+     */
+    SubsystemMask& getRequirementMask();
 
     /**
-     * @brief Accesses commands' requires method
+     * @brief Accesses commands' addRequirement method
      */
     friend class Subsystem;
 
@@ -96,10 +175,39 @@ class Command {
      */
     friend class EventScheduler;
 
+    /**
+     * @brief Accesses commands' priority and scheduler location
+     */
+    friend class CommandQueue;
+
     /**
      * @brief Acceses commands' status and subsystem requirements
      */
     friend class CommandGroup;
+
+    /**
+     * @brief Accesses the status of the commands a CoroutineCommand waits on
+     */
+    friend class CoroutineCommand;
+
+    /**
+     * @brief Accesses the status of the commands it samples
+     */
+    friend class Telemetry;
+
+#ifdef LIBITERATIVEROBOT_PROFILE
+    /**
+     * @brief Accesses commands' profiles
+     */
+    friend class Profiler;
+#endif
+
+#ifdef LIBITERATIVEROBOT_TRACE
+    /**
+     * @brief Accesses commands' trace name ids
+     */
+    friend class Tracer;
+#endif
   public:
     /**
      * @brief The priority of a default command is 0
@@ -153,11 +261,15 @@ class Command {
 
     /**
      * @brief Adds the command to the EventScheduler
+     *
+     * Must be called from the task that updates the EventScheduler. Other tasks can use EventScheduler::submit().
      */
     virtual void run();
 
     /**
      * @brief Removes the command from the EventScheduler and interrupts it
+     *
+     * Must be called from the task that updates the EventScheduler. Other tasks can use EventScheduler::submit().
      */
     virtual void stop();
 
@@ -166,6 +278,12 @@ class Command {
      * @return A Command
      */
     Command();
+
+    /**
+     * @brief Removes the Command from the Profiler's list when profiling is enabled, so it is not printed after it is
+     * destroyed
+     */
+    virtual ~Command();
 };
 
 }; // namespace libIterativeRobot
@@ -3,7 +3,8 @@
 
 #include "Command.h"
 #include "main.h"
-#include <vector>
+#include "libIterativeRobot/Storage.h"
+#include <cstdint>
 
 namespace libIterativeRobot {
 
@@ -19,6 +20,10 @@ namespace libIterativeRobot {
  *
  * Commands and CommandGroups added can be set to be 'forgotten' by the CommandGroup. This means that the CommandGroup
  * will not wait for them to finish before moving on to the next sequential step.
+ *
+ * With LIBITERATIVEROBOT_STATIC defined, a CommandGroup holds up to LIBITERATIVEROBOT_MAX_GROUP_COMMANDS commands in up
+ * to LIBITERATIVEROBOT_MAX_GROUP_STEPS sequential steps. Commands added past either are left out and counted by
+ * StorageDiagnostics.
  */
 
 class CommandGroup : public Command {
@@ -26,26 +31,41 @@ class CommandGroup : public Command {
     /**
      * @brief Holds all of the commands added to the CommandGroup
      *
-     * 2d vector keeping track of all commands and command groups. Each vector in the 2d vector represents a
-     * sequential step. All the commands and command groups in each sequential step are run in parallel
+     * The commands of every sequential step are stored one step after another in a single array, so running a step
+     * only walks one contiguous range. All the commands and command groups in each sequential step are run in parallel
+     */
+    Storage<Command*, LIBITERATIVEROBOT_MAX_GROUP_COMMANDS> commands;
+
+    /**
+     * @brief Where each sequential step starts in commands
+     *
+     * Step i holds commands[stepOffsets[i]] up to, but not including, commands[stepOffsets[i + 1]]. The last element is
+     * always the number of commands, so there is one more offset than there are steps
      */
-    std::vector<std::vector<Command*>> commands;
+    Storage<std::uint32_t, LIBITERATIVEROBOT_MAX_GROUP_STEPS + 1> stepOffsets;
 
     /**
-     * @brief Keeps track of which Commands and CommandGroups have been added to the EventScheduler
+     * @brief Keeps track of which Commands and CommandGroups have been added to the EventScheduler, one bit per command
      */
-    std::vector<std::vector<int>> added;
+    Storage<std::uint32_t, (LIBITERATIVEROBOT_MAX_GROUP_COMMANDS + 31) / 32> added;
 
     /**
-     * @brief Keeps track of which Commands and CommandGroups the CommandGroup should forget
+     * @brief Keeps track of which Commands and CommandGroups the CommandGroup should forget, one bit per command
      */
-    std::vector<std::vector<bool>> forget;
+    Storage<std::uint32_t, (LIBITERATIVEROBOT_MAX_GROUP_COMMANDS + 31) / 32> forget;
 
     /**
      * @brief The current sequential step the CommandGroup is running
      */
     size_t sequentialIndex = 0;
 
+    /**
+     * @brief Appends a Command or CommandGroup to the last sequential step
+     * @param aCommand The Command or CommandGroup to append
+     * @param forget Whether or not the CommandGroup should forget about aCommand
+     */
+    void append(Command* aCommand, bool forget);
+
   protected:
     /**
      * @brief Adds a sequential Command or CommandGroup
@@ -73,6 +93,14 @@ class CommandGroup : public Command {
      */
     virtual void addParallelCommand(Command* aCommand, bool forget = false);
 
+    /**
+     * @brief Removes every Command and CommandGroup from the CommandGroup
+     *
+     * The CommandGroup keeps the memory it used to hold them, so adding the same number of commands again does not
+     * allocate. This must not be called while the CommandGroup is running.
+     */
+    void clearCommands();
+
   public:
     /**
      * @brief Whether the CommandGroup can run or not
@@ -3,17 +3,86 @@
 
 #include "CommandGroup.h"
 #include "LambdaGroup.h"
+#include "libIterativeRobot/Storage.h"
 
 namespace libIterativeRobot {
+  /**
+   * A ConditionalGroup decides which commands to run each time it is run. Every call to run() calls conditionalBody(),
+   * which adds the commands for this run with addSequentialCommand() and addParallelCommand(), and then runs them as a
+   * CommandGroup. The commands from the previous run are cleared first, but the memory that held them is kept, so
+   * running the group again does not allocate unless the new body is larger than any before it.
+   *
+   * A ConditionalGroup whose body only ever takes a few forms can also override conditionalBranch() to name the form
+   * it is about to take. The commands for each branch are then only added the first time that branch is taken, and
+   * are reused as they are every time after. At most LIBITERATIVEROBOT_MAX_BRANCHES branches are cached with
+   * LIBITERATIVEROBOT_STATIC defined, and a branch taken after that is rebuilt on every run instead.
+   */
   class ConditionalGroup : public CommandGroup {
     private:
-      LambdaGroup* lambda;
-      virtual void conditionalBody();
+      /**
+       * @brief A branch whose commands have already been added
+       */
+      struct Branch {
+        int key;
+        LambdaGroup* group;
+      };
+
+      /**
+       * @brief The group rebuilt on every run when conditionalBranch() returns UncachedBranch
+       */
+      LambdaGroup lambda;
+
+      /**
+       * @brief The group that commands are being added to, or that was run last
+       */
+      LambdaGroup* current;
+
+      /**
+       * @brief The groups of every cached branch taken so far
+       */
+      Storage<Branch, LIBITERATIVEROBOT_MAX_BRANCHES> branches;
+
+#ifdef LIBITERATIVEROBOT_STATIC
+      /**
+       * @brief The groups for the cached branches, used in the order the branches are first taken
+       */
+      LambdaGroup branchGroups[LIBITERATIVEROBOT_MAX_BRANCHES];
+#endif
+
+      /**
+       * @brief Adds the commands for this run with addSequentialCommand() and addParallelCommand()
+       */
+      virtual void conditionalBody() = 0;
     protected:
+      /**
+       * @brief The value conditionalBranch() returns for a body that is rebuilt on every run
+       */
+      static const int UncachedBranch = -1;
+
+      /**
+       * @brief Names the branch the next run will take
+       *
+       * Called by run() before conditionalBody(). When this returns a key of 0 or more, conditionalBody() is only
+       * called the first time that key is returned, so it must add the commands for the branch this method picked,
+       * for example by calling it again. The default returns UncachedBranch, which rebuilds the body on every run.
+       *
+       * @return The key of the branch to run, or UncachedBranch
+       */
+      virtual int conditionalBranch();
+
       virtual void addSequentialCommand(Command* aCommand, bool forget = false);
       virtual void addParallelCommand(Command* aCommand, bool forget = false);
     public:
       ConditionalGroup();
+
+      /**
+       * @brief Stops the group and frees the groups of the cached branches
+       */
+      ~ConditionalGroup();
+
+      /**
+       * @brief Stops the previous run if it is still going, picks this run's commands and runs them
+       */
       virtual void run();
       virtual void stop();
   };
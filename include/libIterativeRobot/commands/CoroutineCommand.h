@@ -0,0 +1,424 @@
+#ifndef _COMMANDS_COROUTINECOMMAND_H_
+#define _COMMANDS_COROUTINECOMMAND_H_
+
+/**
+ * CoroutineCommands need C++20 coroutines, which the PROS toolchain's default of gnu++17 does not have. With a
+ * compiler that supports them, add -std=gnu++20 to EXTRA_CXXFLAGS in the Makefile to use them. Otherwise this header
+ * declares nothing. Everything is defined here rather than in a source file, so that the library itself still builds
+ * as gnu++17.
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include "main.h"
+#include "libIterativeRobot/commands/Command.h"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+/**
+ * The number of coroutine frames the CoroutineArena holds. Each running CoroutineCommand uses one, plus one for each
+ * Routine it is awaiting.
+ */
+#ifndef LIBITERATIVEROBOT_COROUTINE_FRAMES
+#define LIBITERATIVEROBOT_COROUTINE_FRAMES 16
+#endif
+
+/**
+ * The size of each frame in the CoroutineArena in bytes. A Routine whose frame is larger, because of the local
+ * variables it keeps across co_await, cannot be started.
+ */
+#ifndef LIBITERATIVEROBOT_COROUTINE_FRAME_SIZE
+#define LIBITERATIVEROBOT_COROUTINE_FRAME_SIZE 512
+#endif
+
+namespace libIterativeRobot {
+
+/**
+ * The CoroutineArena is a fixed set of equally sized blocks that coroutine frames are allocated from, so that starting
+ * and resuming a Routine never touches the heap. Freed blocks are kept on a free list. A frame that does not fit or
+ * finds every block in use is not allocated, and the failure is counted.
+ *
+ * Frames are only allocated and freed from the EventScheduler's task.
+ */
+class CoroutineArena {
+  private:
+    /**
+     * @brief A block of storage, which holds the next free block while it is free
+     */
+    union Block {
+      Block* next;
+      alignas(std::max_align_t) unsigned char storage[LIBITERATIVEROBOT_COROUTINE_FRAME_SIZE];
+    };
+
+    inline static Block blocks[LIBITERATIVEROBOT_COROUTINE_FRAMES];
+    inline static Block* freeList = NULL;
+    inline static size_t used = 0;
+    inline static size_t carved = 0;
+    inline static std::uint32_t failures = 0;
+  public:
+    /**
+     * @brief Allocates a block for a coroutine frame
+     * @param size The size of the frame
+     * @return The block, or NULL if the frame is too large or every block is in use
+     */
+    static void* allocate(size_t size) {
+      if (size > sizeof(Block)) {
+        failures++;
+        return NULL;
+      }
+      Block* block = freeList;
+      if (block != NULL) {
+        freeList = block->next;
+      } else if (carved < LIBITERATIVEROBOT_COROUTINE_FRAMES) {
+        block = &blocks[carved++];
+      } else {
+        failures++;
+        return NULL;
+      }
+      used++;
+      return block;
+    }
+
+    /**
+     * @brief Frees a block allocated by allocate()
+     * @param pointer The block
+     */
+    static void release(void* pointer) {
+      Block* block = static_cast<Block*>(pointer);
+      block->next = freeList;
+      freeList = block;
+      used--;
+    }
+
+    /**
+     * @brief Gets the number of blocks holding a frame
+     * @return The number of blocks in use
+     */
+    static size_t getUsed() {
+      return used;
+    }
+
+    /**
+     * @brief Gets the number of frames that could not be allocated
+     * @return The number of failed allocations
+     */
+    static std::uint32_t getFailures() {
+      return failures;
+    }
+};
+
+/**
+ * A Routine is the return type of a coroutine that a CoroutineCommand runs. It owns the coroutine's frame, which is
+ * destroyed along with the Routine. A Routine can co_await the awaitables CoroutineCommand provides, and can co_await
+ * another Routine to run it to completion before carrying on.
+ *
+ * If the frame could not be allocated from the CoroutineArena, the Routine is empty and does nothing.
+ */
+class Routine {
+  public:
+    struct promise_type {
+      /**
+       * @brief The number of updates left before the coroutine resumes, or 0 if it is not waiting for updates
+       */
+      std::uint32_t waitTicks = 0;
+
+      /**
+       * @brief The condition the coroutine resumes once it is true, or NULL if it is not waiting on a condition
+       */
+      bool (*condition)(void*) = NULL;
+
+      /**
+       * @brief What the condition is called with, which is the awaitable holding it in the coroutine's frame
+       */
+      void* conditionContext = NULL;
+
+      /**
+       * @brief The Command the coroutine resumes once it has stopped, or NULL if it is not waiting on a Command
+       */
+      Command* awaited = NULL;
+
+      /**
+       * @brief The Routine the coroutine resumes once it has finished, which the awaiting coroutine's frame owns
+       */
+      std::coroutine_handle<promise_type> child;
+
+      static void* operator new(size_t size) noexcept {
+        return CoroutineArena::allocate(size);
+      }
+
+      static void operator delete(void* pointer) {
+        CoroutineArena::release(pointer);
+      }
+
+      static Routine get_return_object_on_allocation_failure() {
+        return Routine();
+      }
+
+      Routine get_return_object() {
+        return Routine(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      // A Routine does nothing until a CoroutineCommand or another Routine resumes it, and stays around once it has
+      // finished so that its owner can tell
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+  private:
+    /**
+     * @brief The coroutine, or NULL if the Routine is empty
+     */
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Routine(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    /**
+     * Accesses the coroutine
+     */
+    friend class CoroutineCommand;
+  public:
+    /**
+     * @brief Creates an empty Routine
+     */
+    Routine() {}
+
+    Routine(Routine&& other) noexcept : handle(other.handle) {
+      other.handle = NULL;
+    }
+
+    Routine& operator=(Routine&& other) noexcept {
+      if (this != &other) {
+        if (handle) {
+          handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = NULL;
+      }
+      return *this;
+    }
+
+    Routine(const Routine&) = delete;
+    Routine& operator=(const Routine&) = delete;
+
+    ~Routine() {
+      if (handle) {
+        handle.destroy();
+      }
+    }
+
+    /**
+     * @brief Checks whether the Routine has a coroutine that has not finished
+     * @return True if the Routine has something left to do, false otherwise
+     */
+    bool isRunning() {
+      return handle && !handle.done();
+    }
+
+    // Awaiting a Routine runs it until it finishes. An empty Routine is skipped
+    bool await_ready() { return !handle; }
+    void await_suspend(std::coroutine_handle<promise_type> parent) { parent.promise().child = handle; }
+    void await_resume() {}
+};
+
+/**
+ * A CoroutineCommand is a Command whose behaviour is written as a single coroutine, its routine(), rather than spread
+ * across initialize(), execute() and isFinished(). The routine runs from its start each time the CoroutineCommand
+ * starts, and is resumed from execute() on every update until it finishes, so the CoroutineCommand finishes when
+ * the routine returns. The routine can wait with:
+ *
+ *   co_await waitTicks(n)         resumes n updates later
+ *   co_await waitUntil(condition) resumes on the first update where condition() returns true
+ *   co_await runAndWait(command)  runs a Command or CommandGroup and resumes once it has stopped, returning its Status
+ *   co_await otherRoutine()       runs another Routine, starting in the same update, and resumes once it returns
+ *
+ * Commands run with runAndWait() go through the EventScheduler like any other, with their own requirements and
+ * priorities, so a higher priority Command can interrupt them, and runAndWait() then returns Status::Interrupted. Like
+ * a CommandGroup, a CoroutineCommand usually requires nothing itself, leaving its subsystems to the Commands it runs.
+ * When the CoroutineCommand is interrupted, the Command it is waiting on is stopped, its routine is destroyed and
+ * cancelled() is called.
+ *
+ * Coroutine frames come from the CoroutineArena. If a routine's frame cannot be allocated, the CoroutineCommand
+ * finishes on its first update without doing anything, and the failure is counted by CoroutineArena::getFailures().
+ */
+class CoroutineCommand : public Command {
+  private:
+    /**
+     * @brief The routine of the current run
+     */
+    Routine current;
+
+    /**
+     * @brief Checks whether a Command run with runAndWait() has stopped
+     */
+    static bool hasStopped(Command* command) {
+      return command->status == Status::Finished || command->status == Status::Interrupted ||
+             command->status == Status::Blocked;
+    }
+
+    /**
+     * @brief Checks whether a suspended coroutine is ready to resume, counting down its wait if it is waiting
+     */
+    static bool isReady(Routine::promise_type& promise) {
+      if (promise.waitTicks > 0 && --promise.waitTicks > 0) {
+        return false;
+      }
+      if (promise.condition != NULL && !promise.condition(promise.conditionContext)) {
+        return false;
+      }
+      if (promise.awaited != NULL && !hasStopped(promise.awaited)) {
+        return false;
+      }
+      promise.condition = NULL;
+      promise.awaited = NULL;
+      return true;
+    }
+
+    /**
+     * @brief Resumes a coroutine and the Routines it is awaiting for as long as they are ready to resume
+     */
+    static void step(std::coroutine_handle<Routine::promise_type> handle) {
+      while (!handle.done()) {
+        Routine::promise_type& promise = handle.promise();
+        if (promise.child) {
+          step(promise.child);
+          if (!promise.child.done()) {
+            return;
+          }
+          promise.child = NULL; // The awaiting coroutine's frame destroys the child when it resumes
+        } else if (!isReady(promise)) {
+          return;
+        }
+        handle.resume();
+        if (!promise.child) {
+          return; // Waiting on something that is checked from the next update on
+        }
+      }
+    }
+  protected:
+    /**
+     * @brief An awaitable that resumes a number of updates later
+     */
+    struct WaitTicks {
+      std::uint32_t ticks;
+      bool await_ready() { return ticks == 0; }
+      void await_suspend(std::coroutine_handle<Routine::promise_type> handle) { handle.promise().waitTicks = ticks; }
+      void await_resume() {}
+    };
+
+    /**
+     * @brief An awaitable that resumes once a condition is true
+     */
+    template <typename Condition>
+    struct WaitUntil {
+      Condition condition;
+      static bool check(void* self) { return static_cast<WaitUntil*>(self)->condition(); }
+      bool await_ready() { return condition(); }
+      void await_suspend(std::coroutine_handle<Routine::promise_type> handle) {
+        handle.promise().condition = check;
+        handle.promise().conditionContext = this;
+      }
+      void await_resume() {}
+    };
+
+    /**
+     * @brief An awaitable that runs a Command and resumes once it has stopped
+     */
+    struct RunAndWait {
+      Command* command;
+      bool await_ready() { return false; }
+      void await_suspend(std::coroutine_handle<Routine::promise_type> handle) {
+        handle.promise().awaited = command;
+        command->run();
+      }
+      Status await_resume() { return command->status; }
+    };
+
+    /**
+     * @brief The CoroutineCommand's behaviour, which is started each time the CoroutineCommand starts
+     * @return The Routine the coroutine returns
+     */
+    virtual Routine routine() = 0;
+
+    /**
+     * @brief Called once when the CoroutineCommand is interrupted, after its routine has been destroyed
+     */
+    virtual void cancelled() {}
+
+    /**
+     * @brief Waits for a number of updates
+     * @param ticks The number of updates to wait for
+     */
+    static WaitTicks waitTicks(std::uint32_t ticks) {
+      return WaitTicks{ticks};
+    }
+
+    /**
+     * @brief Waits until a condition is true, checking it once per update
+     * @param condition A callable returning bool, which is kept in the coroutine's frame while it waits
+     */
+    template <typename Condition>
+    static WaitUntil<Condition> waitUntil(Condition condition) {
+      return WaitUntil<Condition>{condition};
+    }
+
+    /**
+     * @brief Runs a Command or CommandGroup and waits until it has finished, been interrupted or been blocked
+     * @param command The Command or CommandGroup to run
+     */
+    static RunAndWait runAndWait(Command* command) {
+      return RunAndWait{command};
+    }
+  public:
+    /**
+     * @brief Starts the routine from the beginning
+     */
+    void initialize() {
+      current = routine();
+    }
+
+    /**
+     * @brief Resumes the routine if what it is waiting on is ready
+     */
+    void execute() {
+      if (current.handle) {
+        step(current.handle);
+      }
+    }
+
+    /**
+     * @brief Checks whether the routine has returned, freeing its frame if it has
+     * @return True if the routine has returned or could not be started, false otherwise
+     */
+    bool isFinished() {
+      if (current.isRunning()) {
+        return false;
+      }
+      current = Routine();
+      return true;
+    }
+
+    /**
+     * @brief Stops the Command the routine is waiting on, destroys the routine and calls cancelled()
+     */
+    void interrupted() {
+      if (current.handle) {
+        std::coroutine_handle<Routine::promise_type> handle = current.handle;
+        while (handle.promise().child) {
+          handle = handle.promise().child;
+        }
+        if (handle.promise().awaited != NULL && !hasStopped(handle.promise().awaited)) {
+          handle.promise().awaited->stop();
+        }
+      }
+      current = Routine();
+      cancelled();
+    }
+};
+
+}; // namespace libIterativeRobot
+
+#endif // __cpp_impl_coroutine
+
+#endif // _COMMANDS_COROUTINECOMMAND_H_
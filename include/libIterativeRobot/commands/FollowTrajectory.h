@@ -0,0 +1,71 @@
+#ifndef _COMMANDS_FOLLOWTRAJECTORY_H_
+#define _COMMANDS_FOLLOWTRAJECTORY_H_
+
+#include "main.h"
+#include "libIterativeRobot/commands/Command.h"
+#include "libIterativeRobot/paths/Trajectory.h"
+
+namespace libIterativeRobot {
+
+/**
+ * A FollowTrajectory drives a drivetrain along a Trajectory from the TrajectoryCache, by name.
+ *
+ * The trajectory is looked up the first time the Command runs, which reads it from its file if it has not been read
+ * yet, and the Command is blocked if there is none by that name. On every update it hands follow() the sample due at
+ * the time since it started, which subclasses use to set the drivetrain's wheel velocities, correcting for where the
+ * robot really is if they like. The Command finishes once the trajectory is over, and follow() is then handed a sample
+ * with both wheel velocities at zero, as it is if the Command is interrupted.
+ */
+class FollowTrajectory : public Command {
+  private:
+    /**
+     * @brief The name of the trajectory in the TrajectoryCache
+     */
+    const char* name;
+
+    /**
+     * @brief The trajectory, once it has been looked up
+     */
+    const Trajectory* trajectory = NULL;
+
+    /**
+     * @brief When the Command started, in milliseconds
+     */
+    std::uint32_t startTime = 0;
+
+    /**
+     * @brief Hands follow() the sample due now, with the wheels stopped
+     */
+    void stopDriving();
+  protected:
+    /**
+     * @brief Drives toward a sample of the trajectory
+     * @param sample Where the robot should be and how fast each wheel should be turning
+     */
+    virtual void follow(const TrajectorySample& sample) = 0;
+  public:
+    /**
+     * @brief Creates a FollowTrajectory
+     * @param drive The drivetrain's Subsystem, which the Command requires
+     * @param name The name of the trajectory in the TrajectoryCache, which must outlive the Command
+     */
+    FollowTrajectory(Subsystem* drive, const char* name);
+
+    /**
+     * @brief Gets the trajectory being followed
+     * @return The trajectory, or NULL if the Command has not run yet or there is none by its name
+     */
+    const Trajectory* getTrajectory();
+
+    bool canRun();
+    void initialize();
+    void execute();
+    bool isFinished();
+    void end();
+    void interrupted();
+    void blocked();
+};
+
+};
+
+#endif // _COMMANDS_FOLLOWTRAJECTORY_H_
@@ -10,6 +10,7 @@ namespace libIterativeRobot {
       LambdaGroup();
       using CommandGroup::addSequentialCommand;
       using CommandGroup::addParallelCommand;
+      using CommandGroup::clearCommands;
   };
 }
 
@@ -0,0 +1,130 @@
+#ifndef _EVENTS_COMMANDQUEUE_H_
+#define _EVENTS_COMMANDQUEUE_H_
+
+#include "libIterativeRobot/commands/Command.h"
+#include "libIterativeRobot/Storage.h"
+
+namespace libIterativeRobot {
+
+/**
+ * The CommandQueue holds the Commands that the EventScheduler is running, ordered the way the EventScheduler
+ * processes them: higher priority Commands first, and within a priority, the most recently added Command first.
+ *
+ * Commands are kept in one bucket per priority. Adding a Command appends it to the end of its priority's bucket, so
+ * the order is kept without shifting any other Command. Removing a Command sets its slot to NULL, and the NULL values
+ * are removed later by compact(). Buckets are never freed, so once every priority in use has a bucket, adding and
+ * removing Commands does not allocate. With LIBITERATIVEROBOT_STATIC defined, the CommandQueue holds up to
+ * LIBITERATIVEROBOT_MAX_COMMANDS Commands across up to LIBITERATIVEROBOT_MAX_PRIORITIES priorities.
+ */
+class CommandQueue {
+  public:
+    /**
+     * @brief The Commands in a bucket
+     */
+    typedef Storage<Command*, LIBITERATIVEROBOT_MAX_COMMANDS> Commands;
+  private:
+    /**
+     * @brief The Commands with a single priority, ordered from oldest to newest
+     */
+    struct Bucket {
+      int priority;
+      Commands commands;
+      size_t holes;
+    };
+
+    /**
+     * @brief The buckets, ordered from lowest priority to highest priority
+     */
+    Storage<Bucket, LIBITERATIVEROBOT_MAX_PRIORITIES> buckets;
+
+    /**
+     * @brief The index of the bucket a Command was last added to
+     *
+     * Commands added together usually share a priority, so this is checked before searching for a bucket
+     */
+    size_t lastBucket = 0;
+
+    /**
+     * @brief The capacity each new bucket is created with
+     */
+    size_t bucketCapacity = 0;
+
+    /**
+     * @brief The number of Commands in the CommandQueue
+     */
+    size_t count = 0;
+
+    /**
+     * @brief The index findBucket() returns when there is no room for another bucket
+     */
+    static const size_t kNoBucket = ~size_t(0);
+
+    /**
+     * @brief Gets the index of the bucket for a priority, creating the bucket if it does not exist
+     * @param priority The priority to find the bucket for
+     * @return The index of the bucket, or kNoBucket if it did not exist and there was no room to create it
+     */
+    size_t findBucket(int priority);
+  public:
+    /**
+     * @brief Adds a Command after all of the Commands with the same priority
+     * @param command The Command to add
+     * @return True if the Command was added, false if there was no room for it, which is counted as an overflow
+     */
+    bool push(Command* command);
+
+    /**
+     * @brief Removes a Command from the CommandQueue
+     *
+     * The Command's slot is set to NULL using the position recorded in the Command, so this takes constant time.
+     *
+     * @param command The Command to remove
+     */
+    void remove(Command* command);
+
+    /**
+     * @brief Removes the NULL values left behind by remove() while keeping the order of the remaining Commands
+     *
+     * Only buckets that Commands were removed from are touched.
+     */
+    void compact();
+
+    /**
+     * @brief Removes all Commands from the CommandQueue while keeping its storage
+     */
+    void clear();
+
+    /**
+     * @brief Preallocates storage for the CommandQueue
+     * @param maxCommands The most Commands expected to share a single priority at once
+     * @param maxPriorities The most distinct priorities expected to be in use at once
+     */
+    void reserve(size_t maxCommands, size_t maxPriorities);
+
+    /**
+     * @brief Gets the number of Commands in the CommandQueue
+     * @return The number of Commands
+     */
+    size_t size();
+
+    /**
+     * @brief Gets the number of buckets
+     * @return The number of distinct priorities that have been added to the CommandQueue
+     */
+    size_t bucketCount();
+
+    /**
+     * @brief Gets the Commands in a bucket
+     *
+     * Bucket 0 has the lowest priority. Within a bucket, Commands are ordered from oldest to newest, and removed
+     * Commands that have not been compacted yet are NULL.
+     *
+     * @param index The index of the bucket
+     * @return The Commands in the bucket
+     */
+    Commands& getBucket(size_t index);
+};
+
+};
+
+#endif // _EVENTS_COMMANDQUEUE_H_
@@ -0,0 +1,166 @@
+#ifndef _EVENTS_CONTROLLERSNAPSHOT_H_
+#define _EVENTS_CONTROLLERSNAPSHOT_H_
+
+#include "main.h"
+#include "libIterativeRobot/events/EventListener.h"
+#include "libIterativeRobot/Storage.h"
+#include <cstdint>
+
+namespace libIterativeRobot {
+
+/**
+ * A ControllerSnapshot holds the state of one pros::Controller as of the start of the current EventScheduler update.
+ *
+ * JoystickButtons and JoystickChannels read their state from the snapshot of their controller instead of from the
+ * controller itself, so each button or channel is read from the controller once per update no matter how many
+ * triggers are bound to it. Only the buttons and channels that some trigger uses are read. Snapshots are created and
+ * captured by the EventScheduler; see EventScheduler::getControllerSnapshot().
+ *
+ * EventListeners can subscribe to a button or channel to be notified whenever a capture finds that it has changed.
+ * The state can also be set with apply() instead of being captured, which is how an InputReplay plays back recorded
+ * driver input.
+ */
+class ControllerSnapshot {
+  public:
+    /**
+     * @brief The number of analog channels on a controller
+     */
+    static const int kAnalogChannels = pros::E_CONTROLLER_ANALOG_RIGHT_Y + 1;
+  private:
+
+    /**
+     * @brief The controller the snapshot is of
+     */
+    pros::Controller* controller;
+
+    /**
+     * @brief The buttons that are read on each capture, with one bit for each pros::controller_digital_e_t value
+     */
+    std::uint32_t usedDigital = 0;
+
+    /**
+     * @brief The analog channels that are read on each capture, with one bit for each pros::controller_analog_e_t value
+     */
+    std::uint32_t usedAnalog = 0;
+
+    /**
+     * @brief The state of each button as of the last capture, with one bit for each pros::controller_digital_e_t value
+     */
+    std::uint32_t digital = 0;
+
+    /**
+     * @brief The value of each analog channel as of the last capture
+     */
+    std::int32_t analog[kAnalogChannels] = {};
+
+    /**
+     * @brief An EventListener to notify when a button or channel changes
+     */
+    struct Subscription {
+      EventListener* listener;
+      bool analog;
+      std::uint8_t input;
+    };
+
+    /**
+     * @brief Every subscription to a button or channel
+     */
+    Storage<Subscription, LIBITERATIVEROBOT_MAX_SUBSCRIPTIONS> subscriptions;
+  public:
+    /**
+     * @brief Creates a snapshot of a controller
+     * @param controller The controller to take snapshots of
+     */
+    ControllerSnapshot(pros::Controller* controller);
+
+    /**
+     * @brief Gets the controller the snapshot is of
+     * @return The controller
+     */
+    pros::Controller* getController();
+
+    /**
+     * @brief Adds a button to the ones read on each capture
+     * @param button The button to read
+     */
+    void useDigital(pros::controller_digital_e_t button);
+
+    /**
+     * @brief Adds an analog channel to the ones read on each capture
+     * @param channel The channel to read
+     */
+    void useAnalog(pros::controller_analog_e_t channel);
+
+    /**
+     * @brief Reads a button on each capture, and notifies an EventListener whenever a capture finds it has changed
+     * @param button The button to read
+     * @param listener The EventListener to notify
+     * @return True if the EventListener will be notified, false if there was no room for another subscription
+     */
+    bool subscribeDigital(pros::controller_digital_e_t button, EventListener* listener);
+
+    /**
+     * @brief Reads an analog channel on each capture, and notifies an EventListener whenever a capture finds it has
+     * changed
+     * @param channel The channel to read
+     * @param listener The EventListener to notify
+     * @return True if the EventListener will be notified, false if there was no room for another subscription
+     */
+    bool subscribeAnalog(pros::controller_analog_e_t channel, EventListener* listener);
+
+    /**
+     * @brief Stops notifying an EventListener of changes to any button or channel
+     *
+     * The buttons and channels it subscribed to are still read on each capture.
+     *
+     * @param listener The EventListener to stop notifying
+     */
+    void unsubscribe(EventListener* listener);
+
+    /**
+     * @brief Reads every button and channel in use from the controller
+     *
+     * Notifies the subscribers of every button and channel whose value is not the same as on the last capture. When
+     * nothing has changed, no subscriptions are visited.
+     */
+    void capture();
+
+    /**
+     * @brief Sets the state of every button and channel as if it had been captured
+     *
+     * Subscribers are notified of changes in the same way as by capture().
+     *
+     * @param digital The state of each button, with one bit for each pros::controller_digital_e_t value
+     * @param analog The value of each analog channel
+     */
+    void apply(std::uint32_t digital, const std::int32_t analog[kAnalogChannels]);
+
+    /**
+     * @brief Gets the state of every button as of the last capture
+     * @return The state of each button, with one bit for each pros::controller_digital_e_t value
+     */
+    std::uint32_t getDigitalBits();
+
+    /**
+     * @brief Gets the state of a button as of the last capture
+     * @param button The button, which must have been passed to useDigital()
+     * @return True if the button was pressed, false otherwise
+     */
+    bool getDigital(pros::controller_digital_e_t button);
+
+    /**
+     * @brief Gets the value of an analog channel as of the last capture
+     * @param channel The channel, which must have been passed to useAnalog()
+     * @return The value of the channel, from -127 to 127
+     */
+    std::int32_t getAnalog(pros::controller_analog_e_t channel);
+};
+
+/**
+ * The ControllerSnapshots the EventScheduler captures on each update, in the order they were created
+ */
+typedef Storage<ControllerSnapshot*, LIBITERATIVEROBOT_MAX_CONTROLLERS> ControllerSnapshots;
+
+};
+
+#endif // _EVENTS_CONTROLLERSNAPSHOT_H_
@@ -2,6 +2,8 @@
 #define _EVENTS_EVENTLISTENER_H_
 
 #include "main.h"
+#include "libIterativeRobot/events/Profiler.h"
+#include "libIterativeRobot/events/Tracer.h"
 
 namespace libIterativeRobot {
 
@@ -13,6 +15,43 @@ namespace libIterativeRobot {
 
 class EventListener {
   private:
+    /**
+     * @brief Whether or not the EventListener is registered with the EventScheduler
+     *
+     * Lets the EventScheduler ignore repeated registrations without searching its list of EventListeners
+     */
+    bool registered = false;
+
+    /**
+     * @brief The EventListener's index in the EventScheduler's list of EventListeners, while it is registered
+     *
+     * Lets the EventScheduler unregister the EventListener without searching for it
+     */
+    size_t listenerSlot = 0;
+
+    /**
+     * @brief Whether or not the EventScheduler checks the EventListener on every update
+     */
+    bool alwaysChecked = true;
+
+    /**
+     * @brief Whether or not notify() has been called since the EventListener was last checked
+     */
+    bool notified = false;
+
+#ifdef LIBITERATIVEROBOT_PROFILE
+    /**
+     * @brief How long the EventListener's checkConditions() method has taken when called by the EventScheduler
+     */
+    ListenerProfile profile;
+#endif
+
+#ifdef LIBITERATIVEROBOT_TRACE
+    /**
+     * @brief The EventListener's name id in traces, or 0 if it has not been traced yet
+     */
+    std::uint16_t traceId = 0;
+#endif
   protected:
     /**
      * @brief Creates a new EventListener
@@ -33,6 +72,21 @@ class EventListener {
      */
     EventListener();
 
+    /**
+     * @brief Unregisters the EventListener from the EventScheduler, so it is never checked after it is destroyed
+     */
+    virtual ~EventListener();
+
+    /**
+     * @brief Sets whether the EventScheduler checks the EventListener on every update
+     *
+     * An EventListener that is not always checked is only checked on the updates after notify() is called on it, so
+     * it costs nothing on updates where nothing it watches has changed. EventListeners are always checked by default.
+     *
+     * @param alwaysChecked True to check the EventListener on every update, false to only check it when notified
+     */
+    void setAlwaysChecked(bool alwaysChecked);
+
     /**
      * @brief Called repeatedly by the EventScheduler
      *
@@ -41,10 +95,38 @@ class EventListener {
      */
     virtual void checkConditions() = 0;
   public:
+    /**
+     * @brief Checks whether the EventListener is registered with the EventScheduler
+     * @return True if the EventScheduler checks the EventListener on every update, false otherwise
+     */
+    bool isRegistered();
+
+    /**
+     * @brief Has the EventScheduler check the EventListener on its next update
+     *
+     * Called by whatever an EventListener that is not always checked watches, such as a ControllerSnapshot, when it
+     * changes. Notifying an EventListener that is always checked does nothing.
+     */
+    void notify();
+
   /**
    * Accesses the checkConditions() method;
    */
   friend class EventScheduler;
+
+#ifdef LIBITERATIVEROBOT_PROFILE
+  /**
+   * Accesses the EventListener's profile
+   */
+  friend class Profiler;
+#endif
+
+#ifdef LIBITERATIVEROBOT_TRACE
+  /**
+   * Accesses the EventListener's trace name id
+   */
+  friend class Tracer;
+#endif
 };
 
 };
@@ -5,9 +5,17 @@
 #include "libIterativeRobot/commands/CommandGroup.h"
 #include "main.h"
 #include "libIterativeRobot/events/EventListener.h"
+#include "libIterativeRobot/events/CommandQueue.h"
+#include "libIterativeRobot/events/ControllerSnapshot.h"
+#include "libIterativeRobot/events/InputRecorder.h"
+#include "libIterativeRobot/events/InputReplay.h"
+#include "libIterativeRobot/events/SubmissionQueue.h"
+#include "libIterativeRobot/events/Telemetry.h"
 #include "libIterativeRobot/subsystems/Subsystem.h"
-#include <vector>
+#include "libIterativeRobot/subsystems/SubsystemMask.h"
+#include "libIterativeRobot/Storage.h"
 #include <algorithm>
+#include <cstdint>
 
 namespace libIterativeRobot {
 
@@ -17,10 +25,20 @@ namespace libIterativeRobot {
  *
  * In order for the EventScheduler to function correctly, EventScheduler->getInstance()->update() must be called
  * repeatedly during the autonomous period and the teleop period.
+ *
+ * With LIBITERATIVEROBOT_STATIC defined, every queue and buffer has the fixed capacity set by the LIBITERATIVEROBOT_MAX_
+ * macros in Storage.h, and the EventScheduler and its ControllerSnapshots live in static storage, so it never uses the
+ * heap. A Command or CommandGroup run while its queue is full is blocked, and the overflow is counted by
+ * StorageDiagnostics.
  */
 
 class EventScheduler {
   private:
+    /**
+     * @brief The CommandGroups in one of the EventScheduler's CommandGroup queues or buffers
+     */
+    typedef Storage<CommandGroup*, LIBITERATIVEROBOT_MAX_COMMAND_GROUPS> CommandGroups;
+
     /**
      * @brief The number of subsystems being tracked by the EventScheduler
      */
@@ -40,22 +58,85 @@ class EventScheduler {
     /**
      * @brief The subsystems the EventScheduler is tracking
      */
-    std::vector<Subsystem*> subsystems;
+    Storage<Subsystem*, LIBITERATIVEROBOT_MAX_SUBSYSTEMS> subsystems;
 
     /**
      * @brief The Eventlisteners the EventScheduler is tracking
      */
-    std::vector<EventListener*> eventListeners;
+    Storage<EventListener*, LIBITERATIVEROBOT_MAX_LISTENERS> eventListeners;
+
+    /**
+     * @brief The number of EventListeners that have been unregistered since eventListeners was last compacted
+     *
+     * Unregistered EventListeners are set to NULL, so that unregistering one while the EventListeners are being
+     * checked is safe, and are removed after the next check
+     */
+    size_t listenerHoles = 0;
+
+    /**
+     * @brief The EventListeners to check on the next update, with one bit for each slot in eventListeners
+     *
+     * The bit of an EventListener is set if it is always checked or has been notified since it was last checked, so
+     * EventListeners with nothing to do are skipped without being visited
+     */
+    Storage<std::uint32_t, (LIBITERATIVEROBOT_MAX_LISTENERS + 31) / 32> activeListeners;
+
+    /**
+     * @brief The number of checkConditions() calls made during the last update
+     */
+    size_t listenerChecks = 0;
+
+    /**
+     * @brief A snapshot of each controller that a JoystickButton or JoystickChannel reads from
+     */
+    ControllerSnapshots controllerSnapshots;
+
+#ifdef LIBITERATIVEROBOT_STATIC
+    /**
+     * @brief Storage for the ControllerSnapshots, which are built in place as controllers are asked for
+     */
+    alignas(ControllerSnapshot) unsigned char snapshotStorage[LIBITERATIVEROBOT_MAX_CONTROLLERS][sizeof(ControllerSnapshot)];
+
+    /**
+     * @brief The snapshot given out for controllers past LIBITERATIVEROBOT_MAX_CONTROLLERS
+     *
+     * It is never captured, so every button reads as released and every channel as centered.
+     */
+    ControllerSnapshot spareSnapshot{NULL};
+#endif
+
+    /**
+     * @brief The InputRecorder that records each capture, or NULL if input is not being recorded
+     */
+    InputRecorder* inputRecorder = NULL;
+
+    /**
+     * @brief The InputReplay that is played back instead of reading the controllers, or NULL if the controllers are read
+     */
+    InputReplay* inputReplay = NULL;
+
+    /**
+     * @brief The Telemetry that samples the end of each update, or NULL if nothing is sampled
+     */
+    Telemetry* telemetry = NULL;
 
     /**
      * @brief A queue for Commands for the EventScheduler to process
+     *
+     * Ordered from highest priority to lowest priority, and within a priority from most recent to oldest
      */
-    std::vector<Command*> commandQueue;
+    CommandQueue commandQueue;
 
     /**
      * @brief A queue for CommandGroups for the EventScheduler to process
      */
-    std::vector<CommandGroup*> commandGroupQueue;
+    CommandGroups commandGroupQueue;
+
+    /**
+     * @brief Requests to run or stop Commands and CommandGroups made from other tasks, carried out at the start of each
+     * update
+     */
+    SubmissionQueue submissionQueue;
 
     /**
      * @brief Stores Commands after they are added to the EventScheduler.
@@ -63,7 +144,7 @@ class EventScheduler {
      * It acts as a buffer for the commandQueue, since undefined behavior can occur if Commands are added to it while
      * the EventScheduler is looping through it. Its contents are eventually added to the commandQueue.
      */
-    std::vector<Command*> commandBuffer;
+    CommandQueue::Commands commandBuffer;
 
     /**
      * @brief Stores CommandGroups after they are added to the EventScheduler.
@@ -71,7 +152,7 @@ class EventScheduler {
      * It acts as a buffer for the commandGroupQueue, since undefined behavior can occur if CommandGroups are added
      * to it while the EventScheduler is looping through it. Its contents are eventuallt added to the commandGroupQueue
      */
-    std::vector<CommandGroup*> commandGroupBuffer;
+    CommandGroups commandGroupBuffer;
 
     /**
      * @brief Temporary storage while scheduling CommandGroups.
@@ -82,17 +163,19 @@ class EventScheduler {
      * scheduler, the contents of commandGroupBuffer are first moved to intermediateGroupBuffer, and then the CommandGroups in
      * intermediateGroupBuffer are scheduled. This process of dumping and scheduling is repeated until the commandGroupBuffer is empty.
      */
-    std::vector<CommandGroup*> intermediateGroupBuffer;
+    CommandGroups intermediateGroupBuffer;
 
     /**
      * @brief Stores Commands that the EventScheduler determines can run
      */
-    std::vector<Command*> toExecute;
+    CommandQueue::Commands toExecute;
 
     /**
-     * @brief Stores the indexes of Commands in the commandQueue that need to be run
+     * @brief The Subsystems that have already been claimed by a Command during the current update
+     *
+     * Kept as a member so that its storage is reused between updates instead of being reallocated every tick
      */
-    std::vector<size_t> indexes;
+    SubsystemMask usedSubsystems;
 
     /**
      * @brief Whether or not the default Commands have been added to the EventScheduler yet
@@ -107,7 +190,7 @@ class EventScheduler {
     /**
      * @brief Checks if a given Command is in the EventScheduler
      *
-     * Checks both the commandBuffer and commandQueue for the provided Command.
+     * Checks whether the Command's scheduler location is the commandBuffer or commandQueue, without searching either.
      *
      * @param aCommand The Command to search for
      * @return Whether the Command is found or not
@@ -117,13 +200,19 @@ class EventScheduler {
     /**
      * @brief Checks if a given CommandGroup is in the EventScheduler
      *
-     * Checks both the commandGroupBuffer and commandGroupQueue for the provided CommandGroup.
+     * Checks whether the CommandGroup's scheduler location is the commandGroupBuffer, intermediateGroupBuffer or
+     * commandGroupQueue, without searching any of them.
      *
      * @param aCommandGroup The CommandGroup to search for
      * @return Whether the CommandGroup is found or not
      */
     bool commandGroupInScheduler(CommandGroup* aCommandGroup);
 
+    /**
+     * @brief Carries out every request in the submissionQueue, in the order they were made
+     */
+    void drainSubmissions();
+
     /**
      * @brief Adds the commands in the commandBuffer to the commandQueue
      */
@@ -149,6 +238,30 @@ class EventScheduler {
      */
     void checkEventListeners();
 
+    /**
+     * @brief Sets or clears an EventListener's bit in activeListeners to match whether it needs to be checked
+     * @param eventListener The EventListener to update, which does nothing if it is not registered
+     */
+    void markListener(EventListener* eventListener);
+
+    /**
+     * @brief Captures the state of every controller in controllerSnapshots
+     *
+     * The state comes from the inputReplay instead of the controllers if there is one, and is recorded by the
+     * inputRecorder if there is one.
+     */
+    void captureControllers();
+
+    /**
+     * @brief Calls readInputs() on every Subsystem, in the order they were tracked
+     */
+    void readSubsystemInputs();
+
+    /**
+     * @brief Calls writeOutputs() on every Subsystem and flushes its CoalescedOutputs, in the order they were tracked
+     */
+    void writeSubsystemOutputs();
+
     /**
      * @brief Adds default commands if they have not yet been added
      */
@@ -161,7 +274,46 @@ class EventScheduler {
      *
      * @param commandGroups The vector to schedule CommandGroups from
      */
-    void scheduleCommandGroups(std::vector<CommandGroup*>* commandGroups);
+    void scheduleCommandGroups(CommandGroups* commandGroups);
+
+    /**
+     * @brief Adds a Command or CommandGroup to the end of a queue and records where it was added
+     *
+     * If the queue is full, the Command or CommandGroup is left out of the EventScheduler and its status is set to
+     * Blocked.
+     *
+     * @param command The Command or CommandGroup to add
+     * @param queue The queue to add it to
+     * @param location Which of the EventScheduler's queues or buffers the queue is
+     * @return True if it was added, false if the queue was full
+     */
+    template <typename T, typename Queue>
+    bool place(T* command, Queue* queue, Command::SchedulerLocation location);
+
+    /**
+     * @brief Removes a Command or CommandGroup from whichever queue or buffer it is in
+     *
+     * Its slot is set to NULL using the location recorded in the Command, so removal takes constant time.
+     *
+     * @param command The Command or CommandGroup to remove
+     */
+    void vacate(Command* command);
+
+    /**
+     * @brief Removes all NULL values from a queue while keeping the order of the remaining elements
+     *
+     * Commands and CommandGroups that finish or are interrupted during an update are set to NULL rather than erased
+     * individually, and then removed all at once with this method. The slot of each remaining element is updated.
+     *
+     * @param queue The queue to remove NULL values from
+     */
+    template <typename Queue>
+    void removeNull(Queue* queue);
+
+    /**
+     * Accesses markListener()
+     */
+    friend class EventListener;
   public:
     /**
      * @brief Gets the singleton instance of the EventScheduler
@@ -179,16 +331,105 @@ class EventScheduler {
      * requirements. If a Command shares a requirement with a higher priority Command, it cannot run. If it is already
      * running, it is interrupted. If a Command can run but it has not yet been executed, it is initialized. It is
      * then run and if it has finished, its end() method is called. The same logic is applied to CommandGroups.
+     * Each Subsystem's readInputs() is called before any of this, and its writeOutputs() after all of it, followed by
+     * a flush of its CoalescedOutputs. A Telemetry set with setTelemetry() is sampled last.
      * This function is called automatically in RobotBase's method doOneTick.
      */
     void update();
 
     /**
      * @brief Adds an EventListener for the EventScheduler to keep track of
+     *
+     * EventListeners register themselves when they are created. Adding an EventListener that is already registered
+     * does nothing, so its checkConditions() method is never called more than once per update.
+     *
      * @param eventListener The EventListener to add
      */
     void addEventListener(EventListener* eventListener);
 
+    /**
+     * @brief Stops the EventScheduler from checking an EventListener
+     *
+     * EventListeners unregister themselves when they are destroyed. Unregistering an EventListener that is not
+     * registered does nothing, and it can be registered again later with addEventListener().
+     *
+     * @param eventListener The EventListener to remove
+     */
+    void removeEventListener(EventListener* eventListener);
+
+    /**
+     * @brief Gets the number of EventListeners the EventScheduler is checking
+     * @return The number of registered EventListeners
+     */
+    size_t getListenerCount();
+
+    /**
+     * @brief Gets the number of checkConditions() calls made during the last update
+     *
+     * Only EventListeners that are always checked or were notified are checked, so this is usually less than
+     * getListenerCount(). A number higher than expected points to EventListeners that are polled without being needed.
+     *
+     * @return The number of EventListener checks in the last update
+     */
+    size_t getListenerChecks();
+
+    /**
+     * @brief Asks the EventScheduler to run or stop a Command or CommandGroup at the start of its next update
+     *
+     * Unlike Command::run() and Command::stop(), this can be called from any task, including several at once, as long
+     * as the EventScheduler has already been created by the task that updates it. The request is carried out by
+     * calling run() or stop() from the EventScheduler's task, so it has the same effect as if it had been called there.
+     *
+     * @param command The Command or CommandGroup to run or stop
+     * @param request Whether to run or stop it
+     * @return True if the request was queued, false if LIBITERATIVEROBOT_SUBMISSION_CAPACITY requests were already
+     * waiting and it was dropped
+     */
+    bool submit(Command* command, SubmissionQueue::Request request);
+
+    /**
+     * @brief Gets the number of requests to submit() that were dropped because too many were waiting
+     * @return The number of dropped requests
+     */
+    std::uint32_t getDroppedSubmissions();
+
+    /**
+     * @brief Gets the snapshot of a controller that is captured at the start of every update
+     *
+     * The snapshot is created the first time a controller is asked for. Call useDigital() or useAnalog() on it for
+     * each button or channel that should be captured. With LIBITERATIVEROBOT_STATIC defined, controllers past
+     * LIBITERATIVEROBOT_MAX_CONTROLLERS share a snapshot that is never captured.
+     *
+     * @param controller The controller to get the snapshot of
+     * @return The controller's snapshot
+     */
+    ControllerSnapshot* getControllerSnapshot(pros::Controller* controller);
+
+    /**
+     * @brief Records the state of every controller on each update from now on
+     * @param recorder The InputRecorder to record to, or NULL to stop recording
+     */
+    void setInputRecorder(InputRecorder* recorder);
+
+    /**
+     * @brief Plays back recorded controller input on each update from now on, instead of reading the controllers
+     * @param replay The InputReplay to play back, or NULL to go back to reading the controllers
+     */
+    void setInputReplay(InputReplay* replay);
+
+    /**
+     * @brief Samples the channels of a Telemetry at the end of each update from now on
+     * @param telemetry The Telemetry to sample, or NULL to stop sampling
+     */
+    void setTelemetry(Telemetry* telemetry);
+
+    /**
+     * @brief Gets the running Command that requires a Subsystem
+     * @param subsystem The Subsystem
+     * @return The Command, or NULL if no running Command requires it
+     */
+    Command* getActiveCommand(Subsystem* subsystem);
+
     /**
      * @brief Adds a Command to the EventScheduler
      *
@@ -210,8 +451,7 @@ class EventScheduler {
     /**
      * @brief Removes a Command from the EventScheduler
      *
-     * The provided Command is interrupted, and then searched for in the commandBuffer and commandQueue. If it is found,
-     * it is removed.
+     * If the provided Command is in the commandBuffer or commandQueue, it is removed and then blocked or interrupted.
      *
      * @param command The Command to remove
      */
@@ -220,8 +460,7 @@ class EventScheduler {
     /**
      * @brief Removes a CommandGroup from the EventScheduler
      *
-     * The provided CommandGroup is interrupted, and then searched for in the commandGroupBuffer and Group. If it is
-     * found, it is removed.
+     * If the provided CommandGroup is in the EventScheduler, it is removed and then interrupted.
      *
      * @param commandGroup The CommandGroup to remove
      */
@@ -229,6 +468,9 @@ class EventScheduler {
 
     /**
      * @brief Adds a Subsystem for the EventScheduler to track
+     *
+     * The Subsystem is given the next free index, which is the bit that represents it in every SubsystemMask
+     *
      * @param aSubsystem The Subsystem to track
      */
     void trackSubsystem(Subsystem* aSubsystem);
@@ -243,6 +485,20 @@ class EventScheduler {
      * added, and if false, they are added
      */
     void initialize(bool noDefaultCommands = false);
+
+    /**
+     * @brief Preallocates storage for the EventScheduler's queues and buffers
+     *
+     * Once the EventScheduler has run for one update (so that default Commands are added), update() does not allocate
+     * any memory as long as the number of Commands and CommandGroups in the EventScheduler stays within the reserved
+     * capacity. This should be called in robotInit() to keep heap allocations out of the scheduler tick. It does
+     * nothing with LIBITERATIVEROBOT_STATIC defined, since the storage is already fixed.
+     *
+     * @param maxCommands The most Commands expected to be in the EventScheduler at once
+     * @param maxCommandGroups The most CommandGroups expected to be in the EventScheduler at once
+     * @param maxPriorities The most distinct Command priorities expected to be in use at once
+     */
+    void reserve(size_t maxCommands, size_t maxCommandGroups, size_t maxPriorities = 8);
 };
 
 };
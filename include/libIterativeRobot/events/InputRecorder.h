@@ -0,0 +1,127 @@
+#ifndef _EVENTS_INPUTRECORDER_H_
+#define _EVENTS_INPUTRECORDER_H_
+
+#include "main.h"
+#include "libIterativeRobot/events/ControllerSnapshot.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace libIterativeRobot {
+
+/**
+ * An InputRecorder records the controller snapshots the EventScheduler captures on each update, so that they can be
+ * played back later with an InputReplay, for example as an autonomous routine or to run a recorded match on the host.
+ * Pass one to EventScheduler::setInputRecorder() to start recording.
+ *
+ * Only the changes from one update to the next are stored. Controllers are identified by the order their snapshots
+ * were created in, which is the same from run to run as long as the robot program creates the same JoystickButtons and
+ * JoystickChannels in the same order. The recording is a stream of bytes, where each update is either part of a run of
+ * updates where nothing changed, or a list of changes:
+ *
+ *   0nnnnnnn                      n (1 to 127) updates in a row with no changes
+ *   1mcccccc wwwwwwww [d d] [a]*  a change to the snapshot with index c (0 to 63) in this update, followed by another
+ *                                 change in the same update if m is set. Bit 0 of w says the buttons changed, in which
+ *                                 case d d is a little-endian 16-bit mask of the buttons that changed, with bit 0 for
+ *                                 pros::E_CONTROLLER_DIGITAL_L1. Bits 1 to 4 of w say analog channels 0 to 3 changed,
+ *                                 and each one that did is followed by its new value as a signed byte
+ *
+ * A saved recording starts with the 4 bytes "LIRI", a version byte, a byte with the number of snapshots and a 32-bit
+ * little-endian count of updates, followed by the stream.
+ */
+class InputRecorder {
+  public:
+    /**
+     * @brief The first bytes of a saved recording
+     */
+    static const char kMagic[4];
+
+    /**
+     * @brief The version of the format that save() writes
+     */
+    static const std::uint8_t kVersion = 1;
+
+    /**
+     * @brief The button that bit 0 of a recorded button mask stands for
+     */
+    static const int kFirstButton = pros::E_CONTROLLER_DIGITAL_L1;
+  private:
+    /**
+     * @brief The encoded stream of changes
+     */
+    std::vector<std::uint8_t> data;
+
+    /**
+     * @brief The last recorded state of each snapshot
+     */
+    struct State {
+      std::uint32_t digital;
+      std::int32_t analog[ControllerSnapshot::kAnalogChannels];
+    };
+    std::vector<State> states;
+
+    /**
+     * @brief The number of updates recorded
+     */
+    std::uint32_t ticks = 0;
+
+    /**
+     * @brief The number of updates with no changes that have not been written to the stream yet
+     */
+    std::uint8_t idleRun = 0;
+
+    /**
+     * @brief Writes the pending run of updates with no changes to the stream
+     */
+    void flushIdleRun();
+  public:
+    /**
+     * @brief Creates an InputRecorder with an empty recording
+     * @param reserveBytes The number of bytes to preallocate for the stream, so recording does not allocate until it
+     * grows past them
+     */
+    InputRecorder(size_t reserveBytes = 0);
+
+    /**
+     * @brief Records the state of every snapshot for one update
+     *
+     * Called by the EventScheduler after it captures the controllers.
+     *
+     * @param snapshots The EventScheduler's snapshots, in the order they were created
+     */
+    void record(const ControllerSnapshots& snapshots);
+
+    /**
+     * @brief Discards the recording, so the next update is recorded as the first
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of updates recorded
+     * @return The number of updates
+     */
+    std::uint32_t getTicks();
+
+    /**
+     * @brief Gets the encoded stream of changes
+     * @return The stream, without the header that save() writes
+     */
+    const std::vector<std::uint8_t>& getData();
+
+    /**
+     * @brief Gets the number of snapshots that appear in the recording
+     * @return One more than the highest snapshot index recorded
+     */
+    std::uint8_t getSnapshotCount();
+
+    /**
+     * @brief Writes the recording to a file
+     * @param file The file to write to, which must have been opened in binary mode
+     * @return True if the whole recording was written, false otherwise
+     */
+    bool save(FILE* file);
+};
+
+};
+
+#endif // _EVENTS_INPUTRECORDER_H_
@@ -0,0 +1,119 @@
+#ifndef _EVENTS_INPUTREPLAY_H_
+#define _EVENTS_INPUTREPLAY_H_
+
+#include "main.h"
+#include "libIterativeRobot/events/ControllerSnapshot.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace libIterativeRobot {
+
+class InputRecorder;
+
+/**
+ * An InputReplay plays back driver input recorded by an InputRecorder. Pass one to EventScheduler::setInputReplay() and
+ * the EventScheduler applies the recorded state of each controller on every update instead of reading the controllers,
+ * so JoystickButtons, JoystickChannels and everything bound to them behave exactly as they did while recording. A
+ * recorded driver run can be played back as an autonomous routine this way, and a recorded match can be replayed on
+ * the host as fast as the scheduler can run.
+ *
+ * Once every recorded update has been played back, every button is released and every channel is centered until the
+ * replay is removed from the EventScheduler.
+ */
+class InputReplay {
+  private:
+    /**
+     * @brief The encoded stream of changes, in the format described in InputRecorder.h
+     */
+    std::vector<std::uint8_t> data;
+
+    /**
+     * @brief The number of updates in the recording
+     */
+    std::uint32_t ticks = 0;
+
+    /**
+     * @brief The number of updates played back
+     */
+    std::uint32_t tick = 0;
+
+    /**
+     * @brief The position of the next byte to read from the stream
+     */
+    size_t position = 0;
+
+    /**
+     * @brief The number of updates with no changes left in the current run
+     */
+    std::uint8_t idleRun = 0;
+
+    /**
+     * @brief The state of each snapshot as of the last update played back
+     */
+    struct State {
+      std::uint32_t digital;
+      std::int32_t analog[ControllerSnapshot::kAnalogChannels];
+    };
+    std::vector<State> states;
+
+    /**
+     * @brief Reads the next byte of the stream, or returns 0 if the stream has ended
+     */
+    std::uint8_t next();
+  public:
+    /**
+     * @brief Creates an empty InputReplay, which can be filled with load()
+     */
+    InputReplay();
+
+    /**
+     * @brief Creates an InputReplay of a recording
+     * @param recorder The InputRecorder holding the recording, which is copied
+     */
+    InputReplay(InputRecorder& recorder);
+
+    /**
+     * @brief Reads a recording written by InputRecorder::save()
+     * @param file The file to read, which must have been opened in binary mode
+     * @return True if a whole recording was read, false otherwise, in which case the InputReplay is left empty
+     */
+    bool load(FILE* file);
+
+    /**
+     * @brief Applies the recorded state of every snapshot for the next update
+     *
+     * Called by the EventScheduler in place of capturing the controllers. Snapshots that were not in the recording are
+     * left as they are.
+     *
+     * @param snapshots The EventScheduler's snapshots, in the order they were created
+     */
+    void apply(const ControllerSnapshots& snapshots);
+
+    /**
+     * @brief Starts playing back from the first recorded update again
+     */
+    void rewind();
+
+    /**
+     * @brief Checks whether every recorded update has been played back
+     * @return True if the replay has finished, false otherwise
+     */
+    bool isFinished();
+
+    /**
+     * @brief Gets the number of updates in the recording
+     * @return The number of updates
+     */
+    std::uint32_t getTicks();
+
+    /**
+     * @brief Gets the number of updates played back
+     * @return The number of updates played back since the start or the last rewind()
+     */
+    std::uint32_t getTick();
+};
+
+};
+
+#endif // _EVENTS_INPUTREPLAY_H_
@@ -3,6 +3,7 @@
 
 #include "main.h"
 #include "./Trigger.h"
+#include "./ControllerSnapshot.h"
 #include "../commands/Command.h"
 #include <vector>
 
@@ -12,6 +13,9 @@ namespace libIterativeRobot {
  * The JoystickButton class is used to run and stop Commands and CommandGroups using a joystick button.
  * It implements the Trigger class and inherits all of its events. The events associated with it are: when the button
  * is pressed, while the button is being held, when the button is released, and while the button is released.
+ *
+ * A JoystickButton is notified by its controller's snapshot when the button changes, so one that is only bound to
+ * presses and releases is not checked on updates where the button has not changed.
  */
 
 class JoystickButton : public Trigger {
@@ -21,6 +25,11 @@ class JoystickButton : public Trigger {
      */
     pros::Controller* controller;
 
+    /**
+     * @brief The snapshot of the controller that the button's state is read from
+     */
+    ControllerSnapshot* snapshot;
+
     /**
      * @brief The button with which the Trigger's state is associated with
      */
@@ -35,8 +44,17 @@ class JoystickButton : public Trigger {
      */
     JoystickButton(pros::Controller* controller, pros::controller_digital_e_t button);
 
+    /**
+     * @brief Stops the controller's snapshot from notifying the JoystickButton
+     */
+    ~JoystickButton();
+
     /**
      * @brief Gets the state of the button
+     *
+     * The state is read from the controller's snapshot, so it is the state as of the start of the last EventScheduler
+     * update.
+     *
      * @return True if the button is pressed, false otherwise
      */
     bool getState();
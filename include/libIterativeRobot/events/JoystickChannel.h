@@ -4,6 +4,7 @@
 #include "api.h"
 #include "main.h"
 #include "./Trigger.h"
+#include "./ControllerSnapshot.h"
 #include "../commands/Command.h"
 
 namespace libIterativeRobot {
@@ -13,6 +14,9 @@ namespace libIterativeRobot {
  * It implements the Trigger class and inherits all of its events. The events associated with it are: when the channel
  * passes a threshold forwards, while the channel is past the threshold, when the channel passes the threshold
  * backwards, and while the button is within the threshold.
+ *
+ * A JoystickChannel is notified by its controller's snapshot when the channel's value changes, so one that is only
+ * bound to passing the threshold is not checked on updates where the value has not changed.
  */
 
 class JoystickChannel : public Trigger {
@@ -22,6 +26,11 @@ class JoystickChannel : public Trigger {
      */
     pros::Controller* controller;
 
+    /**
+     * @brief The snapshot of the controller that the channel's value is read from
+     */
+    ControllerSnapshot* snapshot;
+
     /**
      * @brief The channel with which the Trigger's state is associated with
      */
@@ -46,8 +55,17 @@ class JoystickChannel : public Trigger {
      */
     JoystickChannel(pros::Controller* controller, pros::controller_analog_e_t channel);
 
+    /**
+     * @brief Stops the controller's snapshot from notifying the JoystickChannel
+     */
+    ~JoystickChannel();
+
     /**
      * @brief Checks if the channel is past the threshold
+     *
+     * The value is read from the controller's snapshot, so it is the value as of the start of the last EventScheduler
+     * update.
+     *
      * @return True if the channel is past the threshold, false if it is within the threshold
      */
     bool getState();
@@ -0,0 +1,208 @@
+#ifndef _EVENTS_PROFILER_H_
+#define _EVENTS_PROFILER_H_
+
+/**
+ * Profiling is opt-in. Define LIBITERATIVEROBOT_PROFILE for the library and for every file that includes its headers
+ * (for example by adding -DLIBITERATIVEROBOT_PROFILE to EXTRA_CXXFLAGS in the Makefile) to have the EventScheduler time
+ * each Command, CommandGroup and EventListener it calls. Without it, the macros below expand to nothing, and Commands
+ * and EventListeners carry no profiling data.
+ */
+#ifdef LIBITERATIVEROBOT_PROFILE
+
+#include "main.h"
+#include "libIterativeRobot/Clock.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace libIterativeRobot {
+
+class Command;
+class EventListener;
+
+/**
+ * The time spent in one method of a Command or EventListener
+ */
+struct MethodProfile {
+  /**
+   * @brief The number of times the method has been called
+   */
+  std::uint32_t calls = 0;
+
+  /**
+   * @brief The total time spent in the method, in microseconds
+   */
+  std::uint64_t totalMicros = 0;
+
+  /**
+   * @brief The longest single call to the method, in microseconds
+   */
+  std::uint32_t maxMicros = 0;
+
+  /**
+   * @brief Records one call to the method
+   * @param micros The length of the call in microseconds
+   */
+  void record(std::uint32_t micros) {
+    calls++;
+    totalMicros += micros;
+    if (micros > maxMicros) {
+      maxMicros = micros;
+    }
+  }
+};
+
+/**
+ * The time spent in each method the EventScheduler calls on a Command or CommandGroup
+ */
+struct CommandProfile {
+  MethodProfile canRun;
+  MethodProfile initialize;
+  MethodProfile execute;
+  MethodProfile isFinished;
+  MethodProfile end;
+  MethodProfile interrupted;
+  MethodProfile blocked;
+
+  /**
+   * @brief Whether or not the Profiler has added the Command to its list of profiled Commands
+   */
+  bool tracked = false;
+};
+
+/**
+ * The time spent in an EventListener's checkConditions() method
+ */
+struct ListenerProfile {
+  MethodProfile checkConditions;
+
+  /**
+   * @brief Whether or not the Profiler has added the EventListener to its list of profiled EventListeners
+   */
+  bool tracked = false;
+};
+
+/**
+ * The Profiler keeps track of every Command, CommandGroup and EventListener the EventScheduler has timed. The timings
+ * themselves are stored in each Command and EventListener, so recording a call does not search for anything; only the
+ * first call on each object adds it to the Profiler's list.
+ */
+class Profiler {
+  private:
+    /**
+     * @brief An instance of the Profiler
+     */
+    static Profiler* instance;
+
+    /**
+     * @brief Creates a Profiler
+     */
+    Profiler();
+
+    /**
+     * @brief Every Command and CommandGroup that has been timed, in the order they were first timed
+     */
+    std::vector<Command*> commands;
+
+    /**
+     * @brief Every EventListener that has been timed, in the order they were first timed
+     */
+    std::vector<EventListener*> listeners;
+  public:
+    /**
+     * @brief Gets the singleton instance of the Profiler
+     * @return The Profiler instance
+     */
+    static Profiler* getInstance();
+
+    /**
+     * @brief Gets a Command's profile, adding the Command to the list of profiled Commands if it is not already in it
+     * @param command The Command or CommandGroup to get the profile of
+     * @return The Command's profile
+     */
+    CommandProfile& of(Command* command);
+
+    /**
+     * @brief Gets an EventListener's profile, adding it to the list of profiled EventListeners if it is not already
+     * in it
+     * @param listener The EventListener to get the profile of
+     * @return The EventListener's profile
+     */
+    ListenerProfile& of(EventListener* listener);
+
+    /**
+     * @brief Removes a Command or CommandGroup from the list of profiled Commands, for when it is destroyed
+     * @param command The Command to remove
+     */
+    void forget(Command* command);
+
+    /**
+     * @brief Removes an EventListener from the list of profiled EventListeners, for when it is destroyed
+     * @param listener The EventListener to remove
+     */
+    void forget(EventListener* listener);
+
+    /**
+     * @brief Gets every Command and CommandGroup that has been timed
+     * @return The profiled Commands, in the order they were first timed
+     */
+    const std::vector<Command*>& getCommands();
+
+    /**
+     * @brief Gets every EventListener that has been timed
+     * @return The profiled EventListeners, in the order they were first timed
+     */
+    const std::vector<EventListener*>& getListeners();
+
+    /**
+     * @brief Clears the timings of every profiled Command and EventListener
+     */
+    void reset();
+
+    /**
+     * @brief Prints the timings of every profiled Command and EventListener as a table
+     *
+     * Each row shows the number of calls, the total time and the longest call of each method, in microseconds.
+     * Commands are listed by type and address.
+     *
+     * @param file The file to print to, which is the terminal by default
+     */
+    void dump(FILE* file = stdout);
+};
+
+/**
+ * Times the rest of the enclosing scope and records it in a MethodProfile
+ */
+class ProfileScope {
+  private:
+    MethodProfile& method;
+    std::uint64_t start;
+  public:
+    ProfileScope(MethodProfile& method) : method(method), start(libIterativeRobot::micros()) {}
+    ~ProfileScope() {
+      method.record(libIterativeRobot::micros() - start);
+    }
+};
+
+};
+
+/**
+ * Times the rest of the enclosing scope as a call to one of a Command's methods
+ */
+#define LIBITERATIVEROBOT_PROFILE_COMMAND(command, method) \
+  libIterativeRobot::ProfileScope profileScope(libIterativeRobot::Profiler::getInstance()->of(command).method)
+
+/**
+ * Times the rest of the enclosing scope as a call to an EventListener's checkConditions()
+ */
+#define LIBITERATIVEROBOT_PROFILE_LISTENER(listener) \
+  libIterativeRobot::ProfileScope profileScope(libIterativeRobot::Profiler::getInstance()->of(listener).checkConditions)
+
+#else
+
+#define LIBITERATIVEROBOT_PROFILE_COMMAND(command, method)
+#define LIBITERATIVEROBOT_PROFILE_LISTENER(listener)
+
+#endif // LIBITERATIVEROBOT_PROFILE
+
+#endif // _EVENTS_PROFILER_H_
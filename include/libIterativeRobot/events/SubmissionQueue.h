@@ -0,0 +1,108 @@
+#ifndef _EVENTS_SUBMISSIONQUEUE_H_
+#define _EVENTS_SUBMISSIONQUEUE_H_
+
+#include "main.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * The number of requests the SubmissionQueue holds between two updates, which must be a power of two. Requests made
+ * while it is full are dropped and counted.
+ */
+#ifndef LIBITERATIVEROBOT_SUBMISSION_CAPACITY
+#define LIBITERATIVEROBOT_SUBMISSION_CAPACITY 64
+#endif
+
+namespace libIterativeRobot {
+
+class Command;
+
+/**
+ * The SubmissionQueue carries requests to run or stop Commands and CommandGroups from other tasks, such as a vision or
+ * odometry task, to the task running the EventScheduler, which carries them out at the start of its next update. Any
+ * number of tasks can push requests at once, while only the EventScheduler pops them.
+ *
+ * The queue is a fixed ring of slots, each with a sequence number that says whether it is free for the next push or
+ * holds a request for the next pop. Pushing claims a slot with a compare-and-swap on the push position and then
+ * publishes the request by advancing the slot's sequence number, so pushing never blocks, never allocates and never
+ * waits on the EventScheduler, and popping needs no atomic read-modify-write at all.
+ */
+class SubmissionQueue {
+  public:
+    /**
+     * @brief What a request asks the EventScheduler to do with its Command
+     */
+    enum class Request : std::uint8_t {
+      Run,
+      Stop
+    };
+  private:
+    /**
+     * @brief A slot in the ring
+     *
+     * The sequence number of slot i is i + n * capacity when the slot is free for the push at that position, and one
+     * more than that once the push has written its request.
+     */
+    struct Slot {
+      std::atomic<std::uint32_t> sequence;
+      Command* command;
+      Request request;
+    };
+
+    /**
+     * @brief The slots, where the request pushed at position p is in slot p % LIBITERATIVEROBOT_SUBMISSION_CAPACITY
+     */
+    Slot slots[LIBITERATIVEROBOT_SUBMISSION_CAPACITY];
+
+    /**
+     * @brief The position of the next push
+     */
+    std::atomic<std::uint32_t> pushPosition;
+
+    /**
+     * @brief The position of the next pop, which only the EventScheduler's task touches
+     */
+    std::uint32_t popPosition = 0;
+
+    /**
+     * @brief The number of requests dropped because the queue was full
+     */
+    std::atomic<std::uint32_t> dropped;
+  public:
+    /**
+     * @brief Creates an empty SubmissionQueue
+     */
+    SubmissionQueue();
+
+    /**
+     * @brief Adds a request to the back of the queue
+     *
+     * Can be called from any task, and from several tasks at once.
+     *
+     * @param command The Command or CommandGroup the request is for
+     * @param request Whether to run or stop it
+     * @return True if the request was added, false if the queue was full and the request was dropped
+     */
+    bool push(Command* command, Request request);
+
+    /**
+     * @brief Removes the request at the front of the queue
+     *
+     * Must only be called from the EventScheduler's task.
+     *
+     * @param command Set to the Command or CommandGroup the request is for
+     * @param request Set to whether to run or stop it
+     * @return True if a request was removed, false if the queue was empty
+     */
+    bool pop(Command*& command, Request& request);
+
+    /**
+     * @brief Gets the number of requests dropped because the queue was full
+     * @return The number of dropped requests
+     */
+    std::uint32_t getDropped();
+};
+
+};
+
+#endif // _EVENTS_SUBMISSIONQUEUE_H_
@@ -0,0 +1,297 @@
+#ifndef _EVENTS_TELEMETRY_H_
+#define _EVENTS_TELEMETRY_H_
+
+#include "main.h"
+#include "libIterativeRobot/events/TelemetryFormat.h"
+#include "libIterativeRobot/Storage.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * The most channels a Telemetry samples, including the update time
+ */
+#ifndef LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS
+#define LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS 32
+#endif
+
+/**
+ * The number of bytes of frames a Telemetry holds while they wait to be written, which must be a power of two
+ */
+#ifndef LIBITERATIVEROBOT_TELEMETRY_BUFFER
+#define LIBITERATIVEROBOT_TELEMETRY_BUFFER 4096
+#endif
+
+/**
+ * The number of updates between keyframes, which is how long a reader that missed a frame waits to pick up again
+ */
+#ifndef LIBITERATIVEROBOT_TELEMETRY_KEYFRAME
+#define LIBITERATIVEROBOT_TELEMETRY_KEYFRAME 50
+#endif
+
+/**
+ * The number of keyframes between layouts, which is how long a reader that joins partway through waits to start
+ */
+#ifndef LIBITERATIVEROBOT_TELEMETRY_LAYOUT
+#define LIBITERATIVEROBOT_TELEMETRY_LAYOUT 10
+#endif
+
+/**
+ * The number of milliseconds between writes of the buffered frames
+ */
+#ifndef LIBITERATIVEROBOT_TELEMETRY_WRITE_RATE
+#define LIBITERATIVEROBOT_TELEMETRY_WRITE_RATE 20
+#endif
+
+namespace libIterativeRobot {
+
+class Command;
+class Subsystem;
+
+/**
+ * Telemetry streams the state of the robot program off the brain once per update, without the cost of printf() in the
+ * EventScheduler's task. Pass one to EventScheduler::setTelemetry() to start sampling.
+ *
+ * At the end of every update, the Telemetry samples each of its channels: the time the update took, the Status of each
+ * Command added with addCommand(), which Command is using each Subsystem added with addSubsystem(), and each value
+ * added with addValue(). Only the channels that changed since the last update are encoded, as the difference from
+ * their last value, so a frame for an update where little changes is a few bytes. The frames are described in
+ * TelemetryFormat.h, and tools/telemetryToCsv turns a saved stream into a CSV file with a row for each update.
+ *
+ * Frames are held in a fixed buffer, and a task at a low priority writes them out every
+ * LIBITERATIVEROBOT_TELEMETRY_WRITE_RATE milliseconds, so sampling never waits for the serial port. If the buffer is
+ * full, the frame is dropped and counted, and the next update is sent as a keyframe. Sampling does not allocate.
+ */
+class Telemetry {
+  private:
+    /**
+     * @brief A value sampled once per update
+     */
+    struct Channel {
+      TelemetryChannelKind kind;
+      char name[32];
+      float scale;
+
+      /**
+       * @brief The Command, Subsystem or double the channel samples, depending on its kind
+       */
+      const void* source;
+
+      /**
+       * @brief The value sampled in the last update, which the next one is encoded against
+       */
+      std::int64_t last;
+    };
+
+    /**
+     * @brief The most bytes a single frame can take before it is COBS encoded
+     */
+    static constexpr size_t kMaxFrame = 16 + LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS * (6 + sizeof(Channel::name));
+
+    /**
+     * @brief The channels, with the update time first
+     */
+    Storage<Channel, LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS> channels;
+
+    /**
+     * @brief A frame being encoded, and the same frame after COBS encoding
+     */
+    std::uint8_t frame[kMaxFrame];
+    std::uint8_t encoded[cobsMaxLength(kMaxFrame) + 1];
+
+    /**
+     * @brief The frames waiting to be written
+     *
+     * The EventScheduler's task adds to head and the writer task removes from tail. Both only ever count up, and
+     * their difference is the number of bytes waiting.
+     */
+    std::uint8_t buffer[LIBITERATIVEROBOT_TELEMETRY_BUFFER];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+
+    /**
+     * @brief Where frames are written
+     */
+    FILE* output = stdout;
+
+    /**
+     * @brief When the current update started, in microseconds
+     */
+    std::uint64_t updateStart = 0;
+
+    /**
+     * @brief The number of updates sampled
+     */
+    std::uint32_t samples = 0;
+
+    /**
+     * @brief The number of updates until the next keyframe, and the number of keyframes until the next layout
+     */
+    std::uint32_t untilKeyframe = 0;
+    std::uint32_t untilLayout = 0;
+
+    /**
+     * @brief The number of frames dropped because the buffer was full
+     */
+    std::atomic<std::uint32_t> dropped;
+
+    /**
+     * @brief The number of bytes written to the output
+     */
+    std::atomic<std::uint32_t> written;
+
+    /**
+     * @brief The priority the writer task is started with
+     */
+    std::uint32_t priority = TASK_PRIORITY_MIN + 1;
+
+    /**
+     * @brief The writer task
+     */
+    pros::task_t task = NULL;
+
+    /**
+     * @brief Writes the buffered frames every LIBITERATIVEROBOT_TELEMETRY_WRITE_RATE milliseconds
+     * @param parameter The Telemetry
+     */
+    static void runTask(void* parameter);
+
+    /**
+     * @brief Adds a channel, unless there are already LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS
+     * @return True if the channel was added
+     */
+    bool addChannel(TelemetryChannelKind kind, const char* name, float scale, const void* source);
+
+    /**
+     * @brief Reads a channel's current value
+     */
+    std::int64_t read(const Channel& channel, std::uint32_t updateMicros);
+
+    /**
+     * @brief Encodes a Layout frame describing every channel
+     * @return The length of the frame
+     */
+    size_t encodeLayout();
+
+    /**
+     * @brief Adds a checksum to a frame, COBS encodes it and adds it to the buffer
+     * @param length The length of the frame, without its checksum
+     * @return True if it was added, false if there was no room and it was dropped
+     */
+    bool enqueue(size_t length);
+
+    /**
+     * @brief Notes the time at the start of an update
+     *
+     * Called by the EventScheduler.
+     */
+    void beginUpdate();
+
+    /**
+     * @brief Samples every channel and adds a frame with the ones that changed to the buffer
+     *
+     * Called by the EventScheduler at the end of every update.
+     */
+    void sample();
+
+    /**
+     * @brief Calls beginUpdate() and sample()
+     */
+    friend class EventScheduler;
+  public:
+    /**
+     * @brief Creates a Telemetry with just the update time channel
+     */
+    Telemetry();
+
+    /**
+     * @brief Adds a channel with the Status of a Command
+     *
+     * The Command is also named by this channel wherever it is the active Command of a Subsystem.
+     *
+     * @param name The name of the channel, of which the first 31 characters are kept
+     * @param command The Command
+     * @return True if the channel was added, false if there are already LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS
+     */
+    bool addCommand(const char* name, Command* command);
+
+    /**
+     * @brief Adds a channel with the running Command that requires a Subsystem
+     * @param name The name of the channel, of which the first 31 characters are kept
+     * @param subsystem The Subsystem
+     * @return True if the channel was added, false if there are already LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS
+     */
+    bool addSubsystem(const char* name, Subsystem* subsystem);
+
+    /**
+     * @brief Adds a channel with a value the robot program keeps up to date
+     *
+     * The value is read at the end of every update, multiplied by the scale and rounded, so the scale sets the
+     * precision it is sent with: 100 for hundredths, for example. A value that changes by less than that does not
+     * take up any room in a frame.
+     *
+     * @param name The name of the channel, of which the first 31 characters are kept
+     * @param value The value, which must last as long as the Telemetry
+     * @param scale What the value is multiplied by before it is rounded
+     * @return True if the channel was added, false if there are already LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS
+     */
+    bool addValue(const char* name, const double* value, float scale = 1000);
+
+    /**
+     * @brief Sets where frames are written
+     *
+     * Frames go to stdout, which is the USB serial port, unless this is called before start().
+     *
+     * @param file The file to write to
+     */
+    void setOutput(FILE* file);
+
+    /**
+     * @brief Sets the priority the writer task is started with
+     *
+     * The task runs just above the lowest priority unless this is called, so it only writes when nothing else needs
+     * to run.
+     *
+     * @param priority The task priority
+     */
+    void setPriority(std::uint32_t priority);
+
+    /**
+     * @brief Starts the writer task, if it is not running already
+     *
+     * If the output is stdout, the serial port's own COBS encoding is turned off with serctl(), since frames are
+     * already encoded and anything else printed to stdout is passed through for the reader to skip.
+     */
+    void start();
+
+    /**
+     * @brief Writes the buffered frames to the output
+     *
+     * Called by the writer task. Should only be called from one task at a time.
+     *
+     * @return The number of bytes written
+     */
+    size_t flush();
+
+    /**
+     * @brief Gets the number of updates sampled
+     * @return The number of updates
+     */
+    std::uint32_t getSamples();
+
+    /**
+     * @brief Gets the number of frames dropped because the buffer was full
+     * @return The number of dropped frames
+     */
+    std::uint32_t getDroppedFrames();
+
+    /**
+     * @brief Gets the number of bytes written to the output
+     * @return The number of bytes
+     */
+    std::uint32_t getBytesWritten();
+};
+
+};
+
+#endif // _EVENTS_TELEMETRY_H_
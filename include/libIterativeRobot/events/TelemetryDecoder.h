@@ -0,0 +1,158 @@
+#ifndef _EVENTS_TELEMETRYDECODER_H_
+#define _EVENTS_TELEMETRYDECODER_H_
+
+#include "libIterativeRobot/events/TelemetryFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace libIterativeRobot {
+
+/**
+ * A channel of a telemetry stream, as described by its last Layout frame
+ */
+struct TelemetryChannelInfo {
+  TelemetryChannelKind kind;
+  float scale;
+  std::string name;
+};
+
+/**
+ * A TelemetryDecoder reads the stream a Telemetry writes, as described in TelemetryFormat.h, and passes each update
+ * it finds to row(). It does not depend on PROS, so it runs on the host, for example in tools/telemetryToCsv.
+ *
+ * The stream can be fed in pieces of any size, starting anywhere. Frames with a bad checksum are skipped, along with
+ * anything else mixed into the stream such as printf() text. Nothing is passed to row() until a Layout and then a
+ * Keyframe have been read, and after a gap in the updates nothing is passed on until the next Keyframe, so every row
+ * has the values the robot sampled.
+ */
+class TelemetryDecoder {
+  private:
+    /**
+     * @brief The bytes of the frame being read, up to the next zero byte, and the same frame once decoded
+     */
+    std::vector<std::uint8_t> pending;
+    std::vector<std::uint8_t> decoded;
+
+    /**
+     * @brief The channels from the last Layout frame, and their values as of the last update read
+     */
+    std::vector<TelemetryChannelInfo> channels;
+    std::vector<std::int64_t> values;
+
+    /**
+     * @brief Whether values is up to date with the stream, and the number of the update it is from
+     */
+    bool synced = false;
+    std::uint32_t lastUpdate = 0;
+
+    /**
+     * @brief The number of frames read, the number skipped because they were damaged, and the number of Samples
+     * skipped while waiting for a Keyframe
+     */
+    std::uint32_t frames = 0;
+    std::uint32_t badFrames = 0;
+    std::uint32_t skippedSamples = 0;
+
+    /**
+     * @brief Reads the frame in pending
+     */
+    void readFrame();
+
+    /**
+     * @brief Reads a Layout frame's body
+     * @return False if the frame is malformed
+     */
+    bool readLayout(const std::uint8_t* body, size_t length);
+
+    /**
+     * @brief Reads a Keyframe or Sample frame's body
+     * @return False if the frame is malformed
+     */
+    bool readSample(const std::uint8_t* body, size_t length, bool keyframe);
+  protected:
+    /**
+     * @brief Called when a Layout frame with different channels from the last one is read
+     * @param channels The channels
+     */
+    virtual void layout(const std::vector<TelemetryChannelInfo>& channels);
+
+    /**
+     * @brief Called for each update read
+     * @param update The number of the update, counted from when the Telemetry started sampling
+     * @param values The value of each channel, before it is divided by its scale
+     */
+    virtual void row(std::uint32_t update, const std::vector<std::int64_t>& values);
+  public:
+    virtual ~TelemetryDecoder() {}
+
+    /**
+     * @brief Reads more of the stream, calling layout() and row() for what it contains
+     * @param data The bytes
+     * @param size The number of bytes
+     */
+    void feed(const std::uint8_t* data, size_t size);
+
+    /**
+     * @brief Gets the channels from the last Layout frame read
+     * @return The channels, with the update time first
+     */
+    const std::vector<TelemetryChannelInfo>& getChannels() const;
+
+    /**
+     * @brief Formats a value of a channel for people to read
+     *
+     * Statuses are written as their name, active Commands as the name of their channel, and values are divided by
+     * their scale.
+     *
+     * @param channel The index of the channel
+     * @param value The value, as passed to row()
+     * @return The formatted value
+     */
+    std::string format(size_t channel, std::int64_t value) const;
+
+    /**
+     * @brief Gets the number of frames read, including damaged ones
+     * @return The number of frames
+     */
+    std::uint32_t getFrames() const;
+
+    /**
+     * @brief Gets the number of frames skipped because they were damaged
+     * @return The number of damaged frames
+     */
+    std::uint32_t getBadFrames() const;
+
+    /**
+     * @brief Gets the number of Samples skipped while waiting for a Keyframe after a gap
+     * @return The number of skipped Samples
+     */
+    std::uint32_t getSkippedSamples() const;
+};
+
+/**
+ * A TelemetryCsv writes each update in a telemetry stream as a line of CSV, after a header line with the name of each
+ * channel. The header is written again whenever the channels change.
+ */
+class TelemetryCsv : public TelemetryDecoder {
+  private:
+    /**
+     * @brief Where the CSV is written
+     */
+    FILE* output;
+  protected:
+    void layout(const std::vector<TelemetryChannelInfo>& channels);
+    void row(std::uint32_t update, const std::vector<std::int64_t>& values);
+  public:
+    /**
+     * @brief Creates a TelemetryCsv
+     * @param output Where to write the CSV
+     */
+    TelemetryCsv(FILE* output);
+};
+
+};
+
+#endif // _EVENTS_TELEMETRYDECODER_H_
@@ -0,0 +1,161 @@
+#ifndef _EVENTS_TELEMETRYFORMAT_H_
+#define _EVENTS_TELEMETRYFORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The layout of the stream Telemetry writes, and the encodings it uses. This header does not depend on PROS, so host
+ * tools such as tools/telemetryToCsv.cpp can read the stream with it.
+ *
+ * The stream is a series of frames. Each frame is COBS encoded, so it contains no zero bytes, and is followed by a zero
+ * byte, so a reader can find the start of the next frame from anywhere in the stream, even if other output such as
+ * printf() text is mixed in. A decoded frame is a TelemetryFrameType byte, the body, and a Fletcher-16 checksum of the
+ * type and body, low byte first. A frame whose checksum does not match is skipped.
+ *
+ * A Layout frame's body is the format version byte, the number of channels as a varint, and for each channel its
+ * TelemetryChannelKind byte, its scale as a 32-bit float, the length of its name as a byte, and the name's characters.
+ * Channel 0 is always the update time.
+ *
+ * A Sample or Keyframe frame's body is the update number as a varint, a bitmask with a bit per channel (lowest bit of
+ * the first byte is channel 0) of the channels that changed, and a zigzag varint for each channel that changed, in
+ * order. In a Keyframe, each is the channel's value; in a Sample, it is the difference from the channel's value in the
+ * previous update. A reader that misses a Sample, which it sees as a gap in the update numbers, waits for the next
+ * Keyframe. Every Keyframe is sent right after a Layout whenever the channels change, and a Layout is sent again every
+ * so often for readers that join partway through.
+ */
+namespace libIterativeRobot {
+
+/**
+ * @brief The kinds of frame in a telemetry stream
+ */
+enum TelemetryFrameType : std::uint8_t {
+  TelemetryLayout = 'L',
+  TelemetryKeyframe = 'K',
+  TelemetrySample = 'S'
+};
+
+/**
+ * @brief What a telemetry channel samples
+ */
+enum class TelemetryChannelKind : std::uint8_t {
+  UpdateTime,    // The time the EventScheduler's update took, in microseconds
+  CommandStatus, // The Status of a Command, as a number
+  ActiveCommand, // The running Command that requires a Subsystem: the index of its CommandStatus channel, 0 for none,
+                 // or -1 for a Command without a channel
+  Value          // A user's value, multiplied by the channel's scale and rounded
+};
+
+const std::uint8_t TelemetryVersion = 1;
+
+/**
+ * @brief Maps signed numbers to unsigned ones so that numbers near zero, positive or negative, are small
+ */
+inline std::uint64_t zigzagEncode(std::int64_t value) {
+  return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+}
+
+inline std::int64_t zigzagDecode(std::uint64_t value) {
+  return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+}
+
+/**
+ * @brief Writes a number 7 bits at a time, lowest first, with the top bit of each byte set if more follow
+ * @return The number of bytes written, at most 10
+ */
+inline size_t varintEncode(std::uint64_t value, std::uint8_t* out) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = std::uint8_t(value | 0x80);
+    value >>= 7;
+  }
+  out[length++] = std::uint8_t(value);
+  return length;
+}
+
+/**
+ * @brief Reads a number written by varintEncode()
+ * @return The number of bytes read, or 0 if the number runs past the end
+ */
+inline size_t varintDecode(const std::uint8_t* in, size_t available, std::uint64_t& value) {
+  value = 0;
+  for (size_t i = 0; i < available && i < 10; i++) {
+    value |= std::uint64_t(in[i] & 0x7f) << (7 * i);
+    if ((in[i] & 0x80) == 0) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Computes the Fletcher-16 checksum of some bytes
+ */
+inline std::uint16_t telemetryChecksum(const std::uint8_t* data, size_t length) {
+  std::uint16_t low = 0, high = 0;
+  for (size_t i = 0; i < length; i++) {
+    low = (low + data[i]) % 255;
+    high = (high + low) % 255;
+  }
+  return std::uint16_t(high << 8 | low);
+}
+
+/**
+ * @brief The most bytes COBS encoding can turn a frame of a given length into
+ */
+inline constexpr size_t cobsMaxLength(size_t length) {
+  return length + length / 254 + 1;
+}
+
+/**
+ * @brief COBS encodes bytes, replacing every zero with the distance to the next one
+ * @param in The bytes to encode
+ * @param length The number of bytes to encode
+ * @param out Where to write at most cobsMaxLength(length) bytes, none of them zero
+ * @return The number of bytes written
+ */
+inline size_t cobsEncode(const std::uint8_t* in, size_t length, std::uint8_t* out) {
+  size_t code = 0, written = 1;
+  std::uint8_t distance = 1;
+  for (size_t i = 0; i < length; i++) {
+    if (in[i] != 0) {
+      out[written++] = in[i];
+      distance++;
+    }
+    if (in[i] == 0 || distance == 0xff) {
+      out[code] = distance;
+      code = written++;
+      distance = 1;
+    }
+  }
+  out[code] = distance;
+  return written;
+}
+
+/**
+ * @brief Decodes bytes written by cobsEncode(), without the zero that follows them
+ * @param in The encoded bytes
+ * @param length The number of encoded bytes
+ * @param out Where to write at most length bytes
+ * @return The number of bytes written, or 0 if the bytes are not valid COBS
+ */
+inline size_t cobsDecode(const std::uint8_t* in, size_t length, std::uint8_t* out) {
+  size_t read = 0, written = 0;
+  while (read < length) {
+    std::uint8_t distance = in[read++];
+    if (distance == 0 || read + distance - 1 > length) {
+      return 0;
+    }
+    for (std::uint8_t i = 1; i < distance; i++) {
+      out[written++] = in[read++];
+    }
+    if (distance != 0xff && read < length) {
+      out[written++] = 0;
+    }
+  }
+  return written;
+}
+
+};
+
+#endif // _EVENTS_TELEMETRYFORMAT_H_
@@ -0,0 +1,120 @@
+#ifndef _EVENTS_TRACEFORMAT_H_
+#define _EVENTS_TRACEFORMAT_H_
+
+#include <cstdint>
+
+/**
+ * The layout of the events the Tracer records and of the files Tracer::dump() writes. This header does not depend on
+ * PROS, so host tools such as tools/traceToChrome.cpp can read trace files with it.
+ *
+ * A trace file is a TraceFileHeader, followed by nameCount names, each a TraceName followed by its characters (with
+ * no terminating NUL), followed by eventCount TraceEvents from oldest to newest. Every value is stored in the byte order
+ * of the machine that wrote it, which is little-endian on the V5 brain.
+ */
+namespace libIterativeRobot {
+
+/**
+ * @brief The kinds of event the Tracer records
+ */
+enum class TraceEventType : std::uint8_t {
+  UpdateBegin,        // The EventScheduler started an update
+  UpdateEnd,          // The EventScheduler finished an update
+  CommandQueued,      // A Command or CommandGroup was added to the EventScheduler
+  CommandInitialized, // A Command or CommandGroup was initialized
+  ExecuteBegin,       // A Command or CommandGroup's execute() method was called
+  ExecuteEnd,         // A Command or CommandGroup's execute() method returned
+  CommandFinished,    // A Command or CommandGroup finished, and its end() method was called
+  CommandInterrupted, // A Command or CommandGroup was interrupted
+  CommandBlocked,     // A Command or CommandGroup was blocked
+  GroupStepAdvanced,  // A CommandGroup moved on to its next step; detail is the index of the new step
+  ListenerFired,      // A Trigger ran or stopped its Commands; detail is one of the TraceTriggerEvent values
+  Count
+};
+
+/**
+ * @brief The Trigger events a ListenerFired event can be for
+ */
+enum TraceTriggerEvent : std::uint16_t {
+  TraceWhileActive,
+  TraceWhenActivated,
+  TraceWhenDeactivated,
+  TraceWhileInactive
+};
+
+/**
+ * @brief One recorded event
+ */
+struct TraceEvent {
+  /**
+   * @brief When the event happened, in microseconds since the program started, wrapping every 71 minutes
+   */
+  std::uint32_t micros;
+
+  /**
+   * @brief The name id of the Command, CommandGroup or EventListener the event is about, 0 for none, or
+   * TraceOverflowObject for one first traced after every name id had been given out
+   */
+  std::uint16_t object;
+
+  /**
+   * @brief Extra information that depends on the type of event
+   */
+  std::uint16_t detail;
+
+  /**
+   * @brief The type of event, as a TraceEventType
+   */
+  std::uint8_t type;
+
+  std::uint8_t reserved[3];
+};
+
+/**
+ * @brief The start of a trace file
+ */
+struct TraceFileHeader {
+  /**
+   * @brief Always TraceMagic
+   */
+  char magic[4];
+
+  /**
+   * @brief The version of the trace format, which is TraceVersion
+   */
+  std::uint16_t version;
+
+  /**
+   * @brief The number of names after the header
+   */
+  std::uint16_t nameCount;
+
+  /**
+   * @brief The number of events after the names
+   */
+  std::uint32_t eventCount;
+
+  /**
+   * @brief The number of events that were overwritten before the file was written
+   */
+  std::uint32_t dropped;
+};
+
+/**
+ * @brief The name of a traced object, followed in the file by length characters
+ */
+struct TraceName {
+  std::uint16_t object;
+  std::uint16_t length;
+};
+
+const char TraceMagic[4] = {'L', 'I', 'R', 'T'};
+const std::uint16_t TraceVersion = 1;
+
+/**
+ * @brief The name id shared by every object first traced after the Tracer ran out of name ids
+ */
+const std::uint16_t TraceOverflowObject = 0xFFFF;
+
+};
+
+#endif // _EVENTS_TRACEFORMAT_H_
@@ -0,0 +1,207 @@
+#ifndef _EVENTS_TRACER_H_
+#define _EVENTS_TRACER_H_
+
+/**
+ * Tracing is opt-in. Define LIBITERATIVEROBOT_TRACE for the library and for every file that includes its headers (for
+ * example by adding -DLIBITERATIVEROBOT_TRACE to EXTRA_CXXFLAGS in the Makefile) to have the EventScheduler record
+ * what it does with each Command, CommandGroup and EventListener. Without it, the macros below expand to nothing, and
+ * Commands and EventListeners carry no tracing data.
+ */
+#ifdef LIBITERATIVEROBOT_TRACE
+
+#include "main.h"
+#include "libIterativeRobot/events/TraceFormat.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <typeinfo>
+
+/**
+ * The number of events the Tracer keeps, which must be a power of two. Once it is full, each new event overwrites
+ * the oldest one.
+ */
+#ifndef LIBITERATIVEROBOT_TRACE_CAPACITY
+#define LIBITERATIVEROBOT_TRACE_CAPACITY 4096
+#endif
+
+/**
+ * The number of Commands, CommandGroups and EventListeners the Tracer names. Events about objects first traced after
+ * this many have been named are all recorded with the name id TraceOverflowObject.
+ */
+#ifndef LIBITERATIVEROBOT_TRACE_OBJECTS
+#define LIBITERATIVEROBOT_TRACE_OBJECTS 256
+#endif
+
+namespace libIterativeRobot {
+
+class Command;
+class EventListener;
+
+/**
+ * The Tracer records events from the EventScheduler into a fixed-size ring buffer, with a timestamp from the brain's
+ * microsecond timer on each. Recording an event reserves a slot with a single atomic increment and never allocates or
+ * blocks, so events can be recorded from any task. The buffer can be written to a file with dump() and turned into a
+ * trace for chrome://tracing or Perfetto with tools/traceToChrome.
+ *
+ * Each Command, CommandGroup and EventListener is given a name id the first time an event about it is recorded, and its
+ * type and address are noted then. Its name is only written out from them when the trace is dumped, so objects can be
+ * destroyed before that.
+ */
+class Tracer {
+  private:
+    /**
+     * @brief An instance of the Tracer
+     */
+    static Tracer* instance;
+
+    /**
+     * @brief Creates a Tracer
+     */
+    Tracer();
+
+    /**
+     * @brief The recorded events, where event i is in slot i % LIBITERATIVEROBOT_TRACE_CAPACITY
+     */
+    TraceEvent events[LIBITERATIVEROBOT_TRACE_CAPACITY];
+
+    /**
+     * @brief The number of events recorded since the buffer was last cleared
+     */
+    std::atomic<std::uint32_t> head;
+
+    /**
+     * @brief Whether or not events are being recorded
+     */
+    std::atomic<bool> enabled;
+
+    /**
+     * @brief The address and type of the object each name id was given to, with the name ids starting from 1
+     */
+    const void* objects[LIBITERATIVEROBOT_TRACE_OBJECTS];
+    const std::type_info* types[LIBITERATIVEROBOT_TRACE_OBJECTS];
+
+    /**
+     * @brief The number of name ids given out
+     */
+    std::atomic<std::uint16_t> objectCount;
+
+    /**
+     * @brief Gives an object the next name id, or TraceOverflowObject if every name id has been given out
+     * @param object The object to name
+     * @param type The object's dynamic type
+     * @return The object's name id
+     */
+    std::uint16_t name(const void* object, const std::type_info& type);
+  public:
+    /**
+     * @brief Gets the singleton instance of the Tracer
+     * @return The Tracer instance
+     */
+    static Tracer* getInstance();
+
+    /**
+     * @brief Records an event about a Command or CommandGroup
+     * @param type The type of event
+     * @param command The Command or CommandGroup the event is about
+     * @param detail Extra information about the event
+     */
+    void record(TraceEventType type, Command* command, std::uint16_t detail = 0);
+
+    /**
+     * @brief Records an event about an EventListener
+     * @param type The type of event
+     * @param listener The EventListener the event is about
+     * @param detail Extra information about the event
+     */
+    void record(TraceEventType type, EventListener* listener, std::uint16_t detail = 0);
+
+    /**
+     * @brief Records an event that is not about any object, such as the start of an update
+     * @param type The type of event
+     */
+    void record(TraceEventType type);
+
+    /**
+     * @brief Starts or stops recording events
+     *
+     * Events are recorded from the start of the program unless this is called with false.
+     *
+     * @param enabled True to record events, false to ignore them
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Discards every recorded event
+     *
+     * Objects keep their name ids.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of events in the buffer
+     * @return The number of events that can be read with getEvent()
+     */
+    std::uint32_t getEventCount();
+
+    /**
+     * @brief Gets the number of events that were overwritten because the buffer was full
+     * @return The number of dropped events since the buffer was last cleared
+     */
+    std::uint32_t getDropped();
+
+    /**
+     * @brief Gets an event in the buffer
+     * @param index The index of the event, where 0 is the oldest
+     * @return The event
+     */
+    TraceEvent getEvent(std::uint32_t index);
+
+    /**
+     * @brief Gets the name id of a Command or CommandGroup, giving it one if it does not have one yet
+     * @param command The Command or CommandGroup
+     * @return Its name id, which is TraceOverflowObject if every name id had been given out before it was first traced
+     */
+    std::uint16_t of(Command* command);
+
+    /**
+     * @brief Gets the name id of an EventListener, giving it one if it does not have one yet
+     * @param listener The EventListener
+     * @return Its name id, which is TraceOverflowObject if every name id had been given out before it was first traced
+     */
+    std::uint16_t of(EventListener* listener);
+
+    /**
+     * @brief Writes the recorded events to a file in the format described in TraceFormat.h
+     *
+     * Events should not be recorded while the trace is written, so this is best called once the robot is disabled or
+     * after setEnabled(false). Objects that were first traced after every name id had been given out are written as
+     * a single name for TraceOverflowObject.
+     *
+     * @param file The file to write to, which must have been opened in binary mode
+     * @return True if the whole trace was written, false otherwise
+     */
+    bool dump(FILE* file);
+};
+
+};
+
+/**
+ * Records an event about a Command, CommandGroup or EventListener, with an optional detail
+ */
+#define LIBITERATIVEROBOT_TRACE_EVENT(type, ...) \
+  libIterativeRobot::Tracer::getInstance()->record(libIterativeRobot::TraceEventType::type, __VA_ARGS__)
+
+/**
+ * Records the start or end of an EventScheduler update
+ */
+#define LIBITERATIVEROBOT_TRACE_UPDATE(type) \
+  libIterativeRobot::Tracer::getInstance()->record(libIterativeRobot::TraceEventType::type)
+
+#else
+
+#define LIBITERATIVEROBOT_TRACE_EVENT(type, ...)
+#define LIBITERATIVEROBOT_TRACE_UPDATE(type)
+
+#endif // LIBITERATIVEROBOT_TRACE
+
+#endif // _EVENTS_TRACER_H_
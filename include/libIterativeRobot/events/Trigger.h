@@ -4,7 +4,8 @@
 #include "main.h"
 #include "./EventListener.h"
 #include "../commands/Command.h"
-#include <vector>
+#include "libIterativeRobot/Storage.h"
+#include <cstdint>
 
 namespace libIterativeRobot {
 
@@ -21,6 +22,11 @@ enum class Action {
  * or the transition from inactive to active; when the trigger is active; and when the trigger is inactive. Each of
  * these events can run or stop Commands and CommandGroups. At least one of the events associated with the Trigger will
  * constantly be called, usually either the Trigger being inactive or active.
+ *
+ * The activated and deactivated events are edge bindings, which only do something when the state changes, and the
+ * active and inactive events are level bindings, which do something on every check. A Trigger with only edge bindings
+ * does no work on checks where its state has not changed. If its state is read from something that calls notify() when
+ * it changes, such as a ControllerSnapshot, it can call setNotifiedOnChange() so it is not checked at all until then.
  */
 
 class Trigger : public EventListener {
@@ -46,42 +52,66 @@ class Trigger : public EventListener {
     /**
      * @brief Commands to run when the Trigger transitions from inactive to active
      */
-    std::vector<Command*> runWhenActivatedCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> runWhenActivatedCommands;
 
     /**
      * @brief Commands to run while the Trigger is active
      */
-    std::vector<Command*> runWhileActiveCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> runWhileActiveCommands;
 
     /**
      * @brief Commands to run when the Trigger transitions from active to inactive
      */
-    std::vector<Command*> runWhenDeactivatedCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> runWhenDeactivatedCommands;
 
     /**
      * @brief Commands to run while the Trigger is inactive
      */
-    std::vector<Command*> runWhileInactiveCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> runWhileInactiveCommands;
 
     /**
      * @brief Commands to stop when the Trigger transitions from inactive to active
      */
-    std::vector<Command*> stopWhenActivatedCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> stopWhenActivatedCommands;
 
     /**
      * @brief Commands to stop while the Trigger is active
      */
-    std::vector<Command*> stopWhileActiveCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> stopWhileActiveCommands;
 
     /**
      * @brief Commands to stop when the Trigger transitions from active to inactive
      */
-    std::vector<Command*> stopWhenDeactivatedCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> stopWhenDeactivatedCommands;
 
     /**
      * @brief Commands to stop while the Trigger is inactive
      */
-    std::vector<Command*> stopWhileInactiveCommands;
+    Storage<Command*, LIBITERATIVEROBOT_MAX_BINDINGS> stopWhileInactiveCommands;
+
+    /**
+     * @brief The bindings the Trigger has, as a combination of the BindingKind values
+     */
+    std::uint8_t bindings = 0;
+
+    /**
+     * @brief Whether or not the Trigger is notified whenever its state may have changed
+     */
+    bool notifiedOnChange = false;
+
+    /**
+     * @brief The kinds of binding a Trigger can have
+     */
+    enum BindingKind : std::uint8_t {
+      EdgeBinding = 1, // A binding on the activated or deactivated events
+      LevelBinding = 2 // A binding on the active or inactive events
+    };
+
+    /**
+     * @brief Records that the Trigger has a binding of a kind, and updates whether it needs to be checked every update
+     * @param binding The kind of binding that was added
+     */
+    void addBinding(BindingKind binding);
   protected:
     /**
      * @brief Creates a new Trigger
@@ -97,6 +127,16 @@ class Trigger : public EventListener {
      */
     void checkConditions();
 
+    /**
+     * @brief Sets whether the Trigger is notified whenever its state may have changed
+     *
+     * Should be called by Triggers whose getState() reads something that calls notify() when it changes. Such a
+     * Trigger is only checked after it is notified, unless it has level bindings, which need to be checked every update.
+     *
+     * @param notifiedOnChange True if the Trigger is notified of changes, false otherwise
+     */
+    void setNotifiedOnChange(bool notifiedOnChange);
+
     /**
      * @brief Sets a Command to be run or stopped when the Trigger is activated
      *
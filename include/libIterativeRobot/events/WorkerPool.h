@@ -0,0 +1,135 @@
+#ifndef _EVENTS_WORKERPOOL_H_
+#define _EVENTS_WORKERPOOL_H_
+
+#include "main.h"
+#include "libIterativeRobot/Storage.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * The number of worker tasks the WorkerPool starts unless WorkerPool::setWorkerCount() is called first. With
+ * LIBITERATIVEROBOT_STATIC defined, it is also the most that can be started.
+ */
+#ifndef LIBITERATIVEROBOT_WORKER_TASKS
+#define LIBITERATIVEROBOT_WORKER_TASKS 2
+#endif
+
+namespace libIterativeRobot {
+
+class AsyncCommand;
+
+/**
+ * The WorkerPool runs the slow part of AsyncCommands on a set of worker tasks, so that the task running the
+ * EventScheduler is never held up by it.
+ *
+ * Each worker has a single slot for the AsyncCommand it is working on. The EventScheduler's task hands an AsyncCommand
+ * to an idle worker by filling its slot and notifying its task, and the worker empties the slot once the work is done,
+ * so no locks are needed. An AsyncCommand that finds every worker busy tries again on its next execute(). The workers
+ * are started the first time an AsyncCommand is handed to the pool, and wait for a task notification while idle.
+ */
+class WorkerPool {
+  private:
+    /**
+     * @brief An instance of the WorkerPool
+     */
+    static WorkerPool* instance;
+
+    /**
+     * @brief Creates a WorkerPool with no workers started
+     */
+    WorkerPool();
+
+    /**
+     * @brief A worker task and the AsyncCommand it is working on
+     */
+    struct Worker {
+      std::atomic<AsyncCommand*> job;
+      pros::task_t task;
+    };
+
+    /**
+     * @brief The workers that have been started
+     */
+    Storage<Worker*, LIBITERATIVEROBOT_WORKER_TASKS> workers;
+
+#ifdef LIBITERATIVEROBOT_STATIC
+    /**
+     * @brief The workers' slots, with room for LIBITERATIVEROBOT_WORKER_TASKS, which is the most that can be started
+     */
+    Worker workerStorage[LIBITERATIVEROBOT_WORKER_TASKS];
+#endif
+
+    /**
+     * @brief The number of workers to start
+     */
+    size_t workerCount = LIBITERATIVEROBOT_WORKER_TASKS;
+
+    /**
+     * @brief The priority workers are started with
+     */
+    std::uint32_t priority = TASK_PRIORITY_DEFAULT - 1;
+
+    /**
+     * @brief Runs AsyncCommands handed to a worker, forever
+     * @param parameter The Worker
+     */
+    static void runWorker(void* parameter);
+
+    /**
+     * @brief Hands an AsyncCommand to an idle worker, starting the workers first if they have not been started
+     *
+     * Must only be called from the EventScheduler's task.
+     *
+     * @param command The AsyncCommand whose work to do
+     * @return True if a worker took the AsyncCommand, false if every worker was busy
+     */
+    bool dispatch(AsyncCommand* command);
+
+    /**
+     * Accesses dispatch()
+     */
+    friend class AsyncCommand;
+  public:
+    /**
+     * @brief Gets the singleton instance of the WorkerPool
+     *
+     * If the WorkerPool instance does not yet exist, it is created.
+     *
+     * @return The WorkerPool instance
+     */
+    static WorkerPool* getInstance();
+
+    /**
+     * @brief Sets the number of worker tasks, which is how many AsyncCommands can do their work at once
+     *
+     * Workers are never stopped once started, so lowering the count after AsyncCommands have run has no effect.
+     *
+     * @param count The number of workers, at least 1
+     */
+    void setWorkerCount(size_t count);
+
+    /**
+     * @brief Sets the priority of worker tasks started from now on
+     *
+     * Workers run below the default task priority unless this is called, so the EventScheduler's task preempts them.
+     *
+     * @param priority The task priority
+     */
+    void setPriority(std::uint32_t priority);
+
+    /**
+     * @brief Gets the number of worker tasks that have been started
+     * @return The number of workers
+     */
+    size_t getStartedWorkers();
+
+    /**
+     * @brief Gets the number of workers currently doing work for an AsyncCommand
+     * @return The number of busy workers
+     */
+    size_t getBusyWorkers();
+};
+
+};
+
+#endif // _EVENTS_WORKERPOOL_H_
@@ -0,0 +1,98 @@
+#ifndef _PATHS_TRAJECTORY_H_
+#define _PATHS_TRAJECTORY_H_
+
+#include "libIterativeRobot/paths/TrajectoryFormat.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace libIterativeRobot {
+
+/**
+ * One point in a Trajectory, in the units of the drivetrain's wheels
+ */
+struct TrajectorySample {
+  double x = 0;
+  double y = 0;
+
+  /**
+   * @brief The heading in radians, from -pi to pi
+   */
+  double heading = 0;
+
+  double leftVelocity = 0;
+  double rightVelocity = 0;
+};
+
+/**
+ * A Trajectory reads a path stored in the format described in TrajectoryFormat.h, in place, without copying or
+ * decoding the samples ahead of time. The bytes it reads must outlive it, which they do when they are compiled into the
+ * program or kept by the TrajectoryCache.
+ */
+class Trajectory {
+  private:
+    /**
+     * @brief The header, copied out of the trajectory
+     */
+    TrajectoryFileHeader header;
+
+    /**
+     * @brief The first sample, which may not be aligned
+     */
+    const std::uint8_t* samples = NULL;
+  public:
+    /**
+     * @brief Reads a trajectory
+     * @param data The trajectory, starting with its header
+     * @param size The number of bytes in the trajectory
+     * @return True if it is a trajectory in this version of the format with every sample present, false if not
+     */
+    bool parse(const std::uint8_t* data, size_t size);
+
+    /**
+     * @brief Gets whether a trajectory has been read
+     * @return Whether parse() succeeded
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Gets the number of samples in the trajectory
+     * @return The number of samples
+     */
+    size_t getSampleCount() const;
+
+    /**
+     * @brief Gets the number of milliseconds between samples
+     * @return The sample period
+     */
+    std::uint32_t getPeriod() const;
+
+    /**
+     * @brief Gets how long the trajectory takes to follow
+     * @return The time of the last sample, in milliseconds
+     */
+    std::uint32_t getDuration() const;
+
+    /**
+     * @brief Gets the distance between the wheels the trajectory was generated for
+     * @return The track width
+     */
+    double getTrackWidth() const;
+
+    /**
+     * @brief Gets a sample
+     * @param index The index of the sample, which is clamped to the last one
+     * @return The sample
+     */
+    TrajectorySample getSample(size_t index) const;
+
+    /**
+     * @brief Gets the sample due at a time
+     * @param millis The number of milliseconds since the trajectory was started
+     * @return The last sample at or before that time, or the last sample once the trajectory is over
+     */
+    TrajectorySample getSampleAt(std::uint32_t millis) const;
+};
+
+};
+
+#endif // _PATHS_TRAJECTORY_H_
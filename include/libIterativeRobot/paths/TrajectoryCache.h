@@ -0,0 +1,124 @@
+#ifndef _PATHS_TRAJECTORYCACHE_H_
+#define _PATHS_TRAJECTORYCACHE_H_
+
+#include "main.h"
+#include "libIterativeRobot/Storage.h"
+#include "libIterativeRobot/paths/Trajectory.h"
+#include <cstdint>
+
+/**
+ * The most trajectories the TrajectoryCache holds
+ */
+#ifndef LIBITERATIVEROBOT_MAX_TRAJECTORIES
+#define LIBITERATIVEROBOT_MAX_TRAJECTORIES 16
+#endif
+
+namespace libIterativeRobot {
+
+/**
+ * The TrajectoryCache keeps the robot's trajectories by name, so that autonomous routines can start following them
+ * without generating them first.
+ *
+ * A trajectory can be added from bytes that stay in memory, such as an array that tools/generatePaths wrote into a
+ * source file and that is compiled into the program's flash, or one generated with TrajectoryGenerator during
+ * disabledInit(). Neither is copied. A trajectory can also be added from a file, for example on the SD card, in which
+ * case nothing is read until the first time it is asked for, and it is then kept in memory. Files can be loaded before
+ * the match by asking for them in disabledInit(). A file is read into memory from the heap, even with
+ * LIBITERATIVEROBOT_STATIC defined, so a program that must not allocate should compile its trajectories in instead.
+ */
+class TrajectoryCache {
+  private:
+    /**
+     * @brief An instance of the TrajectoryCache
+     */
+    static TrajectoryCache* instance;
+
+    /**
+     * @brief Creates an empty TrajectoryCache
+     */
+    TrajectoryCache();
+
+    /**
+     * @brief A trajectory and where it comes from
+     */
+    struct Entry {
+      const char* name;
+      const char* path; // NULL if the trajectory was added from memory
+      bool loaded; // Whether the trajectory has been read, or failed to be
+      Trajectory trajectory;
+    };
+
+    /**
+     * @brief The trajectories added so far
+     */
+    Storage<Entry, LIBITERATIVEROBOT_MAX_TRAJECTORIES> entries;
+
+    /**
+     * @brief The number of trajectories read from files, and the number of microseconds spent reading them
+     */
+    std::uint32_t filesLoaded = 0;
+    std::uint64_t loadMicros = 0;
+
+    /**
+     * @brief Finds a trajectory by name
+     * @param name The name of the trajectory
+     * @return The trajectory's entry, or NULL if there is none
+     */
+    Entry* find(const char* name);
+
+    /**
+     * @brief Reads a trajectory's file into memory, which is kept for the rest of the program
+     * @param entry The trajectory to read
+     */
+    void load(Entry& entry);
+  public:
+    /**
+     * @brief Gets the singleton instance of the TrajectoryCache
+     *
+     * If the TrajectoryCache instance does not yet exist, it is created.
+     *
+     * @return The TrajectoryCache instance
+     */
+    static TrajectoryCache* getInstance();
+
+    /**
+     * @brief Adds a trajectory that is already in memory
+     * @param name The name to find the trajectory by, which must outlive the cache, as a string literal does
+     * @param data The trajectory, which must outlive the cache and is not copied
+     * @param size The number of bytes in the trajectory
+     * @return True if the trajectory was added, false if it is not a valid trajectory, the name is taken or the cache
+     * is full
+     */
+    bool add(const char* name, const std::uint8_t* data, size_t size);
+
+    /**
+     * @brief Adds a trajectory to be read from a file the first time it is asked for
+     * @param name The name to find the trajectory by, which must outlive the cache, as a string literal does
+     * @param path The file to read, such as "/usd/paths/score.traj", which must outlive the cache
+     * @return True if the trajectory was added, false if the name is taken or the cache is full
+     */
+    bool addFile(const char* name, const char* path);
+
+    /**
+     * @brief Gets a trajectory, reading it from its file if it has not been read yet
+     * @param name The name the trajectory was added with
+     * @return The trajectory, or NULL if there is none by that name or its file could not be read
+     */
+    const Trajectory* get(const char* name);
+
+    /**
+     * @brief Gets the number of trajectories that have been read from files
+     * @return The number of files read
+     */
+    std::uint32_t getFilesLoaded();
+
+    /**
+     * @brief Gets the time spent reading trajectories from files
+     * @return The number of microseconds spent in get() reading files
+     */
+    std::uint64_t getLoadMicros();
+};
+
+};
+
+#endif // _PATHS_TRAJECTORYCACHE_H_
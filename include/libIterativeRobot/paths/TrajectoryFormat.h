@@ -0,0 +1,83 @@
+#ifndef _PATHS_TRAJECTORYFORMAT_H_
+#define _PATHS_TRAJECTORYFORMAT_H_
+
+#include <cstdint>
+
+/**
+ * The layout of a trajectory as written by TrajectoryGenerator and read by Trajectory. This header does not depend on
+ * PROS, so host tools such as tools/generatePaths.cpp can write trajectories with it.
+ *
+ * A trajectory is a TrajectoryFileHeader followed by sampleCount TrajectoryFileSamples, one every periodMillis
+ * milliseconds from the start of the path to the end. Each value in a sample is stored as a 16-bit fixed point number,
+ * so a sample takes 10 bytes and a second of path sampled every 10 ms takes 1000. Distances and velocities are in the
+ * units of the drivetrain's wheels, usually inches, and are limited to about 327 units (or units per second) either way.
+ * Every value is stored in the byte order of the machine that wrote it, which is little-endian on both the V5 brain
+ * and the usual host machines.
+ */
+namespace libIterativeRobot {
+
+/**
+ * @brief The start of a trajectory
+ */
+struct TrajectoryFileHeader {
+  /**
+   * @brief Always TrajectoryMagic
+   */
+  char magic[4];
+
+  /**
+   * @brief The version of the trajectory format, which is TrajectoryVersion
+   */
+  std::uint16_t version;
+
+  /**
+   * @brief The number of milliseconds between samples
+   */
+  std::uint16_t periodMillis;
+
+  /**
+   * @brief The number of samples after the header
+   */
+  std::uint32_t sampleCount;
+
+  /**
+   * @brief The distance between the left and right wheels the wheel velocities were worked out for
+   */
+  float trackWidth;
+};
+
+/**
+ * @brief Where the robot should be and how fast its wheels should turn at one point in a trajectory
+ */
+struct TrajectoryFileSample {
+  /**
+   * @brief The position, in hundredths of a unit
+   */
+  std::int16_t x;
+  std::int16_t y;
+
+  /**
+   * @brief The heading, in ten-thousandths of a radian from -pi to pi
+   */
+  std::int16_t heading;
+
+  /**
+   * @brief The velocity of the left and right wheels, in hundredths of a unit per second
+   */
+  std::int16_t left;
+  std::int16_t right;
+};
+
+const char TrajectoryMagic[4] = {'L', 'I', 'R', 'P'};
+const std::uint16_t TrajectoryVersion = 1;
+
+/**
+ * @brief The number of fixed point steps in one unit of distance, radian or unit per second
+ */
+const double TrajectoryDistanceScale = 100;
+const double TrajectoryHeadingScale = 10000;
+const double TrajectoryVelocityScale = 100;
+
+};
+
+#endif // _PATHS_TRAJECTORYFORMAT_H_
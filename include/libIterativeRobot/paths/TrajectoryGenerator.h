@@ -0,0 +1,72 @@
+#ifndef _PATHS_TRAJECTORYGENERATOR_H_
+#define _PATHS_TRAJECTORYGENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libIterativeRobot {
+
+/**
+ * A point a path passes through, in the units of the drivetrain's wheels, with the heading in radians
+ */
+struct Waypoint {
+  double x;
+  double y;
+  double heading;
+};
+
+/**
+ * The limits a generated trajectory keeps to
+ */
+struct TrajectoryConstraints {
+  /**
+   * @brief The fastest either wheel may go, in units per second
+   */
+  double maxVelocity;
+
+  /**
+   * @brief The fastest the robot may speed up or slow down, in units per second per second
+   */
+  double maxAcceleration;
+
+  /**
+   * @brief The distance between the left and right wheels
+   */
+  double trackWidth;
+
+  /**
+   * @brief The number of milliseconds between samples, which is best left at the EventScheduler's update period
+   */
+  std::uint16_t periodMillis;
+};
+
+/**
+ * The TrajectoryGenerator turns waypoints into a trajectory in the format described in TrajectoryFormat.h, ready to be
+ * saved to a file, compiled into the program, or read straight away with Trajectory.
+ *
+ * The path between each pair of waypoints is a cubic Hermite spline leaving and arriving at their headings. The robot
+ * starts and ends at rest, and its speed along the path is the fastest that keeps to the acceleration limit and keeps
+ * the outer wheel under the velocity limit on curves. The robot only drives forward. Generating takes a few
+ * milliseconds per path on the host and much longer on the brain, so paths are best generated ahead of time, with
+ * tools/generatePaths or during disabledInit(), and kept in the TrajectoryCache. This header does not depend on PROS,
+ * so host tools can use it.
+ */
+class TrajectoryGenerator {
+  public:
+    /**
+     * @brief Generates a trajectory
+     * @param waypoints The points to pass through, in order
+     * @param count The number of waypoints, at least 2
+     * @param constraints The limits to keep to
+     * @param trajectory Where to write the trajectory, replacing anything already there
+     * @return True if the trajectory was generated, false if there were too few waypoints, the limits were not
+     * positive, or the path went outside the range the format can store
+     */
+    static bool generate(const Waypoint* waypoints, size_t count, const TrajectoryConstraints& constraints,
+                         std::vector<std::uint8_t>& trajectory);
+};
+
+};
+
+#endif // _PATHS_TRAJECTORYGENERATOR_H_
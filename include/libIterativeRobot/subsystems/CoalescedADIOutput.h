@@ -0,0 +1,44 @@
+#ifndef _SUBSYSTEMS_COALESCEDADIOUTPUT_H_
+#define _SUBSYSTEMS_COALESCEDADIOUTPUT_H_
+
+#include "libIterativeRobot/subsystems/CoalescedOutput.h"
+
+namespace libIterativeRobot {
+
+/**
+ * A CoalescedADIOutput is an ADI port, such as a pneumatic solenoid or a legacy motor, that belongs to a Subsystem and
+ * is only written when its value changes, as described in CoalescedOutput. The port must already be configured as an
+ * output, for example by creating a pros::ADIDigitalOut or pros::ADIMotor for it.
+ */
+class CoalescedADIOutput : public CoalescedOutput {
+  private:
+    /**
+     * @brief The ADI port the output is plugged into
+     */
+    std::uint8_t port;
+  protected:
+    void send(std::int32_t value, std::uint8_t mode);
+  public:
+    /**
+     * @brief Creates a CoalescedADIOutput
+     * @param subsystem The Subsystem that flushes the output
+     * @param port The ADI port number (from 1-8, 'a'-'h', 'A'-'H')
+     */
+    CoalescedADIOutput(Subsystem* subsystem, std::uint8_t port);
+
+    /**
+     * @brief Sets the value to write to the port, as pros::ADIPort::set_value() does
+     * @param value The new value, such as 0 or 1 for a digital output or -127 to 127 for a legacy motor
+     */
+    void setValue(std::int32_t value);
+
+    /**
+     * @brief Gets the ADI port the output is plugged into
+     * @return The port number
+     */
+    std::uint8_t getPort();
+};
+
+};
+
+#endif // _SUBSYSTEMS_COALESCEDADIOUTPUT_H_
@@ -0,0 +1,66 @@
+#ifndef _SUBSYSTEMS_COALESCEDMOTOR_H_
+#define _SUBSYSTEMS_COALESCEDMOTOR_H_
+
+#include "libIterativeRobot/subsystems/CoalescedOutput.h"
+
+namespace libIterativeRobot {
+
+/**
+ * A CoalescedMotor is a V5 motor that belongs to a Subsystem and is only sent a new command when it changes, as
+ * described in CoalescedOutput. It has the same move functions as pros::Motor. The epsilon is in the units of whichever
+ * move function was last used, and switching between them always sends. The motor's other settings, such as its gearset
+ * and whether it is reversed, are set through pros::Motor as usual.
+ */
+class CoalescedMotor : public CoalescedOutput {
+  private:
+    /**
+     * @brief Which move function a value was set with
+     */
+    enum Mode : std::uint8_t {
+      Move, // From -127 to 127, like pros::Motor::move()
+      Velocity, // In the gearset's RPM, like pros::Motor::move_velocity()
+      Voltage // In millivolts, like pros::Motor::move_voltage()
+    };
+
+    /**
+     * @brief The V5 port the motor is plugged into
+     */
+    std::uint8_t port;
+  protected:
+    void send(std::int32_t value, std::uint8_t mode);
+  public:
+    /**
+     * @brief Creates a CoalescedMotor
+     * @param subsystem The Subsystem that flushes the motor
+     * @param port The V5 port number from 1-21
+     */
+    CoalescedMotor(Subsystem* subsystem, std::uint8_t port);
+
+    /**
+     * @brief Sets the motor's voltage, as pros::Motor::move() does
+     * @param voltage The new motor voltage from -127 to 127
+     */
+    void move(std::int32_t voltage);
+
+    /**
+     * @brief Sets the motor's target velocity, as pros::Motor::move_velocity() does
+     * @param velocity The new velocity, within the range of the motor's gearset
+     */
+    void moveVelocity(std::int32_t velocity);
+
+    /**
+     * @brief Sets the motor's voltage in millivolts, as pros::Motor::move_voltage() does
+     * @param voltage The new voltage from -12000 to 12000
+     */
+    void moveVoltage(std::int32_t voltage);
+
+    /**
+     * @brief Gets the V5 port the motor is plugged into
+     * @return The port number
+     */
+    std::uint8_t getPort();
+};
+
+};
+
+#endif // _SUBSYSTEMS_COALESCEDMOTOR_H_
@@ -0,0 +1,186 @@
+#ifndef _SUBSYSTEMS_COALESCEDOUTPUT_H_
+#define _SUBSYSTEMS_COALESCEDOUTPUT_H_
+
+#include "main.h"
+#include <cstdint>
+
+/**
+ * The default number of milliseconds after which a CoalescedOutput sends its value again even if it has not changed,
+ * so that a dropped packet cannot leave a device on a stale value for long
+ */
+#ifndef LIBITERATIVEROBOT_OUTPUT_REFRESH
+#define LIBITERATIVEROBOT_OUTPUT_REFRESH 100
+#endif
+
+namespace libIterativeRobot {
+
+class Subsystem;
+
+/**
+ * A CoalescedOutput is a device output, such as a motor or an ADI port, that belongs to a Subsystem and skips writes
+ * that would not change anything.
+ *
+ * Setting the output only stores the value. At the end of every update, after its Subsystem's writeOutputs(), the
+ * EventScheduler flushes each of the Subsystem's outputs, and an output only sends its value to the device if it
+ * differs from the value last sent by more than the output's epsilon. A Command that sets the same value on every
+ * update, as a default drive Command does while the joystick is still, then costs one device transaction instead of
+ * one per update. A change of mode, or a change to exactly zero, is always sent, so a stop is never swallowed by the
+ * epsilon. Every refresh interval the value is sent again even if it has not changed, in case the last write was lost.
+ *
+ * Subclasses implement send() to talk to the device, and give the user a way to set the value that calls set().
+ */
+class CoalescedOutput {
+  private:
+    /**
+     * @brief The next output of the same Subsystem, in the order they were created
+     */
+    CoalescedOutput* next = NULL;
+
+    /**
+     * @brief The Subsystem the output belongs to
+     */
+    Subsystem* subsystem;
+
+    /**
+     * @brief The value and mode last set, which are sent when the output is flushed
+     */
+    std::int32_t pending = 0;
+    std::uint8_t pendingMode = 0;
+
+    /**
+     * @brief The value and mode last sent to the device
+     */
+    std::int32_t sent = 0;
+    std::uint8_t sentMode = 0;
+
+    /**
+     * @brief Whether a value has been set since the output was last flushed
+     */
+    bool requested = false;
+
+    /**
+     * @brief Whether a value has ever been sent, after which the output is refreshed
+     */
+    bool hasSent = false;
+
+    /**
+     * @brief Whether refresh() was called since the value was last sent
+     */
+    bool forced = false;
+
+    /**
+     * @brief When the value was last sent, in milliseconds
+     */
+    std::uint32_t lastSent = 0;
+
+    /**
+     * @brief The largest change from the value last sent that is not sent
+     */
+    std::int32_t epsilon = 0;
+
+    /**
+     * @brief The number of milliseconds after which an unchanged value is sent again, or 0 to never send it again
+     */
+    std::uint32_t refreshInterval = LIBITERATIVEROBOT_OUTPUT_REFRESH;
+
+    /**
+     * @brief The number of values sent to the device, and the number of values set that were not sent
+     */
+    std::uint32_t writes = 0;
+    std::uint32_t skipped = 0;
+
+    /**
+     * @brief The number of values sent and skipped by every CoalescedOutput
+     */
+    static std::uint32_t totalWrites;
+    static std::uint32_t totalSkipped;
+
+    /**
+     * @brief Sends the value last set if it has changed enough or is due to be refreshed
+     */
+    void flush();
+
+    /**
+     * @brief Allow the Subsystem to flush its outputs
+     */
+    friend class Subsystem;
+  protected:
+    /**
+     * @brief Sets the value to send when the output is next flushed
+     * @param value The value to send
+     * @param mode What the value means to the device, such as a voltage or a velocity; any change is always sent
+     */
+    void set(std::int32_t value, std::uint8_t mode = 0);
+
+    /**
+     * @brief Sends a value to the device
+     * @param value The value to send
+     * @param mode What the value means to the device
+     */
+    virtual void send(std::int32_t value, std::uint8_t mode) = 0;
+  public:
+    /**
+     * @brief Creates a CoalescedOutput and adds it to a Subsystem's outputs
+     * @param subsystem The Subsystem that flushes the output
+     */
+    CoalescedOutput(Subsystem* subsystem);
+
+    /**
+     * @brief Removes the CoalescedOutput from its Subsystem's outputs
+     */
+    virtual ~CoalescedOutput();
+
+    CoalescedOutput(const CoalescedOutput&) = delete;
+    CoalescedOutput& operator=(const CoalescedOutput&) = delete;
+
+    /**
+     * @brief Sets the largest change from the value last sent that is not sent
+     * @param epsilon The largest change to skip, in the units of the value, or 0 to send every change
+     */
+    void setEpsilon(std::int32_t epsilon);
+
+    /**
+     * @brief Sets how often an unchanged value is sent again
+     * @param milliseconds The number of milliseconds between refreshes, or 0 to never send an unchanged value again
+     */
+    void setRefreshInterval(std::uint32_t milliseconds);
+
+    /**
+     * @brief Makes the next flush send the value last set, whether or not it has changed
+     */
+    void refresh();
+
+    /**
+     * @brief Gets the value last set
+     * @return The value that the output is sending, or will send when it is next flushed
+     */
+    std::int32_t getValue();
+
+    /**
+     * @brief Gets the number of values the output has sent to its device
+     * @return The number of writes sent
+     */
+    std::uint32_t getWrites();
+
+    /**
+     * @brief Gets the number of values set on the output that were not sent, because they had not changed enough
+     * @return The number of writes saved
+     */
+    std::uint32_t getSkipped();
+
+    /**
+     * @brief Gets the number of values every CoalescedOutput has sent
+     * @return The number of writes sent
+     */
+    static std::uint32_t getTotalWrites();
+
+    /**
+     * @brief Gets the number of values every CoalescedOutput has skipped
+     * @return The number of writes saved
+     */
+    static std::uint32_t getTotalSkipped();
+};
+
+};
+
+#endif // _SUBSYSTEMS_COALESCEDOUTPUT_H_
@@ -0,0 +1,225 @@
+#ifndef _SUBSYSTEMS_ODOMETRY_H_
+#define _SUBSYSTEMS_ODOMETRY_H_
+
+#include "main.h"
+#include "libIterativeRobot/Seqlock.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * The default number of milliseconds between odometry updates, which is shorter than the EventScheduler's update so
+ * that turns and changes of speed are followed more closely
+ */
+#ifndef LIBITERATIVEROBOT_ODOMETRY_RATE
+#define LIBITERATIVEROBOT_ODOMETRY_RATE 5
+#endif
+
+namespace libIterativeRobot {
+
+/**
+ * Where the robot is on the field, as tracked by Odometry
+ */
+struct Pose {
+  /**
+   * @brief The distance travelled forward and to the left of where the robot started, in the units of the wheels
+   */
+  double x = 0;
+  double y = 0;
+
+  /**
+   * @brief The heading in radians, counterclockwise from where the robot started facing
+   */
+  double theta = 0;
+
+  /**
+   * @brief When the pose was calculated, in milliseconds
+   */
+  std::uint32_t time = 0;
+};
+
+/**
+ * The distances tracking wheels have travelled since the robot started, as read by Odometry
+ */
+struct OdometryReading {
+  /**
+   * @brief The distance travelled by the left and right wheels, positive forward
+   */
+  double left = 0;
+  double right = 0;
+
+  /**
+   * @brief The distance travelled by a sideways tracking wheel, positive to the left, or 0 if there is none
+   */
+  double middle = 0;
+};
+
+/**
+ * Odometry tracks the robot's Pose from its tracking wheels in a task of its own, which runs more often than the
+ * EventScheduler updates.
+ *
+ * Subclasses implement read() to return the distance each wheel has travelled, for example from the drive motors'
+ * encoders or from ADIEncoders. Once start() is called, the Odometry's task reads the wheels every
+ * LIBITERATIVEROBOT_ODOMETRY_RATE milliseconds, treats the motion since the last reading as an arc, and publishes the
+ * new Pose through a Seqlock. getPose() can be called from any Command's execute() and returns a whole Pose from a
+ * single reading without taking a lock.
+ *
+ * The task runs above the default priority, so the EventScheduler's task never interrupts it partway through
+ * publishing, and a Pose is never more than one odometry update old.
+ */
+class Odometry {
+  private:
+    /**
+     * @brief The distance between the left and right wheels
+     */
+    double trackWidth;
+
+    /**
+     * @brief How far behind the center of rotation the sideways wheel is
+     */
+    double middleOffset;
+
+    /**
+     * @brief The Pose last calculated, for Commands to read
+     */
+    Seqlock<Pose> published;
+
+    /**
+     * @brief Poses set with setPose() for the task to start from on its next update
+     *
+     * Not a Seqlock, since the task that reads them outranks the task that sets them and would spin forever on one
+     * it interrupted partway through. setPose() writes the slot that is not waiting and then makes it the waiting one,
+     * so the task only ever reads a slot that is not being written.
+     */
+    Pose requested[2];
+    std::atomic<int> waitingSlot;
+
+    /**
+     * @brief The slot the next setPose() writes, which only the task calling setPose() uses
+     */
+    int nextSlot = 0;
+
+    /**
+     * @brief The Pose and wheel distances as of the last update, which only the task uses
+     */
+    Pose pose;
+    OdometryReading last;
+
+    /**
+     * @brief Whether the task has read the wheels yet
+     */
+    bool hasReading = false;
+
+    /**
+     * @brief The number of milliseconds between updates
+     */
+    std::atomic<std::uint32_t> rate;
+
+    /**
+     * @brief The priority the task is started with
+     */
+    std::uint32_t priority = TASK_PRIORITY_DEFAULT + 1;
+
+    /**
+     * @brief Whether the task should keep running
+     */
+    std::atomic<bool> running;
+
+    /**
+     * @brief The number of updates the task has made
+     */
+    std::atomic<std::uint32_t> updates;
+
+    /**
+     * @brief The Odometry's task
+     */
+    pros::task_t task = NULL;
+
+    /**
+     * @brief Updates the Odometry every rate milliseconds until it is stopped
+     * @param parameter The Odometry
+     */
+    static void runTask(void* parameter);
+
+    /**
+     * @brief Reads the wheels and moves the Pose along the arc they travelled since the last reading
+     */
+    void update();
+  protected:
+    /**
+     * @brief Reads the tracking wheels
+     *
+     * Called from the Odometry's task on every update.
+     *
+     * @return The distance each wheel has travelled since the robot started
+     */
+    virtual OdometryReading read() = 0;
+  public:
+    /**
+     * @brief Creates an Odometry
+     * @param trackWidth The distance between the left and right wheels
+     * @param middleOffset How far behind the center of rotation the sideways wheel is, if there is one
+     */
+    Odometry(double trackWidth, double middleOffset = 0);
+
+    /**
+     * @brief Starts the Odometry's task, if it is not running already
+     *
+     * Called once, for example in robotInit(). The first update only reads the wheels, so the Pose starts from
+     * wherever the robot is. An Odometry that has been stopped is not started again.
+     */
+    void start();
+
+    /**
+     * @brief Stops the Odometry's task after its current update
+     */
+    void stop();
+
+    /**
+     * @brief Sets the number of milliseconds between updates, which takes effect after the next update
+     * @param milliseconds The number of milliseconds between updates, at least 1
+     */
+    void setRate(std::uint32_t milliseconds);
+
+    /**
+     * @brief Sets the priority the task is started with
+     *
+     * The task runs above the default task priority unless this is called, and must run above every task that calls
+     * getPose().
+     *
+     * @param priority The task priority
+     */
+    void setPriority(std::uint32_t priority);
+
+    /**
+     * @brief Gets the robot's Pose
+     * @return The Pose as of the Odometry's last update
+     */
+    Pose getPose();
+
+    /**
+     * @brief Moves the tracked Pose somewhere else, for example to the robot's starting position on the field
+     *
+     * The Odometry's task starts from the new Pose on its next update, so getPose() returns the old one until then. If
+     * it is called more than once before that update, the last Pose wins. Should only be called from one task at a
+     * time, below the Odometry's task's priority.
+     *
+     * @param pose The new Pose
+     */
+    void setPose(const Pose& pose);
+
+    /**
+     * @brief Gets the number of updates the Odometry's task has made
+     * @return The number of updates
+     */
+    std::uint32_t getUpdates();
+
+    /**
+     * @brief Gets the number of times getPose() had to read the Pose again because it was being published
+     * @return The number of retries
+     */
+    std::uint32_t getRetries();
+};
+
+};
+
+#endif // _SUBSYSTEMS_ODOMETRY_H_
@@ -6,6 +6,7 @@
 namespace libIterativeRobot {
 
 class Command;
+class CoalescedOutput;
 
 /**
  * The Subsystem class is for encapsulating groups of motors and other objects such as PIDControllers that interact
@@ -16,6 +17,15 @@ class Command;
  * or fail to run.
  *
  * Subsystems can have default Commands which run automatically if no other Commands require it
+ *
+ * On every update, the EventScheduler calls readInputs() on each Subsystem before any EventListener is checked or any
+ * Command runs, and writeOutputs() after every Command has run. A Subsystem that reads its sensors into member
+ * variables in readInputs(), and sends the values its Commands set to its motors in writeOutputs(), talks to each
+ * device once per update no matter how many Commands and Triggers use it, and every Command in the update sees the
+ * same readings.
+ *
+ * A Subsystem's CoalescedOutputs are flushed right after its writeOutputs(), so a motor or ADI output that is set to
+ * the same value on every update is only written when the value changes or is due to be refreshed.
  */
 
 class Subsystem {
@@ -24,6 +34,28 @@ class Subsystem {
      * @brief The Command to be used as a default Command.
      */
     Command* defaultCommand = NULL;
+
+    /**
+     * @brief The Subsystem's position in the EventScheduler's list of tracked Subsystems
+     *
+     * Assigned by the EventScheduler in trackSubsystem(), and used as the Subsystem's bit in a SubsystemMask
+     */
+    size_t index = 0;
+
+    /**
+     * @brief The first of the Subsystem's CoalescedOutputs, which link to the rest
+     */
+    CoalescedOutput* outputs = NULL;
+
+    /**
+     * @brief Sends each of the Subsystem's CoalescedOutputs that has changed or is due to be refreshed
+     */
+    void flushOutputs();
+
+    /**
+     * @brief Allow CoalescedOutputs to add and remove themselves from the Subsystem's outputs
+     */
+    friend class CoalescedOutput;
   protected:
     /**
       * @brief Sets the default Command for the Subsystem
@@ -38,7 +70,24 @@ class Subsystem {
     Command* getDefaultCommand();
 
     /**
-     * @brief Allow the EventScheduler access to the Subsystems' getDefaultCommand() method
+     * @brief Reads the Subsystem's sensors at the start of an update
+     *
+     * Called by the EventScheduler on every update, before any EventListener is checked or any Command runs. The
+     * default does nothing.
+     */
+    virtual void readInputs();
+
+    /**
+     * @brief Sends the Subsystem's outputs to its motors at the end of an update
+     *
+     * Called by the EventScheduler on every update, after every Command has run, and before the Subsystem's
+     * CoalescedOutputs are flushed. The default does nothing.
+     */
+    virtual void writeOutputs();
+
+    /**
+     * @brief Allow the EventScheduler access to the Subsystems' getDefaultCommand(), readInputs(), writeOutputs() and
+     * flushOutputs() methods
      */
     friend class EventScheduler;
   public:
@@ -52,6 +101,12 @@ class Subsystem {
       */
     virtual void initDefaultCommand() = 0;
 
+    /**
+     * @brief Gets the Subsystem's index
+     * @return The index the EventScheduler assigned to the Subsystem
+     */
+    size_t getIndex();
+
     /**
      * @brief Creates a Subsystem
      * @return A Subsystem
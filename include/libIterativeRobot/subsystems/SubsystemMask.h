@@ -0,0 +1,138 @@
+#ifndef _SUBSYSTEMS_SUBSYSTEMMASK_H_
+#define _SUBSYSTEMS_SUBSYSTEMMASK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "libIterativeRobot/Storage.h"
+
+namespace libIterativeRobot {
+
+/**
+ * A SubsystemMask is a set of Subsystems stored as a bitset, where each bit corresponds to the index a Subsystem was
+ * given when the EventScheduler started tracking it.
+ *
+ * The first 64 Subsystems are stored in a single fixed-width word, so checking whether two masks share a Subsystem
+ * is a single AND for nearly every robot. Subsystems past the first 64 are stored in a dynamically sized overflow array,
+ * which with LIBITERATIVEROBOT_STATIC defined only has room for LIBITERATIVEROBOT_MAX_SUBSYSTEMS.
+ */
+class SubsystemMask {
+  private:
+    /**
+     * @brief Bits for the Subsystems with indexes 0 through 63
+     */
+    std::uint64_t bits = 0;
+
+    /**
+     * @brief Bits for the Subsystems with indexes of 64 and above, 64 per word
+     */
+    Storage<std::uint64_t, (LIBITERATIVEROBOT_MAX_SUBSYSTEMS + 63) / 64 - 1> overflowBits;
+  public:
+    /**
+     * @brief The number of Subsystems stored without using the overflow array
+     */
+    static const size_t kInlineBits = 64;
+
+    /**
+     * @brief Adds a Subsystem to the mask
+     * @param index The index of the Subsystem to add
+     */
+    void set(size_t index) {
+      if (index < kInlineBits) {
+        bits |= std::uint64_t(1) << index;
+        return;
+      }
+
+      index -= kInlineBits;
+      if (overflowBits.size() <= index / 64) {
+        overflowBits.resize(index / 64 + 1, 0);
+        if (overflowBits.size() <= index / 64) {
+          return; // There is no room for the Subsystem, which the resize counted as an overflow
+        }
+      }
+      overflowBits[index / 64] |= std::uint64_t(1) << (index % 64);
+    }
+
+    /**
+     * @brief Checks whether a Subsystem is in the mask
+     * @param index The index of the Subsystem to check for
+     * @return Whether or not the Subsystem is in the mask
+     */
+    bool test(size_t index) const {
+      if (index < kInlineBits) {
+        return (bits >> index) & 1;
+      }
+
+      index -= kInlineBits;
+      if (overflowBits.size() <= index / 64) {
+        return false;
+      }
+      return (overflowBits[index / 64] >> (index % 64)) & 1;
+    }
+
+    /**
+     * @brief Checks whether this mask and another mask share any Subsystems
+     * @param other The mask to compare against
+     * @return Whether or not any Subsystem is in both masks
+     */
+    bool intersects(const SubsystemMask& other) const {
+      if (bits & other.bits) {
+        return true;
+      }
+
+      // Only robots with more than 64 subsystems ever get past this point
+      size_t words = overflowBits.size() < other.overflowBits.size() ? overflowBits.size() : other.overflowBits.size();
+      for (size_t i = 0; i < words; i++) {
+        if (overflowBits[i] & other.overflowBits[i]) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * @brief Adds all of the Subsystems in another mask to this mask
+     * @param other The mask to add
+     */
+    void merge(const SubsystemMask& other) {
+      bits |= other.bits;
+
+      if (overflowBits.size() < other.overflowBits.size()) {
+        overflowBits.resize(other.overflowBits.size(), 0);
+      }
+      for (size_t i = 0; i < other.overflowBits.size(); i++) {
+        overflowBits[i] |= other.overflowBits[i];
+      }
+    }
+
+    /**
+     * @brief Removes all Subsystems from the mask
+     *
+     * The overflow array is zeroed rather than shrunk so that clearing and refilling a mask never allocates
+     */
+    void clear() {
+      bits = 0;
+      for (std::uint64_t& word : overflowBits) {
+        word = 0;
+      }
+    }
+
+    /**
+     * @brief Checks whether the mask contains no Subsystems
+     * @return Whether or not the mask is empty
+     */
+    bool empty() const {
+      if (bits != 0) {
+        return false;
+      }
+      for (std::uint64_t word : overflowBits) {
+        if (word != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+};
+
+};
+
+#endif // _SUBSYSTEMS_SUBSYSTEMMASK_H_
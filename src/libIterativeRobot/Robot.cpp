@@ -1,3 +1,5 @@
+#include <new>
+
 Robot* Robot::instance = 0;
 
 Robot::Robot() {
@@ -26,7 +28,9 @@ void Robot::disabledPeriodic() {
 
 Robot* Robot::getInstance() {
     if (instance == NULL) {
-        instance = new Robot();
+        // Built in static storage rather than on the heap, and never destroyed
+        alignas(Robot) static unsigned char storage[sizeof(Robot)];
+        instance = new (storage) Robot();
     }
     return instance;
 }
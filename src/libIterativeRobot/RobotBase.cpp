@@ -2,6 +2,8 @@
 #include "Robot.h"
 #include "pros/misc.hpp"
 #include "events/EventScheduler.h"
+#include "Clock.h"
+#include <algorithm>
 
 using namespace libIterativeRobot;
 
@@ -11,13 +13,92 @@ RobotBase::RobotBase() {
 void RobotBase::_privateRunRobot(void* param) {
     RobotBase* robot = reinterpret_cast<RobotBase*>(param);
     std::uint32_t prev_time = pros::millis();
-    const std::uint32_t delta = 10;
+    std::uint64_t scheduled = micros(); // When the next cycle should start
+    std::uint32_t cycle = 0;
     while (true) {
-      robot->doOneCycle();
+      std::uint64_t start = micros();
+      robot->doOneTick(cycle);
+
+      // The period is read after the cycle, since robotInit() may have changed it
+      const std::uint32_t delta = robot->period;
+      std::uint32_t missed = robot->recordCycle(scheduled, start, micros(), delta * 1000);
+
+      // Skips the start times that have already passed, so the loop stays in phase instead of running late cycles
+      cycle += missed + 1;
+      prev_time += missed * delta;
+      scheduled += (missed + 1) * delta * 1000;
       pros::Task::delay_until(&prev_time, delta);
     }
 }
 
+void RobotBase::doOneTick(std::uint32_t cycle) {
+  if (cycle % cycleMultiple == 0) {
+    doOneCycle();
+  }
+  for (Periodic& periodic : periodics) {
+    if (cycle % periodic.multiple == periodic.phase) {
+      periodic.callback(periodic.parameter);
+    }
+  }
+}
+
+void RobotBase::setPeriod(std::uint32_t milliseconds) {
+  period = milliseconds == 0 ? 1 : milliseconds;
+}
+
+void RobotBase::setCycleMultiple(std::uint32_t multiple) {
+  cycleMultiple = multiple == 0 ? 1 : multiple;
+}
+
+void RobotBase::addPeriodic(void (*callback)(void*), void* parameter, std::uint32_t multiple, std::uint32_t phase) {
+  Periodic periodic;
+  periodic.callback = callback;
+  periodic.parameter = parameter;
+  periodic.multiple = multiple == 0 ? 1 : multiple;
+  periodic.phase = phase % periodic.multiple;
+  periodics.push_back(periodic); // Dropped past LIBITERATIVEROBOT_MAX_PERIODICS, and counted as an overflow
+}
+
+std::uint32_t RobotBase::recordCycle(std::uint64_t scheduled, std::uint64_t start, std::uint64_t end, std::uint32_t period) {
+  std::uint32_t duration = end - start;
+  std::uint32_t jitter = start > scheduled ? start - scheduled : 0;
+
+  cycleStatistics.cycles++;
+  cycleStatistics.totalMicros += duration;
+  if (duration > cycleStatistics.maxMicros) {
+    cycleStatistics.maxMicros = duration;
+  }
+  if (jitter > cycleStatistics.maxJitterMicros) {
+    cycleStatistics.maxJitterMicros = jitter;
+  }
+  cycleStatistics.durationHistogram[std::min<std::size_t>(duration / CycleStatistics::DurationBucketMicros,
+                                                          CycleStatistics::HistogramBuckets - 1)]++;
+  cycleStatistics.jitterHistogram[std::min<std::size_t>(jitter / CycleStatistics::JitterBucketMicros,
+                                                        CycleStatistics::HistogramBuckets - 1)]++;
+
+  if (end <= scheduled + period) {
+    return 0; // The cycle finished in time for the next one
+  }
+
+  // Counts the start times after this cycle's that passed before it finished
+  std::uint32_t missed = (end - scheduled - 1) / period;
+  cycleStatistics.overruns++;
+  cycleStatistics.missedDeadlines += missed;
+  cycleOverrun(duration);
+  return missed;
+}
+
+void RobotBase::cycleOverrun(std::uint32_t cycleMicros) {
+}
+
+const CycleStatistics& RobotBase::getCycleStatistics() {
+  return cycleStatistics;
+}
+
+void RobotBase::resetCycleStatistics() {
+  cycleStatistics = CycleStatistics();
+}
+
 void RobotBase::runRobot() {
   // Just saying, if this doesn't work, try using the reinterepret cast on the method instead, instead of its pointer
   // reinterpret_cast<void (*)(void*)>(&_privateRunRobot<RobotMain>)
@@ -0,0 +1,5 @@
+#include "libIterativeRobot/Storage.h"
+
+using namespace libIterativeRobot;
+
+std::atomic<std::uint32_t> StorageDiagnostics::overflows(0);
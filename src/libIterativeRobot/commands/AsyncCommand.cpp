@@ -0,0 +1,81 @@
+#include "./AsyncCommand.h"
+#include "../events/WorkerPool.h"
+
+using namespace libIterativeRobot;
+
+AsyncCommand::AsyncCommand() : phase(Phase::Idle), cancelRequested(false) {
+}
+
+void AsyncCommand::start() {
+}
+
+void AsyncCommand::poll() {
+}
+
+void AsyncCommand::cancelled() {
+}
+
+bool AsyncCommand::isCancelled() {
+  return cancelRequested.load(std::memory_order_relaxed);
+}
+
+bool AsyncCommand::isWorking() {
+  return phase.load(std::memory_order_acquire) == Phase::Working;
+}
+
+void AsyncCommand::dispatch() {
+  if (phase.load(std::memory_order_relaxed) != Phase::Waiting) {
+    return;
+  }
+  // The phase is set first, since the worker may finish and mark the work as done before dispatch() returns
+  phase.store(Phase::Working, std::memory_order_relaxed);
+  if (!WorkerPool::getInstance()->dispatch(this)) {
+    phase.store(Phase::Waiting, std::memory_order_relaxed);
+  }
+}
+
+void AsyncCommand::performWork() {
+  work();
+  // Publishes whatever work() stored to the EventScheduler's task. The worker does not touch the AsyncCommand again
+  phase.store(Phase::Done, std::memory_order_release);
+}
+
+void AsyncCommand::begin() {
+  cancelRequested.store(false, std::memory_order_relaxed);
+  phase.store(Phase::Waiting, std::memory_order_relaxed);
+  start();
+  dispatch();
+}
+
+void AsyncCommand::initialize() {
+  if (isWorking()) {
+    // Cancelled work from the last run is still returning, so the new work waits for it
+    restartPending = true;
+  } else {
+    begin();
+  }
+}
+
+void AsyncCommand::execute() {
+  if (restartPending && !isWorking()) {
+    restartPending = false;
+    begin();
+  } else {
+    dispatch();
+  }
+  poll();
+}
+
+bool AsyncCommand::isFinished() {
+  return !restartPending && phase.load(std::memory_order_acquire) == Phase::Done;
+}
+
+void AsyncCommand::interrupted() {
+  restartPending = false;
+  if (phase.load(std::memory_order_relaxed) == Phase::Waiting) {
+    phase.store(Phase::Idle, std::memory_order_relaxed); // No worker has it, so it never runs
+  } else {
+    cancelRequested.store(true, std::memory_order_relaxed);
+  }
+  cancelled();
+}
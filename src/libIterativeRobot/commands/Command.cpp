@@ -7,15 +7,26 @@ using namespace libIterativeRobot;
 Command::Command() {
 }
 
-void Command::requires(Subsystem* aSubsystem) {
+Command::~Command() {
+#ifdef LIBITERATIVEROBOT_PROFILE
+  Profiler::getInstance()->forget(this);
+#endif
+}
+
+void Command::addRequirement(Subsystem* aSubsystem) {
   if (std::find(subsystemRequirements.begin(), subsystemRequirements.end(), aSubsystem) == subsystemRequirements.end()) {
-    subsystemRequirements.push_back(aSubsystem);
+    subsystemRequirements.push_back(aSubsystem); // Dropped past LIBITERATIVEROBOT_MAX_REQUIREMENTS, but still in the mask
+    requirementMask.set(aSubsystem->getIndex());
   }
 }
 
-std::vector<Subsystem*>& Command::getRequirements() {
+Storage<Subsystem*, LIBITERATIVEROBOT_MAX_REQUIREMENTS>& Command::getRequirements() {
   return this->subsystemRequirements;
 }
+
+SubsystemMask& Command::getRequirementMask() {
+  return this->requirementMask;
+}
 /*
 
   Currently removed due to incompatibilities with the current EventScheduler
@@ -4,19 +4,37 @@
 
 using namespace libIterativeRobot;
 
+namespace {
+  // The added and forget flags are packed 32 to a word; these find a command's bit
+  template <typename Bits>
+  inline bool getBit(const Bits& bits, size_t index) {
+    return (bits[index / 32] >> (index % 32)) & 1;
+  }
+
+  template <typename Bits>
+  inline void setBit(Bits& bits, size_t index) {
+    bits[index / 32] |= std::uint32_t(1) << (index % 32);
+  }
+}
+
 CommandGroup::CommandGroup() {
+  stepOffsets.push_back(0); // There are no steps yet, so the only offset is the end of the (empty) commands array
 }
 
 bool CommandGroup::canRun() {
   //comment("Checking if command group can run\n");
 
+  if (isFinished()) {
+    return true; // There is no current step left to check
+  }
+
   //comment("  Current status is %d, command address is 0x%x, status address is 0x%x\n", this->status, this, &status);
-  for (Command* command : commands[sequentialIndex]) {
+  for (size_t i = stepOffsets[sequentialIndex]; i < stepOffsets[sequentialIndex + 1]; i++) {
 
     //comment("  Command status is %d, command address is 0x%x, status address is 0x%x\n", command->status, command, &command->status);
     //pros::wait(1000);
 
-    if (!command->canRun()) {
+    if (!commands[i]->canRun()) {
       return false; // If any cannot run, the command group cannot run
     }
   }
@@ -28,12 +46,8 @@ void CommandGroup::initialize() {
 
   sequentialIndex = 0; // Initializes the sequential index to 0
 
-  // Loops through the added 2d vector and sets each element to 0
-  for (size_t i = 0; i < commands.size(); i++) {
-    for (size_t j = 0; j < commands[i].size(); j++) {
-      added[i][j] = 0;
-    }
-  }
+  // Clears every added flag
+  std::fill(added.begin(), added.end(), 0);
 }
 
 void CommandGroup::execute() {
@@ -43,17 +57,17 @@ void CommandGroup::execute() {
   Command* command; // Pointer to a command or command group
 
   // Loops through the commands and command groups in the current sequential step
-  for (size_t i = 0; i < commands[sequentialIndex].size(); i++) {
-    command = commands[sequentialIndex][i]; // Sets command to the command or command group the for loop is accessing
+  for (size_t i = stepOffsets[sequentialIndex]; i < stepOffsets[sequentialIndex + 1]; i++) {
+    command = commands[i]; // Sets command to the command or command group the for loop is accessing
 
     // If the current command has not been added to the event scheduler, add it
-    if (!added[sequentialIndex][i]) {
+    if (!getBit(added, i)) {
       command->run(); // Add the current command or command group to the event scheduler
-      added[sequentialIndex][i] = 1; // Set the element in the added 2d vector corresponding to the current command or command group to 1
+      setBit(added, i); // Set the current command's added bit
       sequentialFinished = false; // The current sequential step is not finished, so set sequentialFinished to false
     } else { // Otherwise, check the command's status
       // If the command's status is not Finished and forget is false, then the current sequential step is not finished
-      if (command->status != Status::Finished && !forget[sequentialIndex][i]) {
+      if (command->status != Status::Finished && !getBit(forget, i)) {
         sequentialFinished = false;
       }
 
@@ -70,13 +84,16 @@ void CommandGroup::execute() {
   //Updates the command group's status based on sequentialInterrupted and sequentialFinished
   if (sequentialInterrupted) status = Status::Interrupted;
   if (sequentialBlocked) status = Status::Blocked;
-  if (sequentialFinished) sequentialIndex++; // If the current sequential step is finished, the command group moves on to the next sequential step
+  if (sequentialFinished) { // If the current sequential step is finished, the command group moves on to the next sequential step
+    sequentialIndex++;
+    LIBITERATIVEROBOT_TRACE_EVENT(GroupStepAdvanced, this, sequentialIndex);
+  }
 }
 
 bool CommandGroup::isFinished() {
   //comment("Checking if command group is finished\n");
   // Checks if the command group has finished all of its sequential steps
-  return !(sequentialIndex < commands.size());
+  return !(sequentialIndex + 1 < stepOffsets.size());
 }
 
 void CommandGroup::end() {
@@ -90,38 +107,68 @@ void CommandGroup::interrupted() {
 
   //printf("Command group interrupted\n");
 
+  if (isFinished()) {
+    return;
+  }
+
   // Loops through the sequential step and stop any commands and command groups still running
-  for (size_t i = 0; i < commands[sequentialIndex].size(); i++) {
-    commands[sequentialIndex][i]->stop();
+  for (size_t i = stepOffsets[sequentialIndex]; i < stepOffsets[sequentialIndex + 1]; i++) {
+    commands[i]->stop();
   }
 }
 
 void CommandGroup::blocked() {
   //status = Status::Idle;
 
-  for (size_t i = 0; i < commands[sequentialIndex].size(); i++) {
-    commands[sequentialIndex][i]->stop();
+  if (isFinished()) {
+    return;
+  }
+
+  for (size_t i = stepOffsets[sequentialIndex]; i < stepOffsets[sequentialIndex + 1]; i++) {
+    commands[i]->stop();
   }
 }
 
-void CommandGroup::addSequentialCommand(Command* aCommand, bool forget) {
-  std::vector<Command*> commandList;
-  std::vector<int> addedList;
-  std::vector<bool> forgetList;
+void CommandGroup::append(Command* aCommand, bool forget) {
+  size_t index = commands.size();
+  commands.push_back(aCommand);
+  stepOffsets.back()++; // The last step now ends one command later
 
-  commandList.push_back(aCommand);
-  addedList.push_back(0);
-  forgetList.push_back(forget);
+  // Adds another word of flags once the existing ones are full
+  if (index % 32 == 0) {
+    this->added.push_back(0);
+    this->forget.push_back(0);
+  }
+  if (forget) {
+    setBit(this->forget, index);
+  }
+}
 
-  this->commands.push_back(commandList);
-  this->added.push_back(addedList);
-  this->forget.push_back(forgetList);
+void CommandGroup::addSequentialCommand(Command* aCommand, bool forget) {
+  if (!hasRoom(commands) || !hasRoom(stepOffsets)) {
+    return; // Left out of the group, and counted as an overflow
+  }
+  stepOffsets.push_back(stepOffsets.back()); // Starts a new, empty step at the end of the commands array
+  append(aCommand, forget);
 }
 
 void CommandGroup::addParallelCommand(Command *aCommand, bool forget) {
-  this->commands.back().push_back(aCommand);
-  this->added.back().push_back(0);
-  this->forget.back().push_back(forget);
+  if (!hasRoom(commands) || (stepOffsets.size() == 1 && !hasRoom(stepOffsets))) {
+    return; // Left out of the group, and counted as an overflow
+  }
+  if (stepOffsets.size() == 1) {
+    stepOffsets.push_back(stepOffsets.back()); // There is no step to add to yet, so this starts the first one
+  }
+  append(aCommand, forget);
+}
+
+void CommandGroup::clearCommands() {
+  commands.clear();
+  stepOffsets.clear();
+  stepOffsets.push_back(0);
+  added.clear();
+  forget.clear();
+  sequentialIndex = 0;
 }
 
 void CommandGroup::run() {
@@ -3,24 +3,67 @@
 using namespace libIterativeRobot;
 
 ConditionalGroup::ConditionalGroup() {
-  lambda = new LambdaGroup();
+  current = &lambda;
+}
+
+ConditionalGroup::~ConditionalGroup() {
+  // The group that was run last may still be in the EventScheduler, which would otherwise keep a dangling pointer to it
+  current->stop();
+#ifndef LIBITERATIVEROBOT_STATIC
+  for (Branch& branch : branches) {
+    delete branch.group;
+  }
+#endif
+}
+
+int ConditionalGroup::conditionalBranch() {
+  return UncachedBranch;
 }
 
 void ConditionalGroup::addSequentialCommand(Command* aCommand, bool forget) {
-  lambda->addSequentialCommand(aCommand, forget);
+  current->addSequentialCommand(aCommand, forget);
 }
 
 void ConditionalGroup::addParallelCommand(Command* aCommand, bool forget) {
-  lambda->addParallelCommand(aCommand, forget);
+  current->addParallelCommand(aCommand, forget);
 }
 
 void ConditionalGroup::run() {
-  delete lambda;
-  lambda = new LambdaGroup();
-  conditionalBody();
-  lambda->run();
+  int key = conditionalBranch();
+
+  // The previous run's group has to leave the EventScheduler before it can be cleared or another branch replaces it
+  current->stop();
+
+  // Looks for the branch's group, and adds its commands if this is the first time it has been taken
+  current = NULL;
+  if (key != UncachedBranch) {
+    for (Branch& branch : branches) {
+      if (branch.key == key) {
+        current = branch.group;
+        break;
+      }
+    }
+    if (current == NULL && hasRoom(branches)) {
+#ifdef LIBITERATIVEROBOT_STATIC
+      current = &branchGroups[branches.size()];
+#else
+      current = new LambdaGroup();
+#endif
+      branches.push_back({key, current});
+      conditionalBody();
+    }
+  }
+
+  // Uncached bodies, and branches taken once there is no room to cache them, are rebuilt on every run
+  if (current == NULL) {
+    current = &lambda;
+    current->clearCommands(); // Keeps the memory from the last run, so rebuilding the body does not allocate
+    conditionalBody();
+  }
+
+  current->run();
 }
 
 void ConditionalGroup::stop() {
-  lambda->stop();
+  current->stop();
 }
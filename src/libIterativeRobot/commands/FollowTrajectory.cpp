@@ -0,0 +1,49 @@
+#include "libIterativeRobot/commands/FollowTrajectory.h"
+#include "libIterativeRobot/paths/TrajectoryCache.h"
+
+using namespace libIterativeRobot;
+
+FollowTrajectory::FollowTrajectory(Subsystem* drive, const char* name) : name(name) {
+  addRequirement(drive);
+}
+
+const Trajectory* FollowTrajectory::getTrajectory() {
+  return trajectory;
+}
+
+bool FollowTrajectory::canRun() {
+  if (trajectory == NULL) {
+    trajectory = TrajectoryCache::getInstance()->get(name);
+  }
+  return trajectory != NULL;
+}
+
+void FollowTrajectory::initialize() {
+  startTime = pros::millis();
+}
+
+void FollowTrajectory::execute() {
+  follow(trajectory->getSampleAt(pros::millis() - startTime));
+}
+
+bool FollowTrajectory::isFinished() {
+  return pros::millis() - startTime >= trajectory->getDuration();
+}
+
+void FollowTrajectory::stopDriving() {
+  TrajectorySample sample = trajectory->getSampleAt(pros::millis() - startTime);
+  sample.leftVelocity = 0;
+  sample.rightVelocity = 0;
+  follow(sample);
+}
+
+void FollowTrajectory::end() {
+  stopDriving();
+}
+
+void FollowTrajectory::interrupted() {
+  stopDriving();
+}
+
+void FollowTrajectory::blocked() {
+}
@@ -0,0 +1,120 @@
+#include "libIterativeRobot/events/CommandQueue.h"
+
+using namespace libIterativeRobot;
+
+size_t CommandQueue::findBucket(int priority) {
+  if (lastBucket < buckets.size() && buckets[lastBucket].priority == priority) {
+    return lastBucket;
+  }
+
+  // Binary search for the first bucket with a priority of at least the one given
+  size_t low = 0;
+  size_t high = buckets.size();
+  while (low < high) {
+    size_t middle = (low + high) / 2;
+    if (buckets[middle].priority < priority) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  if (low == buckets.size() || buckets[low].priority != priority) {
+    // This priority has not been seen before, so a bucket is created for it. Inserting shifts every bucket after it,
+    // so the Commands in those buckets have their bucket index updated
+    // The bucket is reserved after it is inserted, since copying a vector into place does not keep its capacity
+    if (!hasRoom(buckets)) {
+      return kNoBucket;
+    }
+    buckets.insert(buckets.begin() + low, Bucket());
+    buckets[low].priority = priority;
+    buckets[low].holes = 0;
+    buckets[low].commands.reserve(bucketCapacity);
+
+    for (size_t i = low + 1; i < buckets.size(); i++) {
+      for (Command* command : buckets[i].commands) {
+        if (command != NULL) {
+          command->schedulerBucket = i;
+        }
+      }
+    }
+  }
+
+  lastBucket = low;
+  return low;
+}
+
+bool CommandQueue::push(Command* command) {
+#ifdef LIBITERATIVEROBOT_STATIC
+  if (count >= LIBITERATIVEROBOT_MAX_COMMANDS) {
+    StorageDiagnostics::recordOverflow(); // The EventScheduler only has room to execute this many Commands at once
+    return false;
+  }
+#endif
+  size_t index = findBucket(command->priority);
+  if (index == kNoBucket || !hasRoom(buckets[index].commands)) {
+    return false;
+  }
+  Commands& commands = buckets[index].commands;
+
+  command->schedulerLocation = Command::SchedulerLocation::CommandQueue;
+  command->schedulerBucket = index;
+  command->schedulerSlot = commands.size();
+  commands.push_back(command);
+  count++;
+  return true;
+}
+
+void CommandQueue::remove(Command* command) {
+  Bucket& bucket = buckets[command->schedulerBucket];
+  bucket.commands[command->schedulerSlot] = NULL;
+  bucket.holes++;
+  count--;
+}
+
+void CommandQueue::compact() {
+  for (Bucket& bucket : buckets) {
+    if (bucket.holes == 0) {
+      continue; // Nothing was removed from this bucket
+    }
+
+    // Shifts every Command down over the NULL values and updates its slot, then drops the leftover tail
+    size_t size = 0;
+    for (Command* command : bucket.commands) {
+      if (command != NULL) {
+        command->schedulerSlot = size;
+        bucket.commands[size++] = command;
+      }
+    }
+    bucket.commands.resize(size);
+    bucket.holes = 0;
+  }
+}
+
+void CommandQueue::clear() {
+  for (Bucket& bucket : buckets) {
+    bucket.commands.clear();
+    bucket.holes = 0;
+  }
+  count = 0;
+}
+
+void CommandQueue::reserve(size_t maxCommands, size_t maxPriorities) {
+  bucketCapacity = maxCommands;
+  buckets.reserve(maxPriorities);
+  for (Bucket& bucket : buckets) {
+    bucket.commands.reserve(maxCommands);
+  }
+}
+
+size_t CommandQueue::size() {
+  return count;
+}
+
+size_t CommandQueue::bucketCount() {
+  return buckets.size();
+}
+
+CommandQueue::Commands& CommandQueue::getBucket(size_t index) {
+  return buckets[index].commands;
+}
@@ -0,0 +1,94 @@
+#include "libIterativeRobot/events/ControllerSnapshot.h"
+#include <algorithm>
+
+using namespace libIterativeRobot;
+
+ControllerSnapshot::ControllerSnapshot(pros::Controller* controller) {
+  this->controller = controller;
+}
+
+pros::Controller* ControllerSnapshot::getController() {
+  return controller;
+}
+
+void ControllerSnapshot::useDigital(pros::controller_digital_e_t button) {
+  usedDigital |= std::uint32_t(1) << button;
+}
+
+void ControllerSnapshot::useAnalog(pros::controller_analog_e_t channel) {
+  usedAnalog |= std::uint32_t(1) << channel;
+}
+
+bool ControllerSnapshot::subscribeDigital(pros::controller_digital_e_t button, EventListener* listener) {
+  useDigital(button);
+  if (!hasRoom(subscriptions)) {
+    return false;
+  }
+  subscriptions.push_back({listener, false, std::uint8_t(button)});
+  return true;
+}
+
+bool ControllerSnapshot::subscribeAnalog(pros::controller_analog_e_t channel, EventListener* listener) {
+  useAnalog(channel);
+  if (!hasRoom(subscriptions)) {
+    return false;
+  }
+  subscriptions.push_back({listener, true, std::uint8_t(channel)});
+  return true;
+}
+
+void ControllerSnapshot::unsubscribe(EventListener* listener) {
+  subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                     [listener](const Subscription& subscription) { return subscription.listener == listener; }),
+                      subscriptions.end());
+}
+
+void ControllerSnapshot::capture() {
+  // Reads only the buttons and channels that are in use, one device call each
+  std::uint32_t newDigital = 0;
+  std::int32_t newAnalog[kAnalogChannels];
+  for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+    if ((usedDigital >> button) & 1) {
+      if (controller->get_digital(pros::controller_digital_e_t(button)) == 1) {
+        newDigital |= std::uint32_t(1) << button;
+      }
+    }
+  }
+  for (int channel = 0; channel < kAnalogChannels; channel++) {
+    newAnalog[channel] = (usedAnalog >> channel) & 1 ? controller->get_analog(pros::controller_analog_e_t(channel)) : analog[channel];
+  }
+  apply(newDigital, newAnalog);
+}
+
+void ControllerSnapshot::apply(std::uint32_t digital, const std::int32_t analog[kAnalogChannels]) {
+  std::uint32_t changedDigital = digital ^ this->digital;
+  this->digital = digital;
+  std::uint32_t changedAnalog = 0; // One bit for each channel whose value changed
+  for (int channel = 0; channel < kAnalogChannels; channel++) {
+    if (analog[channel] != this->analog[channel]) {
+      changedAnalog |= std::uint32_t(1) << channel;
+      this->analog[channel] = analog[channel];
+    }
+  }
+
+  // Notifies the subscribers of whatever changed
+  if (changedDigital != 0 || changedAnalog != 0) {
+    for (const Subscription& subscription : subscriptions) {
+      if (((subscription.analog ? changedAnalog : changedDigital) >> subscription.input) & 1) {
+        subscription.listener->notify();
+      }
+    }
+  }
+}
+
+bool ControllerSnapshot::getDigital(pros::controller_digital_e_t button) {
+  return (digital >> button) & 1;
+}
+
+std::int32_t ControllerSnapshot::getAnalog(pros::controller_analog_e_t channel) {
+  return analog[channel];
+}
+
+std::uint32_t ControllerSnapshot::getDigitalBits() {
+  return digital;
+}
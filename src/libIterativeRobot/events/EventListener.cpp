@@ -7,3 +7,26 @@ EventListener::EventListener() {
     // Adds the EventListener instance to the event scheduler
     EventScheduler::getInstance()->addEventListener(this);
 }
+
+EventListener::~EventListener() {
+    EventScheduler::getInstance()->removeEventListener(this);
+#ifdef LIBITERATIVEROBOT_PROFILE
+    Profiler::getInstance()->forget(this);
+#endif
+}
+
+bool EventListener::isRegistered() {
+    return registered;
+}
+
+void EventListener::setAlwaysChecked(bool alwaysChecked) {
+    this->alwaysChecked = alwaysChecked;
+    EventScheduler::getInstance()->markListener(this);
+}
+
+void EventListener::notify() {
+    if (!notified) {
+        notified = true;
+        EventScheduler::getInstance()->markListener(this);
+    }
+}
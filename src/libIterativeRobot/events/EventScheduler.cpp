@@ -1,4 +1,5 @@
 #include "libIterativeRobot/events/EventScheduler.h"
+#include <new>
 
 using namespace libIterativeRobot;
 
@@ -9,10 +10,86 @@ EventScheduler* EventScheduler::instance = NULL;
 EventScheduler::EventScheduler() {
 }
 
+void EventScheduler::captureControllers() {
+  if (inputReplay != NULL) {
+    inputReplay->apply(controllerSnapshots);
+  } else {
+    for (ControllerSnapshot* snapshot : controllerSnapshots) {
+      snapshot->capture();
+    }
+  }
+  if (inputRecorder != NULL) {
+    inputRecorder->record(controllerSnapshots);
+  }
+}
+
 void EventScheduler::checkEventListeners() {
-  // Calls each event listener's check conditions function
-  for (EventListener* listener : eventListeners) {
-    listener->checkConditions();
+  // Calls the check conditions function of each event listener whose bit is set, in the order they were registered.
+  // The bits are read again after each check because listeners can be added, removed or notified by a listener being checked
+  listenerChecks = 0;
+  for (size_t word = 0; word < activeListeners.size(); word++) {
+    std::uint32_t bits = activeListeners[word];
+    while (bits != 0) {
+      size_t bit = __builtin_ctz(bits);
+      EventListener* listener = eventListeners[word * 32 + bit];
+      if (!listener->alwaysChecked) {
+        activeListeners[word] &= ~(std::uint32_t(1) << bit); // Checked until it is notified again
+      }
+      listener->notified = false;
+      {
+        LIBITERATIVEROBOT_PROFILE_LISTENER(listener);
+        listener->checkConditions();
+      }
+      listenerChecks++;
+
+      // Only the bits after this one are left to check in this word
+      bits = bit == 31 ? 0 : activeListeners[word] & (~std::uint32_t(0) << (bit + 1));
+    }
+  }
+
+  // Removes unregistered listeners in a single pass, keeping the remaining listeners in order
+  if (listenerHoles != 0) {
+    size_t size = 0;
+    for (EventListener* listener : eventListeners) {
+      if (listener != NULL) {
+        listener->listenerSlot = size;
+        eventListeners[size++] = listener;
+      }
+    }
+    eventListeners.resize(size);
+    listenerHoles = 0;
+
+    // Every remaining listener has moved, so their bits are set again at their new slots
+    activeListeners.assign((size + 31) / 32, 0);
+    for (EventListener* listener : eventListeners) {
+      markListener(listener);
+    }
+  }
+}
+
+void EventScheduler::markListener(EventListener* eventListener) {
+  if (!eventListener->registered) {
+    return;
+  }
+  size_t slot = eventListener->listenerSlot;
+  std::uint32_t bit = std::uint32_t(1) << (slot % 32);
+  if (eventListener->alwaysChecked || eventListener->notified) {
+    activeListeners[slot / 32] |= bit;
+  } else {
+    activeListeners[slot / 32] &= ~bit;
+  }
+}
+
+void EventScheduler::readSubsystemInputs() {
+  for (Subsystem* subsystem : subsystems) {
+    subsystem->readInputs();
+  }
+}
+
+void EventScheduler::writeSubsystemOutputs() {
+  for (Subsystem* subsystem : subsystems) {
+    subsystem->writeOutputs();
+    subsystem->flushOutputs();
   }
 }
 
@@ -26,42 +103,79 @@ void EventScheduler::addDefaultCommands() {
   }
 }
 
-void EventScheduler::scheduleCommandGroups(std::vector<CommandGroup*>* commandGroups) {
+void EventScheduler::scheduleCommandGroups(CommandGroups* commandGroups) {
   if (commandGroups->size() != 0) {
     CommandGroup* commandGroup;
     for (int i = commandGroups->size() - 1; i >= 0; i--) {
       commandGroup = (*commandGroups)[i]; // Sets commandGroup to the command group currently being checked
+      if (commandGroup == NULL) {
+        continue; // The command group was removed from the scheduler earlier in this update
+      }
 
-      // If the command group's status is interrupted, the command group's interrupted function is called and it is removed from the command group queue
+      // If the command group's status is interrupted, the command group's interrupted function is called and it is set to be removed from the command group queue
       if (commandGroup->status == Status::Interrupted) {
-        commandGroup->interrupted();
-        commandGroups->erase(commandGroups->begin() + i);
+        {
+          LIBITERATIVEROBOT_TRACE_EVENT(CommandInterrupted, commandGroup);
+          LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, interrupted);
+          commandGroup->interrupted();
+        }
+        vacate(commandGroup);
         continue; // Skips over the rest of the logic for the current command group
       } else if (commandGroup->status == Status::Blocked) {
-        commandGroup->blocked();
-        commandGroups->erase(commandGroups->begin() + i);
+        {
+          LIBITERATIVEROBOT_TRACE_EVENT(CommandBlocked, commandGroup);
+          LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, blocked);
+          commandGroup->blocked();
+        }
+        vacate(commandGroup);
         continue; // Skips over the rest of the logic for the current command group
       }
 
       // If the command group is not running, initialize it first
       if (commandGroup->status != Status::Running) {
+        LIBITERATIVEROBOT_TRACE_EVENT(CommandInitialized, commandGroup);
+        LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, initialize);
         commandGroup->initialize();
       }
 
-      commandGroup->execute(); // Call the command group's execute function
+      {
+        LIBITERATIVEROBOT_TRACE_EVENT(ExecuteBegin, commandGroup);
+        LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, execute);
+        commandGroup->execute(); // Call the command group's execute function
+      }
+      LIBITERATIVEROBOT_TRACE_EVENT(ExecuteEnd, commandGroup);
 
-      // If the command group is finished, call its end() function and remove it from the command group queue
-      if (commandGroup->isFinished()) {
-        commandGroup->end();
-        commandGroups->erase(commandGroups->begin() + i);
+      // If the command group is finished, call its end() function and set it to be removed from the command group queue
+      bool finished;
+      {
+        LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, isFinished);
+        finished = commandGroup->isFinished();
+      }
+      if (finished) {
+        {
+          LIBITERATIVEROBOT_TRACE_EVENT(CommandFinished, commandGroup);
+          LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, end);
+          commandGroup->end();
+        }
+        vacate(commandGroup);
         //printf("Command group erased, new size is %d, queue size is %d\n", commandGroups->size(), commandGroupQueue.size());
       }
     }
+
+    // Remove NULL values in a single pass, keeping the remaining command groups in order
+    removeNull(commandGroups);
   }
 }
 
 void EventScheduler::update() {
   //printf("EventScheduler update\n");
+  LIBITERATIVEROBOT_TRACE_UPDATE(UpdateBegin);
+  if (telemetry != NULL) {
+    telemetry->beginUpdate();
+  }
+  drainSubmissions(); // Carries out requests from other tasks before anything else looks at the Commands
+  captureControllers(); // Reads the controllers once, before any EventListener checks them
+  readSubsystemInputs(); // Reads each subsystem's sensors once, so every EventListener and Command sees the same values
   checkEventListeners();
   addDefaultCommands();
 
@@ -77,10 +191,9 @@ void EventScheduler::update() {
   }
 
   //Schedule all commands, running those that can run, finishing those that are finished, and interrupting those that have been interrupted
-  std::vector<Subsystem*> usedSubsystems; // Vector keeping track of which subsystems have already been claimed by a command or command group
+  usedSubsystems.clear(); // Nothing has claimed any subsystems yet this update
   bool canRun; // Stores whether each command or command group can run or not
   toExecute.clear();
-  indexes.clear();
   Command* command;
 
   //printf("Size of commandBuffer is %d, size of commandQueue is %d\n", commandBuffer.size(), commandQueue.size());
@@ -93,94 +206,122 @@ void EventScheduler::update() {
     //printf("There are %d commands in the queue\n", commandQueue.size());
     //pros::delay(1000);
 
-    // Loops backwards through the command queue. The queue is ordered from lowest priority to highest priority, and commands with the same priority are ordered from most recent to oldest
-    for (int i = commandQueue.size() - 1; i >= 0; i--) {
-      command = commandQueue[i];
-      canRun = command->canRun();
-      std::vector<Subsystem*>& commandRequirements = command->getRequirements();
-
-      //printf("Command address is %p, command is %d, size of commandQueue is %d\n", command, i, commandQueue.size());
-      //pros::delay(50);
-
-      // Checks whether the command can run based off of its requirements and priority
-      if ((usedSubsystems.size() == numSubsystems && commandRequirements.size() != 0) || !canRun) {
-        // Shortcut to not iterate through the usedSubsystems vector if all subsystems are being used and the command requires one or more subsystem, or the command cannot run
-        canRun = false;
-      } else {
-        // Loops through the command's requirements
-        for (Subsystem* aSubsystem : commandRequirements) {
-          // If any requirement from the command is already in use by a higher priority command, the command cannot run
-          if (std::find(usedSubsystems.begin(), usedSubsystems.end(), aSubsystem) != usedSubsystems.end()) {
-            canRun = false;
-            break;
-          }
+    // Loops backwards through the command queue's buckets. The buckets are ordered from lowest priority to highest priority, and each bucket is ordered from oldest to most recent, so commands are checked from highest priority to lowest and commands with the same priority from most recent to oldest
+    for (size_t b = commandQueue.bucketCount(); b-- > 0;) {
+      CommandQueue::Commands& bucket = commandQueue.getBucket(b);
+      for (size_t i = bucket.size(); i-- > 0;) {
+        command = bucket[i];
+        if (command == NULL) {
+          continue; // The command was removed from the scheduler earlier in this update
         }
-      }
+        {
+          LIBITERATIVEROBOT_PROFILE_COMMAND(command, canRun);
+          canRun = command->canRun();
+        }
+        SubsystemMask& commandRequirements = command->getRequirementMask();
 
-      // Calls the command's appropriate functions based off of whether it can run
-      if (canRun) {
-        // Adds the command's requirements to the list of requirements that are in use
-        usedSubsystems.insert(usedSubsystems.end(), commandRequirements.begin(), commandRequirements.end());
-
-        // Stores the command in another vector to by executed later. It is not executed here because all interrupted methods need to run before any initialize or execute methods can run
-        toExecute.push_back(command);
-        indexes.push_back(i);
-      } else {
-        // If the command group is running, call its interrupted() function
-        if (command->status == Status::Running) {
-          command->status = Status::Interrupted;
-          command->interrupted();
-        } else { // Otherwise, call its blocked() function
-          command->status = Status::Blocked;
-          command->blocked();
+        // Checks whether the command can run based off of its requirements and priority. If any requirement from the command is already in use by a higher priority command, the command cannot run
+        if (canRun && commandRequirements.intersects(usedSubsystems)) {
+          canRun = false;
         }
 
-        // Set the command to be removed from the queue if it is not a default command
-        if (command->priority > 0) {
-          commandQueue[i] = NULL;
+        // Calls the command's appropriate functions based off of whether it can run
+        if (canRun) {
+          // Adds the command's requirements to the set of requirements that are in use
+          usedSubsystems.merge(commandRequirements);
+
+          // Stores the command in another vector to by executed later. It is not executed here because all interrupted methods need to run before any initialize or execute methods can run
+          toExecute.push_back(command);
+        } else {
+          // If the command group is running, call its interrupted() function
+          if (command->status == Status::Running) {
+            command->status = Status::Interrupted;
+            LIBITERATIVEROBOT_TRACE_EVENT(CommandInterrupted, command);
+            LIBITERATIVEROBOT_PROFILE_COMMAND(command, interrupted);
+            command->interrupted();
+          } else { // Otherwise, call its blocked() function
+            command->status = Status::Blocked;
+            LIBITERATIVEROBOT_TRACE_EVENT(CommandBlocked, command);
+            LIBITERATIVEROBOT_PROFILE_COMMAND(command, blocked);
+            command->blocked();
+          }
+
+          // Set the command to be removed from the queue if it is not a default command
+          if (command->priority > 0) {
+            vacate(command);
+          }
         }
       }
     }
 
     // Loop through the toExecute vector and initialize, execute, or end the commands as necessary
-    unsigned int i = 0;
     for (Command* command : toExecute) {
+      // Skip commands that were stopped by a command that executed before them
+      if (command->schedulerLocation != Command::SchedulerLocation::CommandQueue) {
+        continue;
+      }
+
       // If the command group is not running, initialize it first
       if (command->status != Status::Running) {
         command->status = Status::Running;
+        LIBITERATIVEROBOT_TRACE_EVENT(CommandInitialized, command);
+        LIBITERATIVEROBOT_PROFILE_COMMAND(command, initialize);
         command->initialize();
       }
 
-      command->execute();
+      {
+        LIBITERATIVEROBOT_TRACE_EVENT(ExecuteBegin, command);
+        LIBITERATIVEROBOT_PROFILE_COMMAND(command, execute);
+        command->execute();
+      }
+      LIBITERATIVEROBOT_TRACE_EVENT(ExecuteEnd, command);
 
       // If the command is finished, call its end() function and remove it from the command queue if it is not a default command
-      if (command->isFinished()) {
+      bool finished;
+      {
+        LIBITERATIVEROBOT_PROFILE_COMMAND(command, isFinished);
+        finished = command->isFinished();
+      }
+      if (finished) {
         command->status = Status::Finished;
-        command->end();
+        {
+          LIBITERATIVEROBOT_TRACE_EVENT(CommandFinished, command);
+          LIBITERATIVEROBOT_PROFILE_COMMAND(command, end);
+          command->end();
+        }
         if (command->priority > 0) {
-          commandQueue[indexes[i]] = NULL;
+          vacate(command);
         }
       }
-      i++;
     }
 
     // Remove NULL values from the commandQueue
-    for (int i = commandQueue.size() - 1; i >= 0; i--) {
-      if (commandQueue[i] == NULL) {
-        commandQueue.erase(commandQueue.begin() + i);
-      }
-    }
+    commandQueue.compact();
+  }
+
+  writeSubsystemOutputs(); // Sends what the commands set to each subsystem's motors, once per subsystem
+  if (telemetry != NULL) {
+    telemetry->sample(); // Records how the update left every command and subsystem
   }
 
+  LIBITERATIVEROBOT_TRACE_UPDATE(UpdateEnd);
   //delay(5);
 }
 
 void EventScheduler::addCommand(Command* command) {
   // Makes sure the command is not in the scheduler yet and then adds it to the buffer
   if (!commandInScheduler(command)) {
-    commandBuffer.push_back(command);
+    if (place(command, &commandBuffer, Command::SchedulerLocation::CommandBuffer)) {
+      LIBITERATIVEROBOT_TRACE_EVENT(CommandQueued, command);
+    } else {
+      LIBITERATIVEROBOT_TRACE_EVENT(CommandBlocked, command);
+      LIBITERATIVEROBOT_PROFILE_COMMAND(command, blocked);
+      command->blocked();
+    }
   } else {
     command->status = Status::Blocked;
+    LIBITERATIVEROBOT_TRACE_EVENT(CommandBlocked, command);
+    LIBITERATIVEROBOT_PROFILE_COMMAND(command, blocked);
     command->blocked();
   }
   //printf("Command added, address is %p\n", command);
@@ -188,24 +329,36 @@ void EventScheduler::addCommand(Command* command) {
 
 void EventScheduler::addCommandGroup(CommandGroup* commandGroup) {
   // If the command group is not already in the scheduler, the command group is added to the end of the buffer
-  if (!commandGroupInScheduler(commandGroup)) {
-    commandGroupBuffer.push_back(commandGroup);
+  if (!commandGroupInScheduler(commandGroup) &&
+      place(commandGroup, &commandGroupBuffer, Command::SchedulerLocation::CommandGroupBuffer)) {
+    LIBITERATIVEROBOT_TRACE_EVENT(CommandQueued, commandGroup);
+  }
+}
+
+void EventScheduler::drainSubmissions() {
+  Command* command;
+  SubmissionQueue::Request request;
+  while (submissionQueue.pop(command, request)) {
+    if (request == SubmissionQueue::Request::Run) {
+      command->run();
+    } else {
+      command->stop();
+    }
   }
 }
 
 void EventScheduler::queueCommands() {
-  // Adds the commands in the command buffer into the command queue in order of priority
+  // Adds the commands in the command buffer into the command queue. Each one goes after every command already in the queue with the same priority
   //say("CommandBuffer size is %d\n", commandBuffer.size());
   for (Command* command : commandBuffer) {
-    for (size_t i = 0; i < commandQueue.size(); i++) {
-      if (command->priority < commandQueue[i]->priority) {
-        commandQueue.insert(commandQueue.begin() + i, command);
-        goto alreadyAdded;
-      }
+    if (command != NULL && !commandQueue.push(command)) { // Commands stopped before they could be queued are NULL
+      // There was no room for the command, so it is blocked instead
+      command->schedulerLocation = Command::SchedulerLocation::None;
+      command->status = Status::Blocked;
+      LIBITERATIVEROBOT_TRACE_EVENT(CommandBlocked, command);
+      LIBITERATIVEROBOT_PROFILE_COMMAND(command, blocked);
+      command->blocked();
     }
-    //say("Command added to command queue\n");
-    commandQueue.push_back(command);
-    alreadyAdded:;
   }
 
   // Clears the command buffer
@@ -215,7 +368,8 @@ void EventScheduler::queueCommands() {
 void EventScheduler::toIntermediateBuffer() {
   // Adds all command groups in the command group buffer into the intermediate group buffer
   for (CommandGroup* commandGroup : commandGroupBuffer)
-    intermediateGroupBuffer.push_back(commandGroup);
+    if (commandGroup != NULL)
+      place(commandGroup, &intermediateGroupBuffer, Command::SchedulerLocation::IntermediateGroupBuffer);
 
   // Clears the command group buffer
   commandGroupBuffer.clear();
@@ -224,7 +378,8 @@ void EventScheduler::toIntermediateBuffer() {
 void EventScheduler::toGroupQueue() {
   // Adds all command groups in the intermediate group buffer into the command group queue
   for (CommandGroup* commandGroup : intermediateGroupBuffer)
-    commandGroupQueue.push_back(commandGroup);
+    if (commandGroup != NULL)
+      place(commandGroup, &commandGroupQueue, Command::SchedulerLocation::CommandGroupQueue);
 
   // Clears the intermediate group buffer
   intermediateGroupBuffer.clear();
@@ -233,60 +388,82 @@ void EventScheduler::toGroupQueue() {
 void EventScheduler::queueCommandGroups() {
   // Adds all command groups in the command group buffer into the command group queue
   for (CommandGroup* commandGroup : commandGroupBuffer)
-    commandGroupQueue.push_back(commandGroup);
+    if (commandGroup != NULL)
+      place(commandGroup, &commandGroupQueue, Command::SchedulerLocation::CommandGroupQueue);
 
   // Clears the command group buffer
   commandGroupBuffer.clear();
 }
 
 void EventScheduler::removeCommand(Command* command) {
-  // Removes the command
-  size_t index = std::find(commandBuffer.begin(), commandBuffer.end(), command) - commandBuffer.begin(); // Get the index of the command in the commandBuffer vector
-  if (index >= commandBuffer.size()) { // If the command is not in the commandBuffer vector, check in the commandQueue vector
-    index = std::find(commandQueue.begin(), commandQueue.end(), command) - commandQueue.begin(); // Get the index of the command in the commandQueue vector
-    if (index >= commandQueue.size()) { // If the command is not in the commandQueue vector, return
-      // Command not found, return
-      return;
-    }
-    commandQueue.erase(commandQueue.begin() + index); // Remove command from commandQueue
-  } else {
-    commandBuffer.erase(commandBuffer.begin() + index); // Remove command from commandBuffer
+  // If the command is not in the commandBuffer or commandQueue, return
+  if (!commandInScheduler(command)) {
+    return;
   }
 
+  // Removes the command from whichever one it is in
+  vacate(command);
+
   // Blocks or interrupts the command being removed
   if (command->status == Status::Running) {
     command->status = Status::Interrupted;
+    LIBITERATIVEROBOT_TRACE_EVENT(CommandInterrupted, command);
+    LIBITERATIVEROBOT_PROFILE_COMMAND(command, interrupted);
     command->interrupted();
   } else {
     command->status = Status::Blocked;
+    LIBITERATIVEROBOT_TRACE_EVENT(CommandBlocked, command);
+    LIBITERATIVEROBOT_PROFILE_COMMAND(command, blocked);
     command->blocked();
   }
 }
 
 void EventScheduler::removeCommandGroup(CommandGroup* commandGroup) {
-  // Removes the command group
-  size_t index = std::find(commandGroupBuffer.begin(), commandGroupBuffer.end(), commandGroup) - commandGroupBuffer.begin();  // Get the index of the command group in the commandGroupBuffer vector
-  if (index >= commandGroupBuffer.size()) { // If the command group is not in the commandGroupBuffer vector, check in the commandGroupQueue vector
-    index = std::find(commandGroupQueue.begin(), commandGroupQueue.end(), commandGroup) - commandGroupQueue.begin(); // Get the index of the command group in the commandGroupsQueue vector
-    if (index >= commandGroupQueue.size()) { // If the command group is not in the commandGroupQueue vector, return
-      return;
-    }
-    commandGroupQueue.erase(commandGroupQueue.begin() + index); // Remove command group from commandGroupQueue
-  } else {
-    commandGroupBuffer.erase(commandGroupBuffer.begin() + index); // Remove command group from commandGroupBuffer
+  // If the command group is not in the commandGroupBuffer, intermediateGroupBuffer or commandGroupQueue, return
+  if (!commandGroupInScheduler(commandGroup)) {
+    return;
   }
 
+  // Removes the command group from whichever one it is in
+  vacate(commandGroup);
+
   // Interrupts the command group being removed
+  LIBITERATIVEROBOT_TRACE_EVENT(CommandInterrupted, commandGroup);
+  LIBITERATIVEROBOT_PROFILE_COMMAND(commandGroup, interrupted);
   commandGroup->interrupted();
 }
 
 void EventScheduler::clearScheduler() {
   for (Command* command : commandBuffer) {
-    command->interrupted();
+    if (command != NULL) {
+      command->schedulerLocation = Command::SchedulerLocation::None;
+      LIBITERATIVEROBOT_TRACE_EVENT(CommandInterrupted, command);
+      LIBITERATIVEROBOT_PROFILE_COMMAND(command, interrupted);
+      command->interrupted();
+    }
   }
 
-  for (Command* command : commandQueue) {
-    command->interrupted();
+  for (size_t b = 0; b < commandQueue.bucketCount(); b++) {
+    for (Command* command : commandQueue.getBucket(b)) {
+      if (command != NULL) {
+        command->schedulerLocation = Command::SchedulerLocation::None;
+        LIBITERATIVEROBOT_TRACE_EVENT(CommandInterrupted, command);
+        LIBITERATIVEROBOT_PROFILE_COMMAND(command, interrupted);
+        command->interrupted();
+      }
+    }
+  }
+
+  for (CommandGroup* commandGroup : commandGroupBuffer) {
+    if (commandGroup != NULL) {
+      commandGroup->schedulerLocation = Command::SchedulerLocation::None;
+    }
+  }
+
+  for (CommandGroup* commandGroup : commandGroupQueue) {
+    if (commandGroup != NULL) {
+      commandGroup->schedulerLocation = Command::SchedulerLocation::None;
+    }
   }
 
   commandBuffer.clear();
@@ -296,24 +473,164 @@ void EventScheduler::clearScheduler() {
 }
 
 void EventScheduler::addEventListener(EventListener* eventListener) {
+  if (eventListener->registered) {
+    return; // Already registered, for example by the EventListener constructor
+  }
+  if (!hasRoom(eventListeners)) {
+    return; // Never checked, and counted as an overflow
+  }
+  eventListener->registered = true;
+  eventListener->listenerSlot = eventListeners.size();
   this->eventListeners.push_back(eventListener);
+  if (eventListeners.size() > activeListeners.size() * 32) {
+    activeListeners.push_back(0);
+  }
+  markListener(eventListener);
+}
+
+void EventScheduler::removeEventListener(EventListener* eventListener) {
+  if (!eventListener->registered) {
+    return;
+  }
+  eventListeners[eventListener->listenerSlot] = NULL;
+  activeListeners[eventListener->listenerSlot / 32] &= ~(std::uint32_t(1) << (eventListener->listenerSlot % 32));
+  eventListener->registered = false;
+  listenerHoles++;
+}
+
+size_t EventScheduler::getListenerCount() {
+  return eventListeners.size() - listenerHoles;
+}
+
+size_t EventScheduler::getListenerChecks() {
+  return listenerChecks;
+}
+
+bool EventScheduler::submit(Command* command, SubmissionQueue::Request request) {
+  return submissionQueue.push(command, request);
+}
+
+std::uint32_t EventScheduler::getDroppedSubmissions() {
+  return submissionQueue.getDropped();
+}
+
+ControllerSnapshot* EventScheduler::getControllerSnapshot(pros::Controller* controller) {
+  for (ControllerSnapshot* snapshot : controllerSnapshots) {
+    if (snapshot->getController() == controller) {
+      return snapshot;
+    }
+  }
+#ifdef LIBITERATIVEROBOT_STATIC
+  if (!hasRoom(controllerSnapshots)) {
+    return &spareSnapshot;
+  }
+  ControllerSnapshot* snapshot = new (snapshotStorage[controllerSnapshots.size()]) ControllerSnapshot(controller);
+#else
+  ControllerSnapshot* snapshot = new ControllerSnapshot(controller);
+#endif
+  controllerSnapshots.push_back(snapshot);
+  return snapshot;
+}
+
+void EventScheduler::setInputRecorder(InputRecorder* recorder) {
+  inputRecorder = recorder;
+}
+
+void EventScheduler::setInputReplay(InputReplay* replay) {
+  inputReplay = replay;
+}
+
+void EventScheduler::setTelemetry(Telemetry* telemetry) {
+  this->telemetry = telemetry;
+}
+
+Command* EventScheduler::getActiveCommand(Subsystem* subsystem) {
+  for (size_t b = commandQueue.bucketCount(); b-- > 0;) {
+    for (Command* command : commandQueue.getBucket(b)) {
+      if (command != NULL && command->status == Status::Running &&
+          command->getRequirementMask().test(subsystem->getIndex())) {
+        return command;
+      }
+    }
+  }
+  return NULL;
 }
 
 void EventScheduler::trackSubsystem(Subsystem *aSubsystem) {
-  this->subsystems.push_back(aSubsystem);
-  numSubsystems++; // Keeps track of the number of subsystems
+  aSubsystem->index = numSubsystems++; // Gives the subsystem the next free bit in SubsystemMasks
+  this->subsystems.push_back(aSubsystem); // Past LIBITERATIVEROBOT_MAX_SUBSYSTEMS this is counted and dropped
 }
 
 bool EventScheduler::commandInScheduler(Command* aCommand) {
-  bool inCommandsToBeAdded = std::find(commandBuffer.begin(), commandBuffer.end(), aCommand) != commandBuffer.end();
-  bool inCommandQueue = std::find(commandQueue.begin(), commandQueue.end(), aCommand) != commandQueue.end();
-  return inCommandsToBeAdded || inCommandQueue;
+  return aCommand->schedulerLocation == Command::SchedulerLocation::CommandBuffer ||
+         aCommand->schedulerLocation == Command::SchedulerLocation::CommandQueue;
 }
 
 bool EventScheduler::commandGroupInScheduler(CommandGroup* aCommandGroup) {
-  bool inCommandGroupsToBeAdded = std::find(commandGroupBuffer.begin(), commandGroupBuffer.end(), aCommandGroup) != commandGroupBuffer.end();
-  bool inCommandGroupQueue = std::find(commandGroupQueue.begin(), commandGroupQueue.end(), aCommandGroup) != commandGroupQueue.end();
-  return inCommandGroupsToBeAdded || inCommandGroupQueue;
+  return aCommandGroup->schedulerLocation == Command::SchedulerLocation::CommandGroupBuffer ||
+         aCommandGroup->schedulerLocation == Command::SchedulerLocation::IntermediateGroupBuffer ||
+         aCommandGroup->schedulerLocation == Command::SchedulerLocation::CommandGroupQueue;
+}
+
+template <typename T, typename Queue>
+bool EventScheduler::place(T* command, Queue* queue, Command::SchedulerLocation location) {
+  if (!hasRoom(*queue)) {
+    command->schedulerLocation = Command::SchedulerLocation::None;
+    command->status = Status::Blocked;
+    return false;
+  }
+  command->schedulerLocation = location;
+  command->schedulerSlot = queue->size();
+  queue->push_back(command);
+  return true;
+}
+
+void EventScheduler::vacate(Command* command) {
+  // Sets the command's slot to NULL so that it is skipped and later removed, without shifting any other command
+  switch (command->schedulerLocation) {
+    case Command::SchedulerLocation::CommandBuffer:
+      commandBuffer[command->schedulerSlot] = NULL;
+      break;
+    case Command::SchedulerLocation::CommandQueue:
+      commandQueue.remove(command);
+      break;
+    case Command::SchedulerLocation::CommandGroupBuffer:
+      commandGroupBuffer[command->schedulerSlot] = NULL;
+      break;
+    case Command::SchedulerLocation::IntermediateGroupBuffer:
+      intermediateGroupBuffer[command->schedulerSlot] = NULL;
+      break;
+    case Command::SchedulerLocation::CommandGroupQueue:
+      commandGroupQueue[command->schedulerSlot] = NULL;
+      break;
+    case Command::SchedulerLocation::None:
+      break;
+  }
+  command->schedulerLocation = Command::SchedulerLocation::None;
+}
+
+template <typename Queue>
+void EventScheduler::removeNull(Queue* queue) {
+  // Shifts every non-NULL element down over the NULL ones and updates its slot, then drops the leftover tail. Unlike
+  // erasing each NULL individually this is a single pass, and since it only ever shrinks the vector it never allocates
+  size_t size = 0;
+  for (auto command : *queue) {
+    if (command != NULL) {
+      command->schedulerSlot = size;
+      (*queue)[size++] = command;
+    }
+  }
+  queue->resize(size);
+}
+
+void EventScheduler::reserve(size_t maxCommands, size_t maxCommandGroups, size_t maxPriorities) {
+  commandQueue.reserve(maxCommands, maxPriorities);
+  commandBuffer.reserve(maxCommands);
+  toExecute.reserve(maxCommands);
+
+  commandGroupQueue.reserve(maxCommandGroups);
+  commandGroupBuffer.reserve(maxCommandGroups);
+  intermediateGroupBuffer.reserve(maxCommandGroups);
 }
 
 void EventScheduler::initialize(bool noDefaultCommands) {
@@ -323,7 +640,9 @@ void EventScheduler::initialize(bool noDefaultCommands) {
 
 EventScheduler* EventScheduler::getInstance() {
     if (instance == NULL) {
-        instance = new EventScheduler();
+        // Built in static storage and never destroyed, so EventListeners destroyed at exit can still unregister
+        alignas(EventScheduler) static unsigned char storage[sizeof(EventScheduler)];
+        instance = new (storage) EventScheduler();
     }
     return instance;
 }
@@ -0,0 +1,101 @@
+#include "libIterativeRobot/events/InputRecorder.h"
+
+using namespace libIterativeRobot;
+
+const char InputRecorder::kMagic[4] = {'L', 'I', 'R', 'I'};
+
+InputRecorder::InputRecorder(size_t reserveBytes) {
+  data.reserve(reserveBytes);
+}
+
+void InputRecorder::flushIdleRun() {
+  if (idleRun > 0) {
+    data.push_back(idleRun);
+    idleRun = 0;
+  }
+}
+
+void InputRecorder::record(const ControllerSnapshots& snapshots) {
+  ticks++;
+
+  // Snapshots past the 64th can't be given an index, so they are not recorded
+  size_t count = snapshots.size() < 64 ? snapshots.size() : 64;
+  if (states.size() < count) {
+    states.resize(count, State{0, {}});
+  }
+
+  // The last change frame written this update, whose "more" bit is set if another one follows it
+  size_t lastFrame = 0;
+  bool changed = false;
+  for (size_t i = 0; i < count; i++) {
+    ControllerSnapshot* snapshot = snapshots[i];
+    State& state = states[i];
+    std::uint32_t digital = snapshot->getDigitalBits();
+    std::uint32_t changedDigital = (digital ^ state.digital) >> kFirstButton;
+    std::uint8_t what = changedDigital != 0 ? 1 : 0;
+    std::int8_t values[ControllerSnapshot::kAnalogChannels];
+    int valueCount = 0;
+    for (int channel = 0; channel < ControllerSnapshot::kAnalogChannels; channel++) {
+      std::int32_t value = snapshot->getAnalog(pros::controller_analog_e_t(channel));
+      value = value < -128 ? -128 : value > 127 ? 127 : value;
+      if (value != state.analog[channel]) {
+        what |= 2 << channel;
+        values[valueCount++] = std::int8_t(value);
+        state.analog[channel] = value;
+      }
+    }
+    state.digital = digital;
+    if (what == 0) {
+      continue;
+    }
+
+    if (!changed) {
+      flushIdleRun();
+      changed = true;
+    } else {
+      data[lastFrame] |= 0x40;
+    }
+    lastFrame = data.size();
+    data.push_back(0x80 | std::uint8_t(i));
+    data.push_back(what);
+    if (changedDigital != 0) {
+      data.push_back(std::uint8_t(changedDigital));
+      data.push_back(std::uint8_t(changedDigital >> 8));
+    }
+    data.insert(data.end(), values, values + valueCount);
+  }
+
+  if (!changed && ++idleRun == 127) {
+    flushIdleRun();
+  }
+}
+
+void InputRecorder::clear() {
+  data.clear();
+  states.clear();
+  ticks = 0;
+  idleRun = 0;
+}
+
+std::uint32_t InputRecorder::getTicks() {
+  return ticks;
+}
+
+const std::vector<std::uint8_t>& InputRecorder::getData() {
+  flushIdleRun();
+  return data;
+}
+
+std::uint8_t InputRecorder::getSnapshotCount() {
+  return std::uint8_t(states.size());
+}
+
+bool InputRecorder::save(FILE* file) {
+  flushIdleRun();
+  std::uint8_t header[10] = {std::uint8_t(kMagic[0]), std::uint8_t(kMagic[1]), std::uint8_t(kMagic[2]),
+                             std::uint8_t(kMagic[3]), kVersion, getSnapshotCount(),
+                             std::uint8_t(ticks), std::uint8_t(ticks >> 8), std::uint8_t(ticks >> 16),
+                             std::uint8_t(ticks >> 24)};
+  return std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+         (data.empty() || std::fwrite(data.data(), 1, data.size(), file) == data.size());
+}
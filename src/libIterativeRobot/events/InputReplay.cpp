@@ -0,0 +1,114 @@
+#include "libIterativeRobot/events/InputReplay.h"
+#include "libIterativeRobot/events/InputRecorder.h"
+#include <cstring>
+
+using namespace libIterativeRobot;
+
+InputReplay::InputReplay() {
+}
+
+InputReplay::InputReplay(InputRecorder& recorder) {
+  data = recorder.getData();
+  ticks = recorder.getTicks();
+  states.resize(recorder.getSnapshotCount(), State{0, {}});
+}
+
+bool InputReplay::load(FILE* file) {
+  data.clear();
+  states.clear();
+  ticks = 0;
+  rewind();
+
+  std::uint8_t header[10];
+  if (std::fread(header, 1, sizeof(header), file) != sizeof(header) ||
+      std::memcmp(header, InputRecorder::kMagic, sizeof(InputRecorder::kMagic)) != 0 ||
+      header[4] != InputRecorder::kVersion) {
+    return false;
+  }
+
+  std::uint8_t buffer[256];
+  size_t read;
+  while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + read);
+  }
+  if (std::ferror(file)) {
+    data.clear();
+    return false;
+  }
+  ticks = header[6] | std::uint32_t(header[7]) << 8 | std::uint32_t(header[8]) << 16 | std::uint32_t(header[9]) << 24;
+  states.resize(header[5], State{0, {}});
+  return true;
+}
+
+std::uint8_t InputReplay::next() {
+  return position < data.size() ? data[position++] : 0;
+}
+
+void InputReplay::apply(const ControllerSnapshots& snapshots) {
+  if (isFinished()) {
+    // Releases everything, so nothing keeps running off the end of the recording
+    const std::int32_t centered[ControllerSnapshot::kAnalogChannels] = {};
+    for (ControllerSnapshot* snapshot : snapshots) {
+      snapshot->apply(0, centered);
+    }
+    return;
+  }
+  tick++;
+
+  if (idleRun > 0) {
+    idleRun--;
+  } else {
+    std::uint8_t frame = next();
+    if (frame & 0x80) {
+      // Applies each change in this update to the recorded state of its snapshot
+      while (true) {
+        std::uint8_t what = next();
+        size_t index = frame & 0x3f;
+        State discarded = {0, {}};
+        State& state = index < states.size() ? states[index] : discarded;
+        if (what & 1) {
+          std::uint32_t changed = next();
+          changed |= std::uint32_t(next()) << 8;
+          state.digital ^= changed << InputRecorder::kFirstButton;
+        }
+        for (int channel = 0; channel < ControllerSnapshot::kAnalogChannels; channel++) {
+          if ((what >> (channel + 1)) & 1) {
+            state.analog[channel] = std::int8_t(next());
+          }
+        }
+        if (!(frame & 0x40)) {
+          break;
+        }
+        frame = next();
+      }
+    } else if (frame > 0) {
+      idleRun = frame - 1;
+    }
+  }
+
+  size_t count = snapshots.size() < states.size() ? snapshots.size() : states.size();
+  for (size_t i = 0; i < count; i++) {
+    snapshots[i]->apply(states[i].digital, states[i].analog);
+  }
+}
+
+void InputReplay::rewind() {
+  tick = 0;
+  position = 0;
+  idleRun = 0;
+  for (State& state : states) {
+    state = State{0, {}};
+  }
+}
+
+bool InputReplay::isFinished() {
+  return tick >= ticks;
+}
+
+std::uint32_t InputReplay::getTicks() {
+  return ticks;
+}
+
+std::uint32_t InputReplay::getTick() {
+  return tick;
+}
@@ -6,10 +6,17 @@ using namespace libIterativeRobot;
 JoystickButton::JoystickButton(pros::Controller* controller, pros::controller_digital_e_t button) {
   this->controller = controller;
   this->button = button;
+
+  snapshot = EventScheduler::getInstance()->getControllerSnapshot(controller);
+  setNotifiedOnChange(snapshot->subscribeDigital(button, this)); // Checked on every update if it could not subscribe
+}
+
+JoystickButton::~JoystickButton() {
+  snapshot->unsubscribe(this);
 }
 
 bool JoystickButton::getState() {
-  return (controller->get_digital(button) == 1);
+  return snapshot->getDigital(button);
 }
 
 void JoystickButton::whenPressed(Command* command, Action action) {
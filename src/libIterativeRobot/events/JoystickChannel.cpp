@@ -7,11 +7,16 @@ JoystickChannel::JoystickChannel(pros::Controller* controller, pros::controller_
   this->controller = controller;
   this->channel = channel;
 
-  EventScheduler::getInstance()->addEventListener(this);
+  snapshot = EventScheduler::getInstance()->getControllerSnapshot(controller);
+  setNotifiedOnChange(snapshot->subscribeAnalog(channel, this)); // Checked on every update if it could not subscribe
+}
+
+JoystickChannel::~JoystickChannel() {
+  snapshot->unsubscribe(this);
 }
 
 bool JoystickChannel::getState() {
-  return (abs(controller->get_analog(channel)) > threshold);
+  return (abs(snapshot->getAnalog(channel)) > threshold);
 }
 
 void JoystickChannel::whenPassingThresholdForward(Command* command, Action action) {
@@ -32,4 +37,5 @@ void JoystickChannel::whileWithinThreshold(Command* command, Action action) {
 
 void JoystickChannel::setThreshold(std::int32_t threshold) {
   this->threshold = threshold;
+  notify(); // The channel may be on the other side of the new threshold
 }
@@ -0,0 +1,114 @@
+#include "libIterativeRobot/events/Profiler.h"
+
+#ifdef LIBITERATIVEROBOT_PROFILE
+
+#include "libIterativeRobot/commands/Command.h"
+#include "libIterativeRobot/events/EventListener.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <typeinfo>
+
+using namespace libIterativeRobot;
+
+Profiler* Profiler::instance = 0;
+
+Profiler::Profiler() {
+}
+
+Profiler* Profiler::getInstance() {
+  if (instance == NULL) {
+    instance = new Profiler();
+  }
+  return instance;
+}
+
+CommandProfile& Profiler::of(Command* command) {
+  if (!command->profile.tracked) {
+    command->profile.tracked = true;
+    commands.push_back(command);
+  }
+  return command->profile;
+}
+
+ListenerProfile& Profiler::of(EventListener* listener) {
+  if (!listener->profile.tracked) {
+    listener->profile.tracked = true;
+    listeners.push_back(listener);
+  }
+  return listener->profile;
+}
+
+void Profiler::forget(Command* command) {
+  if (command->profile.tracked) {
+    commands.erase(std::find(commands.begin(), commands.end(), command));
+  }
+}
+
+void Profiler::forget(EventListener* listener) {
+  if (listener->profile.tracked) {
+    listeners.erase(std::find(listeners.begin(), listeners.end(), listener));
+  }
+}
+
+const std::vector<Command*>& Profiler::getCommands() {
+  return commands;
+}
+
+const std::vector<EventListener*>& Profiler::getListeners() {
+  return listeners;
+}
+
+void Profiler::reset() {
+  for (Command* command : commands) {
+    command->profile = CommandProfile();
+    command->profile.tracked = true;
+  }
+  for (EventListener* listener : listeners) {
+    listener->profile = ListenerProfile();
+    listener->profile.tracked = true;
+  }
+}
+
+namespace {
+  // Prints the demangled name of an object's type, falling back to the mangled name if it cannot be demangled
+  template <typename T>
+  void printType(FILE* file, T* object) {
+    const char* mangled = typeid(*object).name();
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, NULL, NULL, &status);
+    std::fprintf(file, "%-40.40s %-14p", status == 0 ? demangled : mangled, static_cast<void*>(object));
+    std::free(demangled);
+  }
+
+  void printMethod(FILE* file, const char* name, const MethodProfile& method) {
+    if (method.calls == 0) {
+      return;
+    }
+    std::fprintf(file, "  %-15s %10lu %12llu %10lu %10.1f\n", name, (unsigned long)method.calls,
+                 (unsigned long long)method.totalMicros, (unsigned long)method.maxMicros,
+                 double(method.totalMicros) / method.calls);
+  }
+}
+
+void Profiler::dump(FILE* file) {
+  std::fprintf(file, "  %-15s %10s %12s %10s %10s\n", "method", "calls", "total us", "max us", "mean us");
+  for (Command* command : commands) {
+    printType(file, command);
+    std::fprintf(file, "\n");
+    printMethod(file, "canRun", command->profile.canRun);
+    printMethod(file, "initialize", command->profile.initialize);
+    printMethod(file, "execute", command->profile.execute);
+    printMethod(file, "isFinished", command->profile.isFinished);
+    printMethod(file, "end", command->profile.end);
+    printMethod(file, "interrupted", command->profile.interrupted);
+    printMethod(file, "blocked", command->profile.blocked);
+  }
+  for (EventListener* listener : listeners) {
+    printType(file, listener);
+    std::fprintf(file, "\n");
+    printMethod(file, "checkConditions", listener->profile.checkConditions);
+  }
+}
+
+#endif // LIBITERATIVEROBOT_PROFILE
@@ -0,0 +1,57 @@
+#include "libIterativeRobot/events/SubmissionQueue.h"
+
+static_assert((LIBITERATIVEROBOT_SUBMISSION_CAPACITY & (LIBITERATIVEROBOT_SUBMISSION_CAPACITY - 1)) == 0,
+              "LIBITERATIVEROBOT_SUBMISSION_CAPACITY must be a power of two");
+
+using namespace libIterativeRobot;
+
+SubmissionQueue::SubmissionQueue() : pushPosition(0), dropped(0) {
+  for (std::uint32_t i = 0; i < LIBITERATIVEROBOT_SUBMISSION_CAPACITY; i++) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+    slots[i].command = NULL;
+    slots[i].request = Request::Run;
+  }
+}
+
+bool SubmissionQueue::push(Command* command, Request request) {
+  std::uint32_t position = pushPosition.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots[position % LIBITERATIVEROBOT_SUBMISSION_CAPACITY];
+    std::int32_t difference = std::int32_t(slot->sequence.load(std::memory_order_acquire) - position);
+    if (difference == 0) {
+      // The slot is free for this position, so claim the position unless another task got to it first
+      if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // The slot still holds the request pushed a lap ago, which has not been popped yet
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      // Another task claimed this position since it was read
+      position = pushPosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->command = command;
+  slot->request = request;
+  slot->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+bool SubmissionQueue::pop(Command*& command, Request& request) {
+  Slot& slot = slots[popPosition % LIBITERATIVEROBOT_SUBMISSION_CAPACITY];
+  if (slot.sequence.load(std::memory_order_acquire) != popPosition + 1) {
+    return false; // Empty, or the next push has claimed the slot but not written to it yet
+  }
+  command = slot.command;
+  request = slot.request;
+  slot.sequence.store(popPosition + LIBITERATIVEROBOT_SUBMISSION_CAPACITY, std::memory_order_release);
+  popPosition++;
+  return true;
+}
+
+std::uint32_t SubmissionQueue::getDropped() {
+  return dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,215 @@
+#include "libIterativeRobot/events/Telemetry.h"
+#include "libIterativeRobot/events/EventScheduler.h"
+#include "libIterativeRobot/Clock.h"
+#include "pros/apix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace libIterativeRobot;
+
+static_assert((LIBITERATIVEROBOT_TELEMETRY_BUFFER & (LIBITERATIVEROBOT_TELEMETRY_BUFFER - 1)) == 0,
+              "LIBITERATIVEROBOT_TELEMETRY_BUFFER must be a power of two");
+
+Telemetry::Telemetry() : head(0), tail(0), dropped(0), written(0) {
+  addChannel(TelemetryChannelKind::UpdateTime, "updateMicros", 1, NULL);
+}
+
+bool Telemetry::addChannel(TelemetryChannelKind kind, const char* name, float scale, const void* source) {
+  if (channels.size() >= LIBITERATIVEROBOT_MAX_TELEMETRY_CHANNELS) {
+    return false;
+  }
+  Channel channel;
+  channel.kind = kind;
+  std::strncpy(channel.name, name, sizeof(channel.name) - 1);
+  channel.name[sizeof(channel.name) - 1] = '\0';
+  channel.scale = scale;
+  channel.source = source;
+  channel.last = 0;
+  channels.push_back(channel);
+
+  // Readers need the new layout before they can read another sample
+  untilKeyframe = 0;
+  untilLayout = 0;
+  return true;
+}
+
+bool Telemetry::addCommand(const char* name, Command* command) {
+  return addChannel(TelemetryChannelKind::CommandStatus, name, 1, command);
+}
+
+bool Telemetry::addSubsystem(const char* name, Subsystem* subsystem) {
+  return addChannel(TelemetryChannelKind::ActiveCommand, name, 1, subsystem);
+}
+
+bool Telemetry::addValue(const char* name, const double* value, float scale) {
+  return addChannel(TelemetryChannelKind::Value, name, scale, value);
+}
+
+std::int64_t Telemetry::read(const Channel& channel, std::uint32_t updateMicros) {
+  switch (channel.kind) {
+    case TelemetryChannelKind::UpdateTime:
+      return updateMicros;
+    case TelemetryChannelKind::CommandStatus:
+      return static_cast<std::int64_t>(static_cast<const Command*>(channel.source)->status);
+    case TelemetryChannelKind::ActiveCommand: {
+      Subsystem* subsystem = static_cast<Subsystem*>(const_cast<void*>(channel.source));
+      Command* command = EventScheduler::getInstance()->getActiveCommand(subsystem);
+      if (command == NULL) {
+        return 0;
+      }
+      for (size_t i = 1; i < channels.size(); i++) {
+        if (channels[i].kind == TelemetryChannelKind::CommandStatus && channels[i].source == command) {
+          return i;
+        }
+      }
+      return -1;
+    }
+    case TelemetryChannelKind::Value: {
+      // Kept well inside the range of an int64_t, so the difference between two values always fits
+      double scaled = *static_cast<const double*>(channel.source) * channel.scale;
+      if (std::isnan(scaled)) {
+        return 0;
+      }
+      return std::llround(std::max(-4e18, std::min(4e18, scaled)));
+    }
+  }
+  return 0;
+}
+
+size_t Telemetry::encodeLayout() {
+  frame[0] = TelemetryLayout;
+  frame[1] = TelemetryVersion;
+  size_t length = 2 + varintEncode(channels.size(), frame + 2);
+  for (const Channel& channel : channels) {
+    frame[length++] = static_cast<std::uint8_t>(channel.kind);
+    std::memcpy(frame + length, &channel.scale, sizeof(float));
+    length += sizeof(float);
+    size_t nameLength = std::strlen(channel.name);
+    frame[length++] = std::uint8_t(nameLength);
+    std::memcpy(frame + length, channel.name, nameLength);
+    length += nameLength;
+  }
+  return length;
+}
+
+bool Telemetry::enqueue(size_t length) {
+  std::uint16_t checksum = telemetryChecksum(frame, length);
+  frame[length++] = std::uint8_t(checksum);
+  frame[length++] = std::uint8_t(checksum >> 8);
+  size_t size = cobsEncode(frame, length, encoded);
+  encoded[size++] = 0;
+
+  // Only this task adds to the buffer, so the room can only grow while the frame is copied in
+  size_t start = head.load(std::memory_order_relaxed);
+  if (LIBITERATIVEROBOT_TELEMETRY_BUFFER - (start - tail.load(std::memory_order_acquire)) < size) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  size_t offset = start % LIBITERATIVEROBOT_TELEMETRY_BUFFER;
+  size_t first = std::min(size, LIBITERATIVEROBOT_TELEMETRY_BUFFER - offset);
+  std::memcpy(buffer + offset, encoded, first);
+  std::memcpy(buffer, encoded + first, size - first);
+  head.store(start + size, std::memory_order_release);
+  return true;
+}
+
+void Telemetry::beginUpdate() {
+  updateStart = micros();
+}
+
+void Telemetry::sample() {
+  std::uint64_t elapsed = micros() - updateStart;
+  std::uint32_t updateMicros = std::uint32_t(std::min<std::uint64_t>(elapsed, UINT32_MAX));
+  std::uint32_t update = samples++;
+  bool keyframe = untilKeyframe == 0;
+  if (keyframe && untilLayout == 0) {
+    if (!enqueue(encodeLayout())) {
+      return; // Tried again on the next update
+    }
+    untilLayout = LIBITERATIVEROBOT_TELEMETRY_LAYOUT;
+  }
+
+  frame[0] = keyframe ? TelemetryKeyframe : TelemetrySample;
+  size_t length = 1 + varintEncode(update, frame + 1);
+  std::uint8_t* changed = frame + length;
+  size_t maskLength = (channels.size() + 7) / 8;
+  std::memset(changed, 0, maskLength);
+  length += maskLength;
+  for (size_t i = 0; i < channels.size(); i++) {
+    Channel& channel = channels[i];
+    std::int64_t value = read(channel, updateMicros);
+    std::int64_t change = keyframe ? value : value - channel.last;
+    channel.last = value;
+    if (change != 0) {
+      changed[i / 8] |= std::uint8_t(1 << (i % 8));
+      length += varintEncode(zigzagEncode(change), frame + length);
+    }
+  }
+
+  if (!enqueue(length)) {
+    untilKeyframe = 0; // Readers wait for a keyframe after the gap
+  } else if (keyframe) {
+    untilKeyframe = LIBITERATIVEROBOT_TELEMETRY_KEYFRAME - 1;
+    untilLayout--;
+  } else {
+    untilKeyframe--;
+  }
+}
+
+void Telemetry::runTask(void* parameter) {
+  Telemetry* telemetry = static_cast<Telemetry*>(parameter);
+  std::uint32_t wakeTime = pros::c::millis();
+  while (true) {
+    telemetry->flush();
+    pros::c::task_delay_until(&wakeTime, LIBITERATIVEROBOT_TELEMETRY_WRITE_RATE);
+  }
+}
+
+size_t Telemetry::flush() {
+  size_t start = tail.load(std::memory_order_relaxed);
+  size_t end = head.load(std::memory_order_acquire);
+  size_t position = start;
+  while (position != end) {
+    size_t offset = position % LIBITERATIVEROBOT_TELEMETRY_BUFFER;
+    size_t chunk = std::min(end - position, LIBITERATIVEROBOT_TELEMETRY_BUFFER - offset);
+    std::fwrite(buffer + offset, 1, chunk, output);
+    position += chunk;
+    tail.store(position, std::memory_order_release); // Frees the room for the EventScheduler's task straight away
+  }
+  if (position != start) {
+    std::fflush(output);
+    written.fetch_add(std::uint32_t(position - start), std::memory_order_relaxed);
+  }
+  return position - start;
+}
+
+void Telemetry::setOutput(FILE* file) {
+  output = file;
+}
+
+void Telemetry::setPriority(std::uint32_t priority) {
+  this->priority = priority;
+}
+
+void Telemetry::start() {
+  if (task != NULL) {
+    return;
+  }
+  if (output == stdout) {
+    pros::c::serctl(SERCTL_DISABLE_COBS, NULL);
+  }
+  task = pros::c::task_create(runTask, this, priority, TASK_STACK_DEPTH_DEFAULT, "libIterativeRobot Telemetry");
+}
+
+std::uint32_t Telemetry::getSamples() {
+  return samples;
+}
+
+std::uint32_t Telemetry::getDroppedFrames() {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+std::uint32_t Telemetry::getBytesWritten() {
+  return written.load(std::memory_order_relaxed);
+}
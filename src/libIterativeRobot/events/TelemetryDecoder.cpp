@@ -0,0 +1,193 @@
+#include "libIterativeRobot/events/TelemetryDecoder.h"
+#include "libIterativeRobot/commands/Status.h"
+#include <cstring>
+
+using namespace libIterativeRobot;
+
+void TelemetryDecoder::feed(const std::uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (data[i] != 0) {
+      pending.push_back(data[i]);
+    } else if (!pending.empty()) {
+      readFrame();
+      pending.clear();
+    }
+  }
+}
+
+void TelemetryDecoder::readFrame() {
+  frames++;
+  decoded.resize(pending.size());
+  size_t length = cobsDecode(pending.data(), pending.size(), decoded.data());
+  bool valid = length >= 3;
+  if (valid) {
+    length -= 2;
+    std::uint16_t checksum = std::uint16_t(decoded[length] | decoded[length + 1] << 8);
+    valid = checksum == telemetryChecksum(decoded.data(), length);
+  }
+  if (valid) {
+    const std::uint8_t* body = decoded.data() + 1;
+    switch (decoded[0]) {
+      case TelemetryLayout:
+        valid = readLayout(body, length - 1);
+        break;
+      case TelemetryKeyframe:
+      case TelemetrySample:
+        valid = readSample(body, length - 1, decoded[0] == TelemetryKeyframe);
+        break;
+      default:
+        valid = false;
+    }
+  }
+  if (!valid) {
+    badFrames++;
+    synced = false; // Whatever the frame was, the next Sample cannot be trusted to follow on from the last
+  }
+}
+
+bool TelemetryDecoder::readLayout(const std::uint8_t* body, size_t length) {
+  std::uint64_t count;
+  size_t position = 1;
+  size_t read;
+  if (length < 1 || body[0] != TelemetryVersion || (read = varintDecode(body + 1, length - 1, count)) == 0) {
+    return false;
+  }
+  position += read;
+  std::vector<TelemetryChannelInfo> layout;
+  for (std::uint64_t i = 0; i < count; i++) {
+    if (position + 6 > length) {
+      return false;
+    }
+    TelemetryChannelInfo channel;
+    channel.kind = static_cast<TelemetryChannelKind>(body[position]);
+    std::memcpy(&channel.scale, body + position + 1, sizeof(float));
+    size_t nameLength = body[position + 5];
+    position += 6;
+    if (position + nameLength > length) {
+      return false;
+    }
+    channel.name.assign(reinterpret_cast<const char*>(body + position), nameLength);
+    position += nameLength;
+    layout.push_back(channel);
+  }
+
+  bool same = layout.size() == channels.size();
+  for (size_t i = 0; same && i < layout.size(); i++) {
+    same = layout[i].kind == channels[i].kind && layout[i].scale == channels[i].scale &&
+           layout[i].name == channels[i].name;
+  }
+  if (!same) {
+    channels = layout;
+    values.assign(channels.size(), 0);
+    synced = false;
+    this->layout(channels);
+  }
+  return true;
+}
+
+bool TelemetryDecoder::readSample(const std::uint8_t* body, size_t length, bool keyframe) {
+  std::uint64_t update;
+  size_t position = varintDecode(body, length, update);
+  size_t maskLength = (channels.size() + 7) / 8;
+  if (position == 0 || position + maskLength > length) {
+    return false;
+  }
+  if (channels.empty() || (!keyframe && (!synced || std::uint32_t(update) != lastUpdate + 1))) {
+    synced = false;
+    skippedSamples++;
+    return true;
+  }
+  const std::uint8_t* changed = body + position;
+  position += maskLength;
+  for (size_t i = 0; i < channels.size(); i++) {
+    std::int64_t change = 0;
+    if (changed[i / 8] & (1 << (i % 8))) {
+      std::uint64_t encoded;
+      size_t read = varintDecode(body + position, length - position, encoded);
+      if (read == 0) {
+        return false;
+      }
+      position += read;
+      change = zigzagDecode(encoded);
+    }
+    values[i] = keyframe ? change : values[i] + change;
+  }
+  if (position != length) {
+    return false;
+  }
+  synced = true;
+  lastUpdate = std::uint32_t(update);
+  row(lastUpdate, values);
+  return true;
+}
+
+void TelemetryDecoder::layout(const std::vector<TelemetryChannelInfo>& channels) {
+  (void)channels;
+}
+
+void TelemetryDecoder::row(std::uint32_t update, const std::vector<std::int64_t>& values) {
+  (void)update;
+  (void)values;
+}
+
+const std::vector<TelemetryChannelInfo>& TelemetryDecoder::getChannels() const {
+  return channels;
+}
+
+std::string TelemetryDecoder::format(size_t channel, std::int64_t value) const {
+  static const char* const statuses[] = {"Idle", "Blocked", "Running", "Finished", "Interrupted"};
+  char text[32];
+  switch (channels[channel].kind) {
+    case TelemetryChannelKind::CommandStatus:
+      if (value >= 0 && value <= static_cast<std::int64_t>(Status::Interrupted)) {
+        return statuses[value];
+      }
+      break;
+    case TelemetryChannelKind::ActiveCommand:
+      if (value == 0) {
+        return "";
+      }
+      if (value > 0 && size_t(value) < channels.size()) {
+        return channels[value].name;
+      }
+      return "?";
+    case TelemetryChannelKind::Value:
+      std::snprintf(text, sizeof(text), "%.6g", value / double(channels[channel].scale));
+      return text;
+    default:
+      break;
+  }
+  std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+  return text;
+}
+
+std::uint32_t TelemetryDecoder::getFrames() const {
+  return frames;
+}
+
+std::uint32_t TelemetryDecoder::getBadFrames() const {
+  return badFrames;
+}
+
+std::uint32_t TelemetryDecoder::getSkippedSamples() const {
+  return skippedSamples;
+}
+
+TelemetryCsv::TelemetryCsv(FILE* output) : output(output) {
+}
+
+void TelemetryCsv::layout(const std::vector<TelemetryChannelInfo>& channels) {
+  std::fprintf(output, "update");
+  for (const TelemetryChannelInfo& channel : channels) {
+    std::fprintf(output, ",%s", channel.name.c_str());
+  }
+  std::fprintf(output, "\n");
+}
+
+void TelemetryCsv::row(std::uint32_t update, const std::vector<std::int64_t>& values) {
+  std::fprintf(output, "%u", update);
+  for (size_t i = 0; i < values.size(); i++) {
+    std::fprintf(output, ",%s", format(i, values[i]).c_str());
+  }
+  std::fprintf(output, "\n");
+}
@@ -0,0 +1,168 @@
+#include "libIterativeRobot/events/Tracer.h"
+
+#ifdef LIBITERATIVEROBOT_TRACE
+
+#include "libIterativeRobot/Clock.h"
+#include "libIterativeRobot/commands/Command.h"
+#include "libIterativeRobot/events/EventListener.h"
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <typeinfo>
+
+static_assert((LIBITERATIVEROBOT_TRACE_CAPACITY & (LIBITERATIVEROBOT_TRACE_CAPACITY - 1)) == 0,
+              "LIBITERATIVEROBOT_TRACE_CAPACITY must be a power of two");
+
+using namespace libIterativeRobot;
+
+static_assert(LIBITERATIVEROBOT_TRACE_OBJECTS < TraceOverflowObject,
+              "LIBITERATIVEROBOT_TRACE_OBJECTS must leave room for TraceOverflowObject");
+
+Tracer* Tracer::instance = 0;
+
+Tracer::Tracer() : head(0), enabled(true), objectCount(0) {
+}
+
+Tracer* Tracer::getInstance() {
+  if (instance == NULL) {
+    instance = new Tracer();
+  }
+  return instance;
+}
+
+std::uint16_t Tracer::name(const void* object, const std::type_info& type) {
+  std::uint16_t index = objectCount.fetch_add(1, std::memory_order_relaxed);
+  if (index >= LIBITERATIVEROBOT_TRACE_OBJECTS) {
+    // One past the end, so dump() knows to name TraceOverflowObject
+    objectCount.store(LIBITERATIVEROBOT_TRACE_OBJECTS + 1, std::memory_order_relaxed);
+    return TraceOverflowObject;
+  }
+  objects[index] = object;
+  types[index] = &type;
+  return index + 1;
+}
+
+std::uint16_t Tracer::of(Command* command) {
+  if (command->traceId == 0) {
+    command->traceId = name(command, typeid(*command));
+  }
+  return command->traceId;
+}
+
+std::uint16_t Tracer::of(EventListener* listener) {
+  if (listener->traceId == 0) {
+    listener->traceId = name(listener, typeid(*listener));
+  }
+  return listener->traceId;
+}
+
+void Tracer::record(TraceEventType type, Command* command, std::uint16_t detail) {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::uint32_t index = head.fetch_add(1, std::memory_order_relaxed);
+  events[index % LIBITERATIVEROBOT_TRACE_CAPACITY] = {std::uint32_t(micros()), of(command), detail, std::uint8_t(type), {}};
+}
+
+void Tracer::record(TraceEventType type, EventListener* listener, std::uint16_t detail) {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::uint32_t index = head.fetch_add(1, std::memory_order_relaxed);
+  events[index % LIBITERATIVEROBOT_TRACE_CAPACITY] = {std::uint32_t(micros()), of(listener), detail, std::uint8_t(type), {}};
+}
+
+void Tracer::record(TraceEventType type) {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::uint32_t index = head.fetch_add(1, std::memory_order_relaxed);
+  events[index % LIBITERATIVEROBOT_TRACE_CAPACITY] = {std::uint32_t(micros()), 0, 0, std::uint8_t(type), {}};
+}
+
+void Tracer::setEnabled(bool enabled) {
+  this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+  head.store(0, std::memory_order_relaxed);
+}
+
+std::uint32_t Tracer::getEventCount() {
+  std::uint32_t recorded = head.load(std::memory_order_relaxed);
+  return recorded < LIBITERATIVEROBOT_TRACE_CAPACITY ? recorded : LIBITERATIVEROBOT_TRACE_CAPACITY;
+}
+
+std::uint32_t Tracer::getDropped() {
+  return head.load(std::memory_order_relaxed) - getEventCount();
+}
+
+TraceEvent Tracer::getEvent(std::uint32_t index) {
+  std::uint32_t oldest = head.load(std::memory_order_relaxed) - getEventCount();
+  return events[(oldest + index) % LIBITERATIVEROBOT_TRACE_CAPACITY];
+}
+
+namespace {
+  // Writes a name of length characters
+  bool writeName(FILE* file, std::uint16_t id, const char* name, int length) {
+    if (length < 0) {
+      return false;
+    }
+    TraceName header = {id, std::uint16_t(length)};
+    return std::fwrite(&header, sizeof(header), 1, file) == 1 && std::fwrite(name, 1, length, file) == size_t(length);
+  }
+
+  // Writes the demangled name of an object's type and its address, falling back to the mangled name
+  bool writeName(FILE* file, std::uint16_t id, const void* object, const std::type_info& type) {
+    const char* mangled = type.name();
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, NULL, NULL, &status);
+    char name[128];
+    int length = std::snprintf(name, sizeof(name), "%s %p", status == 0 ? demangled : mangled, object);
+    std::free(demangled);
+    if (length >= int(sizeof(name))) {
+      length = sizeof(name) - 1;
+    }
+    return writeName(file, id, name, length);
+  }
+}
+
+bool Tracer::dump(FILE* file) {
+  std::uint16_t names = objectCount.load(std::memory_order_relaxed);
+  bool overflowed = names > LIBITERATIVEROBOT_TRACE_OBJECTS;
+  if (overflowed) {
+    names = LIBITERATIVEROBOT_TRACE_OBJECTS;
+  }
+
+  TraceFileHeader header;
+  std::memcpy(header.magic, TraceMagic, sizeof(header.magic));
+  header.version = TraceVersion;
+  header.nameCount = names + (overflowed ? 1 : 0);
+  header.eventCount = getEventCount();
+  header.dropped = getDropped();
+  if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+    return false;
+  }
+
+  for (std::uint16_t i = 0; i < names; i++) {
+    if (!writeName(file, i + 1, objects[i], *types[i])) {
+      return false;
+    }
+  }
+  if (overflowed) {
+    const char overflow[] = "unnamed objects";
+    if (!writeName(file, TraceOverflowObject, overflow, int(sizeof(overflow)) - 1)) {
+      return false;
+    }
+  }
+
+  for (std::uint32_t i = 0; i < header.eventCount; i++) {
+    TraceEvent event = getEvent(i);
+    if (std::fwrite(&event, sizeof(event), 1, file) != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif // LIBITERATIVEROBOT_TRACE
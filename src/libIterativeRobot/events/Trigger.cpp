@@ -10,9 +10,15 @@ void Trigger::checkConditions() {
   // Keeps track of the button's current state
   bool currentState = getState();
 
+  // Edge bindings only do something when the state changes, so a Trigger without level bindings has nothing to do
+  if (currentState == lastState && !(bindings & LevelBinding)) {
+    return;
+  }
+
   // Decides which command or command group to run based on the last state and current state of the button. There are four possiblities
   if (currentState) {
     if (lastState) { // Possibility 1: current state is true and last state is true
+      LIBITERATIVEROBOT_TRACE_EVENT(ListenerFired, this, TraceWhileActive);
       for (Command* command : runWhileActiveCommands) { // Commands in runWhileActiveCommands are run
         command->run();
       }
@@ -20,6 +26,7 @@ void Trigger::checkConditions() {
         command->stop();
       }
     } else { // Possibility 2: current state is true and last state is false
+      LIBITERATIVEROBOT_TRACE_EVENT(ListenerFired, this, TraceWhenActivated);
       for (Command* command : runWhenActivatedCommands) { // Commands in runWhenActivatedCommands are run
         command->run();
       }
@@ -29,6 +36,7 @@ void Trigger::checkConditions() {
     }
   } else {
     if (lastState) { // Possibility 3: current state is false and last state is true
+      LIBITERATIVEROBOT_TRACE_EVENT(ListenerFired, this, TraceWhenDeactivated);
       for (Command* command : runWhenDeactivatedCommands) { // Commands in runWhenDeactivatedCommands are run
         command->run();
       }
@@ -36,6 +44,7 @@ void Trigger::checkConditions() {
         command->stop();
       }
     } else { // Possibility 4: current state is false and last state is false
+      LIBITERATIVEROBOT_TRACE_EVENT(ListenerFired, this, TraceWhileInactive);
       for (Command* command : runWhileInactiveCommands) { // Commands in runWhileInactiveCommands are run
         command->run();
       }
@@ -49,7 +58,18 @@ void Trigger::checkConditions() {
   lastState = currentState;
 }
 
+void Trigger::addBinding(BindingKind binding) {
+  bindings |= binding;
+  setAlwaysChecked(!notifiedOnChange || (bindings & LevelBinding));
+}
+
+void Trigger::setNotifiedOnChange(bool notifiedOnChange) {
+  this->notifiedOnChange = notifiedOnChange;
+  setAlwaysChecked(!notifiedOnChange || (bindings & LevelBinding));
+}
+
 void Trigger::whenActivated(Command* command, Action action) {
+  addBinding(EdgeBinding);
   if (action == Action::RUN) {
     runWhenActivatedCommands.push_back(command);
   } else if (action == Action::STOP) {
@@ -58,6 +78,7 @@ void Trigger::whenActivated(Command* command, Action action) {
 }
 
 void Trigger::whileActive(Command* command, Action action) {
+  addBinding(LevelBinding);
   if (action == Action::RUN) {
     runWhileActiveCommands.push_back(command);
   } else if (action == Action::STOP) {
@@ -66,6 +87,7 @@ void Trigger::whileActive(Command* command, Action action) {
 }
 
 void Trigger::whenDeactivated(Command* command, Action action) {
+  addBinding(EdgeBinding);
   if (action == Action::RUN) {
     runWhenDeactivatedCommands.push_back(command);
   } else if (action == Action::STOP) {
@@ -74,6 +96,7 @@ void Trigger::whenDeactivated(Command* command, Action action) {
 }
 
 void Trigger::whileInactive(Command* command, Action action) {
+  addBinding(LevelBinding);
   if (action == Action::RUN) {
     runWhileInactiveCommands.push_back(command);
   } else if (action == Action::STOP) {
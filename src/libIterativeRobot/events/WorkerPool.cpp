@@ -0,0 +1,80 @@
+#include "libIterativeRobot/events/WorkerPool.h"
+#include "libIterativeRobot/commands/AsyncCommand.h"
+#include <new>
+
+using namespace libIterativeRobot;
+
+WorkerPool* WorkerPool::instance = 0;
+
+WorkerPool::WorkerPool() {
+}
+
+WorkerPool* WorkerPool::getInstance() {
+  if (instance == NULL) {
+    // Built in static storage and never destroyed, since its workers keep running until the program exits
+    alignas(WorkerPool) static unsigned char storage[sizeof(WorkerPool)];
+    instance = new (storage) WorkerPool();
+  }
+  return instance;
+}
+
+void WorkerPool::runWorker(void* parameter) {
+  Worker* worker = static_cast<Worker*>(parameter);
+  while (true) {
+    AsyncCommand* job = worker->job.load(std::memory_order_acquire);
+    if (job == NULL) {
+      pros::c::task_notify_take(true, TIMEOUT_MAX);
+      continue;
+    }
+    job->performWork();
+    worker->job.store(NULL, std::memory_order_release);
+  }
+}
+
+bool WorkerPool::dispatch(AsyncCommand* command) {
+  while (workers.size() < workerCount) {
+    if (!hasRoom(workers)) {
+      workerCount = workers.size(); // Counted as an overflow once, rather than on every dispatch
+      break;
+    }
+#ifdef LIBITERATIVEROBOT_STATIC
+    Worker* worker = &workerStorage[workers.size()];
+#else
+    Worker* worker = new Worker();
+#endif
+    worker->job.store(NULL, std::memory_order_relaxed);
+    worker->task = pros::c::task_create(runWorker, worker, priority, TASK_STACK_DEPTH_DEFAULT, "libIterativeRobot Worker");
+    workers.push_back(worker);
+  }
+
+  for (Worker* worker : workers) {
+    if (worker->job.load(std::memory_order_acquire) == NULL) {
+      worker->job.store(command, std::memory_order_release);
+      pros::c::task_notify(worker->task);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkerPool::setWorkerCount(size_t count) {
+  workerCount = count == 0 ? 1 : count;
+}
+
+void WorkerPool::setPriority(std::uint32_t priority) {
+  this->priority = priority;
+}
+
+size_t WorkerPool::getStartedWorkers() {
+  return workers.size();
+}
+
+size_t WorkerPool::getBusyWorkers() {
+  size_t busy = 0;
+  for (Worker* worker : workers) {
+    if (worker->job.load(std::memory_order_relaxed) != NULL) {
+      busy++;
+    }
+  }
+  return busy;
+}
@@ -0,0 +1,61 @@
+#include "libIterativeRobot/paths/Trajectory.h"
+#include <cstring>
+
+using namespace libIterativeRobot;
+
+bool Trajectory::parse(const std::uint8_t* data, size_t size) {
+  samples = NULL;
+  if (data == NULL || size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, TrajectoryMagic, sizeof(header.magic)) != 0 || header.version != TrajectoryVersion ||
+      header.sampleCount == 0 || header.periodMillis == 0 ||
+      (size - sizeof(header)) / sizeof(TrajectoryFileSample) < header.sampleCount) {
+    return false;
+  }
+  samples = data + sizeof(header);
+  return true;
+}
+
+bool Trajectory::isValid() const {
+  return samples != NULL;
+}
+
+size_t Trajectory::getSampleCount() const {
+  return isValid() ? header.sampleCount : 0;
+}
+
+std::uint32_t Trajectory::getPeriod() const {
+  return header.periodMillis;
+}
+
+std::uint32_t Trajectory::getDuration() const {
+  return isValid() ? (header.sampleCount - 1) * header.periodMillis : 0;
+}
+
+double Trajectory::getTrackWidth() const {
+  return header.trackWidth;
+}
+
+TrajectorySample Trajectory::getSample(size_t index) const {
+  TrajectorySample sample;
+  if (!isValid()) {
+    return sample;
+  }
+  if (index >= header.sampleCount) {
+    index = header.sampleCount - 1;
+  }
+  TrajectoryFileSample stored;
+  std::memcpy(&stored, samples + index * sizeof(stored), sizeof(stored));
+  sample.x = stored.x / TrajectoryDistanceScale;
+  sample.y = stored.y / TrajectoryDistanceScale;
+  sample.heading = stored.heading / TrajectoryHeadingScale;
+  sample.leftVelocity = stored.left / TrajectoryVelocityScale;
+  sample.rightVelocity = stored.right / TrajectoryVelocityScale;
+  return sample;
+}
+
+TrajectorySample Trajectory::getSampleAt(std::uint32_t millis) const {
+  return getSample(isValid() ? millis / header.periodMillis : 0);
+}
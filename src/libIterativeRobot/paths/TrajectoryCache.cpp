@@ -0,0 +1,86 @@
+#include "libIterativeRobot/paths/TrajectoryCache.h"
+#include "libIterativeRobot/Clock.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+using namespace libIterativeRobot;
+
+TrajectoryCache* TrajectoryCache::instance = 0;
+
+TrajectoryCache::TrajectoryCache() {
+}
+
+TrajectoryCache* TrajectoryCache::getInstance() {
+  if (instance == NULL) {
+    alignas(TrajectoryCache) static unsigned char storage[sizeof(TrajectoryCache)];
+    instance = new (storage) TrajectoryCache();
+  }
+  return instance;
+}
+
+TrajectoryCache::Entry* TrajectoryCache::find(const char* name) {
+  for (Entry& entry : entries) {
+    if (std::strcmp(entry.name, name) == 0) {
+      return &entry;
+    }
+  }
+  return NULL;
+}
+
+bool TrajectoryCache::add(const char* name, const std::uint8_t* data, size_t size) {
+  Entry entry = {name, NULL, true, Trajectory()};
+  if (find(name) != NULL || !entry.trajectory.parse(data, size) || !hasRoom(entries)) {
+    return false;
+  }
+  entries.push_back(entry);
+  return true;
+}
+
+bool TrajectoryCache::addFile(const char* name, const char* path) {
+  if (find(name) != NULL || !hasRoom(entries)) {
+    return false;
+  }
+  entries.push_back({name, path, false, Trajectory()});
+  return true;
+}
+
+void TrajectoryCache::load(Entry& entry) {
+  entry.loaded = true; // A file that cannot be read is not tried again on every get()
+  std::uint64_t start = micros();
+  FILE* file = std::fopen(entry.path, "rb");
+  if (file == NULL) {
+    return;
+  }
+  long size = std::fseek(file, 0, SEEK_END) == 0 ? std::ftell(file) : -1;
+  std::uint8_t* data = size > 0 ? new (std::nothrow) std::uint8_t[size] : NULL;
+  if (data != NULL) {
+    std::rewind(file);
+    if (std::fread(data, 1, size, file) != size_t(size) || !entry.trajectory.parse(data, size)) {
+      delete[] data;
+    } else {
+      filesLoaded++;
+    }
+  }
+  std::fclose(file);
+  loadMicros += micros() - start;
+}
+
+const Trajectory* TrajectoryCache::get(const char* name) {
+  Entry* entry = find(name);
+  if (entry == NULL) {
+    return NULL;
+  }
+  if (!entry->loaded) {
+    load(*entry);
+  }
+  return entry->trajectory.isValid() ? &entry->trajectory : NULL;
+}
+
+std::uint32_t TrajectoryCache::getFilesLoaded() {
+  return filesLoaded;
+}
+
+std::uint64_t TrajectoryCache::getLoadMicros() {
+  return loadMicros;
+}
@@ -0,0 +1,141 @@
+#include "libIterativeRobot/paths/TrajectoryGenerator.h"
+#include "libIterativeRobot/paths/TrajectoryFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace libIterativeRobot;
+
+namespace {
+  // The number of points each spline is divided into while working out the speed along it
+  const int pointsPerSpline = 1000;
+
+  // A point along the path, and the speed the robot passes it at
+  struct PathPoint {
+    double x, y, heading, curvature;
+    double distance; // From the start of the path
+    double velocity;
+    double time; // From the start of the path, in seconds
+  };
+
+  // Stores a value as a 16-bit fixed point number, failing if it does not fit
+  bool fixed(double value, double scale, std::int16_t& stored) {
+    double scaled = std::round(value * scale);
+    if (scaled < INT16_MIN || scaled > INT16_MAX) {
+      return false;
+    }
+    stored = std::int16_t(scaled);
+    return true;
+  }
+
+  double wrap(double angle) {
+    return std::atan2(std::sin(angle), std::cos(angle));
+  }
+}
+
+bool TrajectoryGenerator::generate(const Waypoint* waypoints, size_t count, const TrajectoryConstraints& constraints,
+                                   std::vector<std::uint8_t>& trajectory) {
+  if (count < 2 || constraints.maxVelocity <= 0 || constraints.maxAcceleration <= 0 || constraints.trackWidth <= 0 ||
+      constraints.periodMillis == 0) {
+    return false;
+  }
+
+  // Divides each spline into short steps, noting the heading and curvature at each
+  std::vector<PathPoint> points;
+  points.reserve((count - 1) * pointsPerSpline + 1);
+  for (size_t i = 0; i + 1 < count; i++) {
+    const Waypoint& from = waypoints[i];
+    const Waypoint& to = waypoints[i + 1];
+    // Tangents a little longer than the distance between the points give gentle curves
+    double scale = 1.2 * std::hypot(to.x - from.x, to.y - from.y);
+    double fromDx = scale * std::cos(from.heading), fromDy = scale * std::sin(from.heading);
+    double toDx = scale * std::cos(to.heading), toDy = scale * std::sin(to.heading);
+    for (int step = i == 0 ? 0 : 1; step <= pointsPerSpline; step++) {
+      double t = double(step) / pointsPerSpline;
+      double t2 = t * t, t3 = t2 * t;
+      // The Hermite basis functions and their first and second derivatives
+      double h00 = 2 * t3 - 3 * t2 + 1, h10 = t3 - 2 * t2 + t, h01 = -2 * t3 + 3 * t2, h11 = t3 - t2;
+      double d00 = 6 * t2 - 6 * t, d10 = 3 * t2 - 4 * t + 1, d01 = -6 * t2 + 6 * t, d11 = 3 * t2 - 2 * t;
+      double s00 = 12 * t - 6, s10 = 6 * t - 4, s01 = -12 * t + 6, s11 = 6 * t - 2;
+      PathPoint point;
+      point.x = h00 * from.x + h10 * fromDx + h01 * to.x + h11 * toDx;
+      point.y = h00 * from.y + h10 * fromDy + h01 * to.y + h11 * toDy;
+      double dx = d00 * from.x + d10 * fromDx + d01 * to.x + d11 * toDx;
+      double dy = d00 * from.y + d10 * fromDy + d01 * to.y + d11 * toDy;
+      double ddx = s00 * from.x + s10 * fromDx + s01 * to.x + s11 * toDx;
+      double ddy = s00 * from.y + s10 * fromDy + s01 * to.y + s11 * toDy;
+      double speed = std::hypot(dx, dy);
+      point.heading = speed > 0 ? std::atan2(dy, dx) : from.heading;
+      point.curvature = speed > 0 ? (dx * ddy - dy * ddx) / (speed * speed * speed) : 0;
+      point.distance = points.empty() ? 0 : points.back().distance + std::hypot(point.x - points.back().x,
+                                                                               point.y - points.back().y);
+      points.push_back(point);
+    }
+  }
+
+  // The fastest the robot can pass each point, starting and ending at rest
+  double halfTrack = constraints.trackWidth / 2;
+  for (PathPoint& point : points) {
+    point.velocity = constraints.maxVelocity / (1 + std::fabs(point.curvature) * halfTrack);
+  }
+  points.front().velocity = 0;
+  points.back().velocity = 0;
+  for (size_t i = 1; i < points.size(); i++) {
+    double step = points[i].distance - points[i - 1].distance;
+    points[i].velocity = std::min(points[i].velocity, std::sqrt(points[i - 1].velocity * points[i - 1].velocity +
+                                                                2 * constraints.maxAcceleration * step));
+  }
+  for (size_t i = points.size() - 1; i > 0; i--) {
+    double step = points[i].distance - points[i - 1].distance;
+    points[i - 1].velocity = std::min(points[i - 1].velocity, std::sqrt(points[i].velocity * points[i].velocity +
+                                                                        2 * constraints.maxAcceleration * step));
+  }
+  points.front().time = 0;
+  for (size_t i = 1; i < points.size(); i++) {
+    double step = points[i].distance - points[i - 1].distance;
+    double speed = points[i].velocity + points[i - 1].velocity;
+    points[i].time = points[i - 1].time + (speed > 0 ? 2 * step / speed : 0);
+  }
+
+  // Samples the path every period, interpolating between the points on either side
+  double period = constraints.periodMillis / 1000.0;
+  std::uint32_t sampleCount = std::uint32_t(std::ceil(points.back().time / period)) + 1;
+  TrajectoryFileHeader header;
+  std::memcpy(header.magic, TrajectoryMagic, sizeof(header.magic));
+  header.version = TrajectoryVersion;
+  header.periodMillis = constraints.periodMillis;
+  header.sampleCount = sampleCount;
+  header.trackWidth = float(constraints.trackWidth);
+  trajectory.resize(sizeof(header) + sampleCount * sizeof(TrajectoryFileSample));
+  std::memcpy(trajectory.data(), &header, sizeof(header));
+
+  size_t next = 1;
+  for (std::uint32_t i = 0; i < sampleCount; i++) {
+    double time = std::min(i * period, points.back().time);
+    while (next < points.size() - 1 && points[next].time < time) {
+      next++;
+    }
+    const PathPoint& before = points[next - 1];
+    const PathPoint& after = points[next];
+    double span = after.time - before.time;
+    double along = span > 0 ? (time - before.time) / span : 1;
+    double velocity = before.velocity + (after.velocity - before.velocity) * along;
+    double curvature = before.curvature + (after.curvature - before.curvature) * along;
+    if (i == sampleCount - 1) {
+      velocity = 0;
+    }
+    TrajectoryFileSample sample;
+    bool fits = fixed(before.x + (after.x - before.x) * along, TrajectoryDistanceScale, sample.x) &&
+                fixed(before.y + (after.y - before.y) * along, TrajectoryDistanceScale, sample.y) &&
+                fixed(wrap(before.heading + wrap(after.heading - before.heading) * along), TrajectoryHeadingScale,
+                      sample.heading) &&
+                fixed(velocity * (1 - curvature * halfTrack), TrajectoryVelocityScale, sample.left) &&
+                fixed(velocity * (1 + curvature * halfTrack), TrajectoryVelocityScale, sample.right);
+    if (!fits) {
+      trajectory.clear();
+      return false;
+    }
+    std::memcpy(trajectory.data() + sizeof(header) + i * sizeof(sample), &sample, sizeof(sample));
+  }
+  return true;
+}
@@ -0,0 +1,18 @@
+#include "libIterativeRobot/subsystems/CoalescedADIOutput.h"
+
+using namespace libIterativeRobot;
+
+CoalescedADIOutput::CoalescedADIOutput(Subsystem* subsystem, std::uint8_t port) : CoalescedOutput(subsystem), port(port) {
+}
+
+void CoalescedADIOutput::send(std::int32_t value, std::uint8_t) {
+  pros::c::adi_port_set_value(port, value);
+}
+
+void CoalescedADIOutput::setValue(std::int32_t value) {
+  set(value);
+}
+
+std::uint8_t CoalescedADIOutput::getPort() {
+  return port;
+}
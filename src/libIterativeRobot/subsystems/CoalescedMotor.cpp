@@ -0,0 +1,36 @@
+#include "libIterativeRobot/subsystems/CoalescedMotor.h"
+
+using namespace libIterativeRobot;
+
+CoalescedMotor::CoalescedMotor(Subsystem* subsystem, std::uint8_t port) : CoalescedOutput(subsystem), port(port) {
+}
+
+void CoalescedMotor::send(std::int32_t value, std::uint8_t mode) {
+  switch (mode) {
+    case Move:
+      pros::c::motor_move(port, value);
+      break;
+    case Velocity:
+      pros::c::motor_move_velocity(port, value);
+      break;
+    case Voltage:
+      pros::c::motor_move_voltage(port, value);
+      break;
+  }
+}
+
+void CoalescedMotor::move(std::int32_t voltage) {
+  set(voltage, Move);
+}
+
+void CoalescedMotor::moveVelocity(std::int32_t velocity) {
+  set(velocity, Velocity);
+}
+
+void CoalescedMotor::moveVoltage(std::int32_t voltage) {
+  set(voltage, Voltage);
+}
+
+std::uint8_t CoalescedMotor::getPort() {
+  return port;
+}
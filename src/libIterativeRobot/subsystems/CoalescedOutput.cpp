@@ -0,0 +1,88 @@
+#include "libIterativeRobot/subsystems/CoalescedOutput.h"
+#include "libIterativeRobot/subsystems/Subsystem.h"
+#include <cstdlib>
+
+using namespace libIterativeRobot;
+
+std::uint32_t CoalescedOutput::totalWrites = 0;
+std::uint32_t CoalescedOutput::totalSkipped = 0;
+
+CoalescedOutput::CoalescedOutput(Subsystem* subsystem) : subsystem(subsystem) {
+  // Outputs are appended so that they are flushed in the order they were created
+  CoalescedOutput** link = &subsystem->outputs;
+  while (*link != NULL) {
+    link = &(*link)->next;
+  }
+  *link = this;
+}
+
+CoalescedOutput::~CoalescedOutput() {
+  for (CoalescedOutput** link = &subsystem->outputs; *link != NULL; link = &(*link)->next) {
+    if (*link == this) {
+      *link = next;
+      break;
+    }
+  }
+}
+
+void CoalescedOutput::set(std::int32_t value, std::uint8_t mode) {
+  pending = value;
+  pendingMode = mode;
+  requested = true;
+}
+
+void CoalescedOutput::flush() {
+  if (!requested && !hasSent) {
+    return; // Nothing has been set yet
+  }
+  std::uint32_t now = pros::millis();
+  bool changed = forced || !hasSent || pendingMode != sentMode || std::abs(pending - sent) > epsilon ||
+                 (pending == 0 && sent != 0);
+  bool due = hasSent && refreshInterval != 0 && now - lastSent >= refreshInterval;
+  if (changed || due) {
+    send(pending, pendingMode);
+    sent = pending;
+    sentMode = pendingMode;
+    hasSent = true;
+    lastSent = now;
+    forced = false;
+    writes++;
+    totalWrites++;
+  } else if (requested) {
+    skipped++;
+    totalSkipped++;
+  }
+  requested = false;
+}
+
+void CoalescedOutput::setEpsilon(std::int32_t epsilon) {
+  this->epsilon = epsilon;
+}
+
+void CoalescedOutput::setRefreshInterval(std::uint32_t milliseconds) {
+  refreshInterval = milliseconds;
+}
+
+void CoalescedOutput::refresh() {
+  forced = true;
+}
+
+std::int32_t CoalescedOutput::getValue() {
+  return pending;
+}
+
+std::uint32_t CoalescedOutput::getWrites() {
+  return writes;
+}
+
+std::uint32_t CoalescedOutput::getSkipped() {
+  return skipped;
+}
+
+std::uint32_t CoalescedOutput::getTotalWrites() {
+  return totalWrites;
+}
+
+std::uint32_t CoalescedOutput::getTotalSkipped() {
+  return totalSkipped;
+}
@@ -0,0 +1,88 @@
+#include "libIterativeRobot/subsystems/Odometry.h"
+#include <cmath>
+
+using namespace libIterativeRobot;
+
+Odometry::Odometry(double trackWidth, double middleOffset)
+    : trackWidth(trackWidth), middleOffset(middleOffset), waitingSlot(-1), rate(LIBITERATIVEROBOT_ODOMETRY_RATE),
+      running(false), updates(0) {
+}
+
+void Odometry::runTask(void* parameter) {
+  Odometry* odometry = static_cast<Odometry*>(parameter);
+  std::uint32_t wakeTime = pros::c::millis();
+  while (odometry->running.load(std::memory_order_relaxed)) {
+    odometry->update();
+    pros::c::task_delay_until(&wakeTime, odometry->rate.load(std::memory_order_relaxed));
+  }
+}
+
+void Odometry::update() {
+  OdometryReading reading = read();
+  int slot = waitingSlot.exchange(-1, std::memory_order_acquire);
+  if (slot >= 0) {
+    pose = requested[slot];
+  }
+  if (hasReading) {
+    double left = reading.left - last.left;
+    double right = reading.right - last.right;
+    double turn = (right - left) / trackWidth;
+    double forward = (left + right) / 2;
+    double sideways = reading.middle - last.middle + middleOffset * turn;
+
+    // The wheels moved along an arc, whose chord is a little shorter than the distance they travelled
+    if (turn != 0) {
+      double chord = 2 * std::sin(turn / 2) / turn;
+      forward *= chord;
+      sideways *= chord;
+    }
+    double heading = pose.theta + turn / 2;
+    pose.x += forward * std::cos(heading) - sideways * std::sin(heading);
+    pose.y += forward * std::sin(heading) + sideways * std::cos(heading);
+    pose.theta += turn;
+  }
+  last = reading;
+  hasReading = true;
+  pose.time = pros::c::millis();
+  published.store(pose);
+  updates.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Odometry::start() {
+  if (task != NULL) {
+    return;
+  }
+  running.store(true);
+  task = pros::c::task_create(runTask, this, priority, TASK_STACK_DEPTH_DEFAULT, "libIterativeRobot Odometry");
+}
+
+void Odometry::stop() {
+  running.store(false);
+}
+
+void Odometry::setRate(std::uint32_t milliseconds) {
+  rate = milliseconds == 0 ? 1 : milliseconds;
+}
+
+void Odometry::setPriority(std::uint32_t priority) {
+  this->priority = priority;
+}
+
+Pose Odometry::getPose() {
+  return published.load();
+}
+
+void Odometry::setPose(const Pose& pose) {
+  // The waiting slot is never the one being written, so the task never has to wait for this to finish
+  requested[nextSlot] = pose;
+  waitingSlot.store(nextSlot, std::memory_order_release);
+  nextSlot ^= 1;
+}
+
+std::uint32_t Odometry::getUpdates() {
+  return updates.load(std::memory_order_relaxed);
+}
+
+std::uint32_t Odometry::getRetries() {
+  return published.getRetries();
+}
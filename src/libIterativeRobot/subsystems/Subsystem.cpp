@@ -1,6 +1,7 @@
 #include "libIterativeRobot/subsystems/Subsystem.h"
 #include "libIterativeRobot/events/EventScheduler.h"
 #include "libIterativeRobot/commands/Command.h"
+#include "libIterativeRobot/subsystems/CoalescedOutput.h"
 
 using namespace libIterativeRobot;
 
@@ -13,11 +14,27 @@ Subsystem::Subsystem() {
 
 void Subsystem::setDefaultCommand(Command *aCommand) {
   aCommand->priority = Command::DefaultCommandPriority; // Give the default command the lowest possible priority
-  aCommand->requires(this);
+  aCommand->addRequirement(this);
   this->defaultCommand = aCommand;
   aCommand->run();
 }
 
+void Subsystem::readInputs() {
+}
+
+void Subsystem::writeOutputs() {
+}
+
+void Subsystem::flushOutputs() {
+  for (CoalescedOutput* output = outputs; output != NULL; output = output->next) {
+    output->flush();
+  }
+}
+
 Command* Subsystem::getDefaultCommand() {
   return this->defaultCommand;
 }
+
+size_t Subsystem::getIndex() {
+  return this->index;
+}
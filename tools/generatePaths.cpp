@@ -0,0 +1,136 @@
+/**
+ * Generates trajectories with libIterativeRobot::TrajectoryGenerator ahead of time, so the robot only has to load them.
+ *
+ *   generatePaths <paths file> <output directory> [<source file>]
+ *
+ * The paths file lists each path as a line "path <name> <max velocity> <max acceleration> <track width> [<period ms>]"
+ * followed by a line "waypoint <x> <y> <heading in degrees>" for each point it passes through. Blank lines and lines
+ * starting with # are skipped. Each path is written to <output directory>/<name>.traj, to be copied to the SD card and
+ * added with TrajectoryCache::addFile(). If a source file is given, every path is also written into it as a byte array
+ * named <name>Trajectory with its size in <name>TrajectorySize, to be compiled into the program's flash and added with
+ * TrajectoryCache::add().
+ *
+ * Built by host.mk (make host) into bin/host/tools.
+ */
+#include "libIterativeRobot/paths/TrajectoryGenerator.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace libIterativeRobot;
+
+namespace {
+
+struct Path {
+  std::string name;
+  TrajectoryConstraints constraints;
+  std::vector<Waypoint> waypoints;
+};
+
+bool readPaths(const char* filename, std::vector<Path>& paths) {
+  std::ifstream input(filename);
+  if (!input) {
+    std::fprintf(stderr, "cannot open %s\n", filename);
+    return false;
+  }
+  std::string line;
+  for (int number = 1; std::getline(input, line); number++) {
+    std::istringstream fields(line);
+    std::string keyword;
+    if (!(fields >> keyword) || keyword[0] == '#') {
+      continue;
+    }
+    if (keyword == "path") {
+      Path path;
+      int period = 10;
+      if (!(fields >> path.name >> path.constraints.maxVelocity >> path.constraints.maxAcceleration >>
+            path.constraints.trackWidth)) {
+        std::fprintf(stderr, "%s:%d: expected path <name> <max velocity> <max acceleration> <track width>\n", filename,
+                     number);
+        return false;
+      }
+      fields >> period;
+      path.constraints.periodMillis = std::uint16_t(period);
+      paths.push_back(path);
+    } else if (keyword == "waypoint") {
+      Waypoint waypoint;
+      if (paths.empty() || !(fields >> waypoint.x >> waypoint.y >> waypoint.heading)) {
+        std::fprintf(stderr, "%s:%d: expected waypoint <x> <y> <heading> after a path\n", filename, number);
+        return false;
+      }
+      waypoint.heading *= M_PI / 180;
+      paths.back().waypoints.push_back(waypoint);
+    } else {
+      std::fprintf(stderr, "%s:%d: unknown keyword %s\n", filename, number, keyword.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool writeFile(const std::string& filename, const std::vector<std::uint8_t>& data) {
+  FILE* file = std::fopen(filename.c_str(), "wb");
+  if (file == NULL) {
+    return false;
+  }
+  bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+  return std::fclose(file) == 0 && written;
+}
+
+void writeArray(FILE* file, const std::string& name, const std::vector<std::uint8_t>& data) {
+  std::fprintf(file, "\nextern const std::uint8_t %sTrajectory[] = {", name.c_str());
+  for (size_t i = 0; i < data.size(); i++) {
+    std::fprintf(file, "%s0x%02x,", i % 16 == 0 ? "\n  " : " ", data[i]);
+  }
+  std::fprintf(file, "\n};\nextern const std::size_t %sTrajectorySize = %zu;\n", name.c_str(), data.size());
+}
+
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3 && argc != 4) {
+    std::fprintf(stderr, "usage: %s <paths file> <output directory> [<source file>]\n", argv[0]);
+    return 1;
+  }
+  std::vector<Path> paths;
+  if (!readPaths(argv[1], paths)) {
+    return 1;
+  }
+
+  FILE* source = NULL;
+  if (argc == 4) {
+    source = std::fopen(argv[3], "w");
+    if (source == NULL) {
+      std::fprintf(stderr, "cannot write %s\n", argv[3]);
+      return 1;
+    }
+    std::fprintf(source, "// Generated by tools/generatePaths from %s\n#include <cstddef>\n#include <cstdint>\n", argv[1]);
+  }
+
+  bool succeeded = true;
+  for (const Path& path : paths) {
+    std::vector<std::uint8_t> data;
+    if (!TrajectoryGenerator::generate(path.waypoints.data(), path.waypoints.size(), path.constraints, data)) {
+      std::fprintf(stderr, "%s: could not generate a trajectory within the limits of the format\n", path.name.c_str());
+      succeeded = false;
+      continue;
+    }
+    std::string filename = std::string(argv[2]) + "/" + path.name + ".traj";
+    if (!writeFile(filename, data)) {
+      std::fprintf(stderr, "cannot write %s\n", filename.c_str());
+      succeeded = false;
+      continue;
+    }
+    if (source != NULL) {
+      writeArray(source, path.name, data);
+    }
+    std::printf("%s: %zu waypoints, %zu bytes\n", path.name.c_str(), path.waypoints.size(), data.size());
+  }
+  if (source != NULL && std::fclose(source) != 0) {
+    succeeded = false;
+  }
+  return succeeded ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+/**
+ * Turns a stream written by libIterativeRobot::Telemetry into a CSV file with a line for each update.
+ *
+ *   telemetryToCsv <stream file> [<csv file>]
+ *
+ * The stream file holds whatever was read from the brain's USB serial port while the robot program ran, for example
+ * with "cat /dev/ttyACM1 > stream.bin", including anything the program printed. The CSV is written to standard output
+ * if no CSV file is given. A summary of the frames read is written to standard error.
+ *
+ * Built by host.mk (make host) into bin/host/tools.
+ */
+#include "libIterativeRobot/events/TelemetryDecoder.h"
+#include <cstdio>
+
+using namespace libIterativeRobot;
+
+int main(int argc, char** argv) {
+  if (argc != 2 && argc != 3) {
+    std::fprintf(stderr, "usage: %s <stream file> [<csv file>]\n", argv[0]);
+    return 1;
+  }
+  FILE* input = std::fopen(argv[1], "rb");
+  if (input == NULL) {
+    std::fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+  FILE* output = argc == 3 ? std::fopen(argv[2], "w") : stdout;
+  if (output == NULL) {
+    std::fprintf(stderr, "cannot write %s\n", argv[2]);
+    std::fclose(input);
+    return 1;
+  }
+
+  TelemetryCsv csv(output);
+  std::uint8_t data[4096];
+  size_t size;
+  while ((size = std::fread(data, 1, sizeof(data), input)) != 0) {
+    csv.feed(data, size);
+  }
+  std::fclose(input);
+  std::fprintf(stderr, "%u frames, %u damaged, %u samples skipped after a gap\n", csv.getFrames(), csv.getBadFrames(),
+               csv.getSkippedSamples());
+  if (csv.getChannels().empty()) {
+    std::fprintf(stderr, "no telemetry layout found in %s\n", argv[1]);
+  }
+  bool closed = output == stdout || std::fclose(output) == 0;
+  return closed && !csv.getChannels().empty() ? 0 : 1;
+}
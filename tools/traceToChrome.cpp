@@ -0,0 +1,223 @@
+/**
+ * Converts a trace written by libIterativeRobot::Tracer::dump() into the JSON trace format read by chrome://tracing and
+ * Perfetto (ui.perfetto.dev).
+ *
+ *   traceToChrome <trace file> <output.json>
+ *
+ * The EventScheduler gets one track, with a span for each update and, nested inside it, a span for each call to a
+ * Command or CommandGroup's execute() method. Every Command, CommandGroup and EventListener also gets a track of its
+ * own, with a span from when it was initialized until it finished, was interrupted or was blocked, and a marker for
+ * each time it was queued, moved on to its next step or fired. Lining up these tracks shows where each update's time
+ * goes and how a higher priority Command interrupting one Command cascades through the CommandGroups around it.
+ *
+ * Built by host.mk (make host) into bin/host/tools.
+ */
+#include "libIterativeRobot/events/TraceFormat.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace libIterativeRobot;
+
+namespace {
+
+const int schedulerTrack = 1;
+const int firstObjectTrack = 100;
+
+std::string escape(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    if (c >= 0 && c < 0x20) {
+      continue;
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+const char* describeTrigger(std::uint16_t detail) {
+  switch (detail) {
+    case TraceWhileActive: return "while active";
+    case TraceWhenActivated: return "when activated";
+    case TraceWhenDeactivated: return "when deactivated";
+    case TraceWhileInactive: return "while inactive";
+  }
+  return "unknown";
+}
+
+class Writer {
+  private:
+    FILE* file;
+    bool first = true;
+  public:
+    Writer(FILE* file) : file(file) {}
+
+    void begin(std::uint64_t dropped) {
+      std::fprintf(file, "{\"otherData\":{\"dropped\":%llu},\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n",
+                   (unsigned long long)dropped);
+    }
+
+    void end() {
+      std::fprintf(file, "\n]}\n");
+    }
+
+    // Writes one event, with fields being the rest of the JSON object after the common ones
+    void event(const char* phase, int track, std::uint64_t micros, const std::string& name, const std::string& fields) {
+      std::fprintf(file, "%s{\"ph\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"name\":\"%s\"%s%s}", first ? "" : ",\n",
+                   phase, track, (unsigned long long)micros, escape(name).c_str(), fields.empty() ? "" : ",",
+                   fields.c_str());
+      first = false;
+    }
+
+    void trackName(int track, const std::string& name, int sortIndex) {
+      event("M", track, 0, "thread_name", "\"args\":{\"name\":\"" + escape(name) + "\"}");
+      event("M", track, 0, "thread_sort_index", "\"args\":{\"sort_index\":" + std::to_string(sortIndex) + "}");
+    }
+};
+
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s <trace file> <output.json>\n", argv[0]);
+    return 2;
+  }
+
+  FILE* in = std::fopen(argv[1], "rb");
+  if (in == NULL) {
+    std::fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+
+  TraceFileHeader header;
+  if (std::fread(&header, sizeof(header), 1, in) != 1 || std::memcmp(header.magic, TraceMagic, sizeof(TraceMagic)) != 0) {
+    std::fprintf(stderr, "%s is not a libIterativeRobot trace\n", argv[1]);
+    return 1;
+  }
+  if (header.version != TraceVersion) {
+    std::fprintf(stderr, "%s is version %u of the trace format, but only version %u is supported\n", argv[1],
+                 header.version, TraceVersion);
+    return 1;
+  }
+
+  std::map<std::uint16_t, std::string> names;
+  for (std::uint16_t i = 0; i < header.nameCount; i++) {
+    TraceName name;
+    if (std::fread(&name, sizeof(name), 1, in) != 1) {
+      std::fprintf(stderr, "%s ends in the middle of its names\n", argv[1]);
+      return 1;
+    }
+    std::string text(name.length, '\0');
+    if (name.length != 0 && std::fread(&text[0], 1, name.length, in) != name.length) {
+      std::fprintf(stderr, "%s ends in the middle of its names\n", argv[1]);
+      return 1;
+    }
+    names[name.object] = text;
+  }
+
+  std::vector<TraceEvent> events(header.eventCount);
+  if (header.eventCount != 0 && std::fread(&events[0], sizeof(TraceEvent), header.eventCount, in) != header.eventCount) {
+    std::fprintf(stderr, "%s ends in the middle of its events\n", argv[1]);
+    return 1;
+  }
+  std::fclose(in);
+
+  FILE* out = std::fopen(argv[2], "w");
+  if (out == NULL) {
+    std::fprintf(stderr, "cannot open %s\n", argv[2]);
+    return 1;
+  }
+
+  Writer writer(out);
+  writer.begin(header.dropped);
+  writer.trackName(schedulerTrack, "EventScheduler", 0);
+  for (auto& name : names) {
+    writer.trackName(firstObjectTrack + name.first, name.second, firstObjectTrack + name.first);
+  }
+
+  // Timestamps are 32 bits and wrap, so each one is taken as an offset from the one before
+  std::uint64_t micros = 0;
+  std::uint32_t last = events.empty() ? 0 : events[0].micros;
+
+  // The spans that are open, so that an end whose start was overwritten is not written
+  int openUpdates = 0;
+  std::map<std::uint16_t, int> openExecutes;
+  std::map<std::uint16_t, bool> running;
+
+  for (const TraceEvent& event : events) {
+    micros += std::int32_t(event.micros - last);
+    last = event.micros;
+    int track = firstObjectTrack + event.object;
+    std::string name = names.count(event.object) ? names[event.object] : "object " + std::to_string(event.object);
+
+    switch (TraceEventType(event.type)) {
+      case TraceEventType::UpdateBegin:
+        writer.event("B", schedulerTrack, micros, "update", "");
+        openUpdates++;
+        break;
+      case TraceEventType::UpdateEnd:
+        if (openUpdates > 0) {
+          writer.event("E", schedulerTrack, micros, "update", "");
+          openUpdates--;
+        }
+        break;
+      case TraceEventType::ExecuteBegin:
+        writer.event("B", schedulerTrack, micros, name, "\"cat\":\"execute\"");
+        openExecutes[event.object]++;
+        break;
+      case TraceEventType::ExecuteEnd:
+        if (openExecutes[event.object] > 0) {
+          writer.event("E", schedulerTrack, micros, name, "\"cat\":\"execute\"");
+          openExecutes[event.object]--;
+        }
+        break;
+      case TraceEventType::CommandInitialized:
+        if (running[event.object]) {
+          writer.event("E", track, micros, "running", "\"args\":{\"ended\":\"initialized again\"}");
+        }
+        writer.event("B", track, micros, "running", "");
+        running[event.object] = true;
+        break;
+      case TraceEventType::CommandFinished:
+      case TraceEventType::CommandInterrupted:
+      case TraceEventType::CommandBlocked: {
+        const char* ended = event.type == std::uint8_t(TraceEventType::CommandFinished) ? "finished" :
+                            event.type == std::uint8_t(TraceEventType::CommandInterrupted) ? "interrupted" : "blocked";
+        if (running[event.object]) {
+          writer.event("E", track, micros, "running", std::string("\"args\":{\"ended\":\"") + ended + "\"}");
+          running[event.object] = false;
+        } else {
+          writer.event("i", track, micros, ended, "\"s\":\"t\"");
+        }
+        break;
+      }
+      case TraceEventType::CommandQueued:
+        writer.event("i", track, micros, "queued", "\"s\":\"t\"");
+        break;
+      case TraceEventType::GroupStepAdvanced:
+        writer.event("i", track, micros, "step " + std::to_string(event.detail), "\"s\":\"t\"");
+        break;
+      case TraceEventType::ListenerFired:
+        writer.event("i", track, micros, describeTrigger(event.detail), "\"s\":\"t\"");
+        break;
+      default:
+        std::fprintf(stderr, "%s has an event of unknown type %u\n", argv[1], event.type);
+        std::fclose(out);
+        return 1;
+    }
+  }
+
+  writer.end();
+  if (std::fclose(out) != 0) {
+    std::fprintf(stderr, "cannot write %s\n", argv[2]);
+    return 1;
+  }
+  std::printf("%u events (%u dropped) and %u names written to %s\n", header.eventCount, header.dropped,
+              header.nameCount, argv[2]);
+  return 0;
+}